@@ -0,0 +1,25 @@
+include(FindPackageHandleStandardArgs)
+
+find_package(PkgConfig QUIET)
+if (PKG_CONFIG_FOUND)
+  pkg_check_modules(ONNXRUNTIME libonnxruntime QUIET)
+endif ()
+
+if ( NOT ONNXRUNTIME_FOUND )
+  find_path(ONNXRUNTIME_INCLUDE_DIRS NAMES onnxruntime_c_api.h PATH_SUFFIXES onnxruntime onnxruntime/core/session)
+  find_library(ONNXRUNTIME_LIBRARIES NAMES onnxruntime)
+
+  if ( NOT "${ONNXRUNTIME_LIBRARIES}" STREQUAL "")
+    set (ONNXRUNTIME_FOUND TRUE)
+    set (ONNXRUNTIME_LINK_LIBRARIES ${ONNXRUNTIME_LINK_LIBRARIES} ${ONNXRUNTIME_LIBRARIES})
+  endif ()
+endif ()
+
+find_package_handle_standard_args(OnnxRuntime
+  FOUND_VAR
+    ONNXRUNTIME_FOUND
+  REQUIRED_VARS
+    ONNXRUNTIME_LINK_LIBRARIES
+    ONNXRUNTIME_INCLUDE_DIRS
+  VERSION_VAR
+    ONNXRUNTIME_VERSION)
@@ -139,11 +139,22 @@
 #include "algorithms/spectral/spectralwhitening.h"
 #include "algorithms/spectral/spectrumtocent.h"
 #include "algorithms/spectral/strongpeak.h"
-#if ENABLE_TENSORFLOW
+#if ENABLE_TENSORFLOW || ENABLE_ONNXRUNTIME
 #include "algorithms/spectral/tensorflowinputfsdsinet.h"
 #include "algorithms/spectral/tensorflowinputmusicnn.h"
 #include "algorithms/spectral/tensorflowinputtempocnn.h"
 #include "algorithms/spectral/tensorflowinputvggish.h"
+#endif
+#if ENABLE_ONNXRUNTIME
+#include "algorithms/machinelearning/onnxpredict.h"
+#include "algorithms/machinelearning/onnxpredictcrepe.h"
+#include "algorithms/machinelearning/onnxpredicteffnetdiscogs.h"
+#include "algorithms/machinelearning/onnxpredictmusicnn.h"
+#include "algorithms/machinelearning/onnxpredicttempocnn.h"
+#include "algorithms/machinelearning/onnxpredicttensor.h"
+#include "algorithms/machinelearning/onnxpredictvggish.h"
+#endif
+#if ENABLE_TENSORFLOW
 #include "algorithms/machinelearning/tensorflowpredict.h"
 #include "algorithms/machinelearning/tensorflowpredict2d.h"
 #include "algorithms/machinelearning/tensorflowpredictcrepe.h"
@@ -152,6 +163,7 @@
 #include "algorithms/machinelearning/tensorflowpredictmaest.h"
 #include "algorithms/machinelearning/tensorflowpredictmusicnn.h"
 #include "algorithms/machinelearning/tensorflowpredicttempocnn.h"
+#include "algorithms/machinelearning/tensorflowpredicttensor.h"
 #include "algorithms/machinelearning/tensorflowpredictvggish.h"
 #endif
 #include "algorithms/spectral/triangularbands.h"
@@ -212,6 +224,7 @@
 #include "algorithms/standard/spectrumCQ.h"
 #include "algorithms/standard/spline.h"
 #include "algorithms/standard/startstopsilence.h"
+#include "algorithms/standard/stft.h"
 #include "algorithms/standard/stereodemuxer.h"
 #include "algorithms/standard/stereomuxer.h"
 #include "algorithms/standard/stereotrimmer.h"
@@ -225,6 +238,7 @@
 #include "algorithms/standard/vectorrealaccumulator.h"
 #include "algorithms/standard/vectorrealtotensor.h"
 #include "algorithms/standard/viterbi.h"
+#include "algorithms/standard/viterbionline.h"
 #include "algorithms/standard/warpedautocorrelation.h"
 #include "algorithms/standard/welch.h"
 #include "algorithms/standard/windowing.h"
@@ -300,6 +314,7 @@
 #include "algorithms/tonal/pitchyinprobabilistic.h"
 #include "algorithms/tonal/pitchyinprobabilities.h"
 #include "algorithms/tonal/pitchyinprobabilitieshmm.h"
+#include "algorithms/tonal/pitchyinprobabilitieshmmonline.h"
 #include "algorithms/tonal/predominantpitchmelodia.h"
 #include "algorithms/tonal/tonicindianartmusic.h"
 #include "algorithms/tonal/tristimulus.h"
@@ -447,11 +462,21 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<SpectralWhitening> regSpectralWhitening;
     AlgorithmFactory::Registrar<SpectrumToCent> regSpectrumToCent;
     AlgorithmFactory::Registrar<StrongPeak> regStrongPeak;
-#if ENABLE_TENSORFLOW
+#if ENABLE_TENSORFLOW || ENABLE_ONNXRUNTIME
     AlgorithmFactory::Registrar<TensorflowInputFSDSINet> regTensorflowInputFSDSINet;
     AlgorithmFactory::Registrar<TensorflowInputMusiCNN> regTensorflowInputMusiCNN;
     AlgorithmFactory::Registrar<TensorflowInputTempoCNN> regTensorflowInputTempoCNN;
     AlgorithmFactory::Registrar<TensorflowInputVGGish> regTensorflowInputVGGish;
+#endif
+#if ENABLE_ONNXRUNTIME
+    AlgorithmFactory::Registrar<OnnxPredict> regOnnxPredict;
+    AlgorithmFactory::Registrar<OnnxPredictCREPE> regOnnxPredictCREPE;
+    AlgorithmFactory::Registrar<OnnxPredictEffnetDiscogs> regOnnxPredictEffnetDiscogs;
+    AlgorithmFactory::Registrar<OnnxPredictMusiCNN> regOnnxPredictMusiCNN;
+    AlgorithmFactory::Registrar<OnnxPredictTempoCNN> regOnnxPredictTempoCNN;
+    AlgorithmFactory::Registrar<OnnxPredictVGGish> regOnnxPredictVGGish;
+#endif
+#if ENABLE_TENSORFLOW
     AlgorithmFactory::Registrar<TensorflowPredict> regTensorflowPredict;
     AlgorithmFactory::Registrar<TensorflowPredict2D> regTensorflowPredict2D;
     AlgorithmFactory::Registrar<TensorflowPredictCREPE> regTensorflowPredictCREPE;
@@ -517,6 +542,7 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<SpectrumCQ> regSpectrumCQ;
     AlgorithmFactory::Registrar<Spline> regSpline;
     AlgorithmFactory::Registrar<StartStopSilence> regStartStopSilence;
+    AlgorithmFactory::Registrar<STFT> regSTFT;
     AlgorithmFactory::Registrar<StereoDemuxer> regStereoDemuxer;
     AlgorithmFactory::Registrar<StereoMuxer> regStereoMuxer;
     AlgorithmFactory::Registrar<StereoTrimmer> regStereoTrimmer;
@@ -735,11 +761,22 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<SpectralWhitening, essentia::standard::SpectralWhitening> regSpectralWhitening;
     AlgorithmFactory::Registrar<SpectrumToCent, essentia::standard::SpectrumToCent> regSpectrumToCent;
     AlgorithmFactory::Registrar<StrongPeak, essentia::standard::StrongPeak> regStrongPeak;
-#if ENABLE_TENSORFLOW
+#if ENABLE_TENSORFLOW || ENABLE_ONNXRUNTIME
     AlgorithmFactory::Registrar<TensorflowInputFSDSINet, essentia::standard::TensorflowInputFSDSINet> regTensorflowInputFSDSINet;
     AlgorithmFactory::Registrar<TensorflowInputMusiCNN, essentia::standard::TensorflowInputMusiCNN> regTensorflowInputMusiCNN;
     AlgorithmFactory::Registrar<TensorflowInputTempoCNN, essentia::standard::TensorflowInputTempoCNN> regTensorflowInputTempoCNN;
     AlgorithmFactory::Registrar<TensorflowInputVGGish, essentia::standard::TensorflowInputVGGish> regTensorflowInputVGGish;
+#endif
+#if ENABLE_ONNXRUNTIME
+    AlgorithmFactory::Registrar<OnnxPredict, essentia::standard::OnnxPredict> regOnnxPredict;
+    AlgorithmFactory::Registrar<OnnxPredictCREPE, essentia::standard::OnnxPredictCREPE> regOnnxPredictCREPE;
+    AlgorithmFactory::Registrar<OnnxPredictEffnetDiscogs, essentia::standard::OnnxPredictEffnetDiscogs> regOnnxPredictEffnetDiscogs;
+    AlgorithmFactory::Registrar<OnnxPredictMusiCNN, essentia::standard::OnnxPredictMusiCNN> regOnnxPredictMusiCNN;
+    AlgorithmFactory::Registrar<OnnxPredictTempoCNN, essentia::standard::OnnxPredictTempoCNN> regOnnxPredictTempoCNN;
+    AlgorithmFactory::Registrar<OnnxPredictTensor> regOnnxPredictTensor;
+    AlgorithmFactory::Registrar<OnnxPredictVGGish, essentia::standard::OnnxPredictVGGish> regOnnxPredictVGGish;
+#endif
+#if ENABLE_TENSORFLOW
     AlgorithmFactory::Registrar<TensorflowPredict, essentia::standard::TensorflowPredict> regTensorflowPredict;
     AlgorithmFactory::Registrar<TensorflowPredict2D, essentia::standard::TensorflowPredict2D> regTensorflowPredict2D;
     AlgorithmFactory::Registrar<TensorflowPredictCREPE, essentia::standard::TensorflowPredictCREPE> regTensorflowPredictCREPE;
@@ -748,6 +785,7 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<TensorflowPredictMAEST, essentia::standard::TensorflowPredictMAEST> regTensorflowPredictMAEST;
     AlgorithmFactory::Registrar<TensorflowPredictMusiCNN, essentia::standard::TensorflowPredictMusiCNN> regTensorflowPredictMusiCNN;
     AlgorithmFactory::Registrar<TensorflowPredictTempoCNN, essentia::standard::TensorflowPredictTempoCNN> regTensorflowPredictTempoCNN;
+    AlgorithmFactory::Registrar<TensorflowPredictTensor> regTensorflowPredictTensor;
     AlgorithmFactory::Registrar<TensorflowPredictVGGish, essentia::standard::TensorflowPredictVGGish> regTensorflowPredictVGGish;
 #endif
     AlgorithmFactory::Registrar<TriangularBands, essentia::standard::TriangularBands> regTriangularBands;
@@ -808,6 +846,7 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<SpectrumCQ, essentia::standard::SpectrumCQ> regSpectrumCQ;
     AlgorithmFactory::Registrar<Spline, essentia::standard::Spline> regSpline;
     AlgorithmFactory::Registrar<StartStopSilence, essentia::standard::StartStopSilence> regStartStopSilence;
+    AlgorithmFactory::Registrar<STFT, essentia::standard::STFT> regSTFT;
     AlgorithmFactory::Registrar<StereoDemuxer, essentia::standard::StereoDemuxer> regStereoDemuxer;
     AlgorithmFactory::Registrar<StereoMuxer, essentia::standard::StereoMuxer> regStereoMuxer;
     AlgorithmFactory::Registrar<StereoTrimmer, essentia::standard::StereoTrimmer> regStereoTrimmer;
@@ -821,6 +860,7 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<VectorRealAccumulator> regVectorRealAccumulator;
     AlgorithmFactory::Registrar<VectorRealToTensor> regVectorRealToTensor;
     AlgorithmFactory::Registrar<Viterbi, essentia::standard::Viterbi> regViterbi;
+    AlgorithmFactory::Registrar<ViterbiOnline> regViterbiOnline;
     AlgorithmFactory::Registrar<WarpedAutoCorrelation, essentia::standard::WarpedAutoCorrelation> regWarpedAutoCorrelation;
     AlgorithmFactory::Registrar<Welch, essentia::standard::Welch> regWelch;
     AlgorithmFactory::Registrar<Windowing, essentia::standard::Windowing> regWindowing;
@@ -893,6 +933,7 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<PitchYinProbabilistic, essentia::standard::PitchYinProbabilistic> regPitchYinProbabilistic;
     AlgorithmFactory::Registrar<PitchYinProbabilities, essentia::standard::PitchYinProbabilities> regPitchYinProbabilities;
     AlgorithmFactory::Registrar<PitchYinProbabilitiesHMM, essentia::standard::PitchYinProbabilitiesHMM> regPitchYinProbabilitiesHMM;
+    AlgorithmFactory::Registrar<PitchYinProbabilitiesHMMOnline> regPitchYinProbabilitiesHMMOnline;
     AlgorithmFactory::Registrar<PredominantPitchMelodia, essentia::standard::PredominantPitchMelodia> regPredominantPitchMelodia;
     AlgorithmFactory::Registrar<Tristimulus, essentia::standard::Tristimulus> regTristimulus;
     AlgorithmFactory::Registrar<TuningFrequency, essentia::standard::TuningFrequency> regTuningFrequency;
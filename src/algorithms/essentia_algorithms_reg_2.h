@@ -0,0 +1,56 @@
+/* This file is automatically created by the build system.
+ * Please make changes only in its source file essentia_algorithms_reg.h.in.
+ */
+
+#ifndef ESSENTIA_ALGORITHMS_REG_H_
+#define ESSENTIA_ALGORITHMS_REG_H_
+
+#ifndef ENABLE_AUDIOLOADER
+#define ENABLE_AUDIOLOADER 0
+#endif
+
+#ifndef ENABLE_AUDIOWRITER
+#define ENABLE_AUDIOWRITER 0
+#endif
+
+#ifndef ENABLE_FFTW
+#define ENABLE_FFTW 0
+#endif
+
+#ifndef ENABLE_KISS
+#define ENABLE_KISS 1
+#endif
+
+#ifndef ENABLE_VDSP
+#define ENABLE_VDSP 0
+#endif
+
+#ifndef ENABLE_YAML
+#define ENABLE_YAML 1
+#endif
+
+#ifndef ENABLE_SAMPLERATE
+#define ENABLE_SAMPLERATE 0
+#endif
+
+#ifndef ENABLE_TAGLIB
+#define ENABLE_TAGLIB 0
+#endif
+
+#ifndef ENABLE_CHROMAPRINT
+#define ENABLE_CHROMAPRINT 0
+#endif
+
+#ifndef ENABLE_TENSORFLOW
+#define ENABLE_TENSORFLOW 0
+#endif
+
+#ifndef ENABLE_ONNXRUNTIME
+#define ENABLE_ONNXRUNTIME 0
+#endif
+
+#ifndef ENABLE_GAIA2
+#define ENABLE_GAIA2 0
+#endif
+
+#endif /* ESSENTIA_ALGORITHMS_REG_H_ */
@@ -19,6 +19,8 @@
 
 #include "musicextractor.h"
 #include "extractor_music/tagwhitelist.h"
+#include "vectorinput.h"
+#include "vectoroutput.h"
 
 using namespace std;
 
@@ -29,8 +31,12 @@ const char* MusicExtractor::name = "MusicExtractor";
 const char* MusicExtractor::category = "Extractors";
 const char* MusicExtractor::description = DOC("This algorithm is a wrapper for Music Extractor. See documentation for 'essentia_streaming_extractor_music'.");
 
+// number of samples sent at once by the in-memory loaders feeding the analysis
+// networks, similar to the size of the chunks output by the audio decoder
+static const int loaderChunkSize = 4096;
 
-MusicExtractor::MusicExtractor() {
+
+MusicExtractor::MusicExtractor() : _analysisAudioIsComplete(false), _analysisChannels(2) {
   declareInput(_audiofile, "filename", "the input audiofile");
   declareOutput(_resultsStats, "results", "Analysis results pool with across-frames statistics");
   declareOutput(_resultsFrames, "resultsFrames", "Analysis results pool with computed frame values");
@@ -190,7 +196,8 @@ void MusicExtractor::compute() {
   Pool results;
   Pool stats;
 
-  streaming::AlgorithmFactory& factory = streaming::AlgorithmFactory::instance();
+  // the downmix might have been changed while analyzing a previous file
+  downmix = "mix";
 
   results.set("metadata.version.essentia", essentia::version);
   results.set("metadata.version.essentia_git_sha", essentia::version_git_sha);
@@ -219,7 +226,7 @@ void MusicExtractor::compute() {
   computeAudioMetadata(audioFilename, results);
   
   E_INFO("MusicExtractor: Replay gain");
-  computeReplayGain(audioFilename, results);
+  computeReplayGain(results);
 
   #if HAVE_LIBCHROMAPRINT
     if (chromaprintCompute) {
@@ -233,20 +240,21 @@ void MusicExtractor::compute() {
   E_INFO("MusicExtractor: Compute audio features");
 
   // normalize the audio with replay gain and compute as many lowlevel, rhythm,
-  // and tonal descriptors as possible
-  
-  streaming::Algorithm* loader = factory.create("EasyLoader",
-                                    "filename",   audioFilename,
-                                    "sampleRate", analysisSampleRate,
-                                    "startTime",  startTime,
-                                    "endTime",    endTime,
-                                    "replayGain", replayGain,
-                                    "downmix",    downmix);
+  // and tonal descriptors as possible. The audio is the one decoded when
+  // computing the audio metadata, downmixed and scaled as EasyLoader does
+  // (including its 6dB preamp)
+  vector<Real> audio;
+  downmixAnalysisAudio(audio, db2amp(replayGain + 6.0));
+  _analysisAudio.clear();
+  _analysisAudio.shrink_to_fit();
+
+  streaming::VectorInput<Real>* loader = new streaming::VectorInput<Real>(&audio);
+  loader->setAcquireSize(loaderChunkSize);
   MusicLowlevelDescriptors *lowlevel = new MusicLowlevelDescriptors(options);
   MusicRhythmDescriptors *rhythm = new MusicRhythmDescriptors(options);
   MusicTonalDescriptors *tonal = new MusicTonalDescriptors(options);
   
-  SourceBase& source = loader->output("audio");
+  SourceBase& source = loader->output("data");
   lowlevel->createNetworkNeqLoud(source, results);
   lowlevel->createNetworkEqLoud(source, results);
   lowlevel->createNetworkLoudness(source, results);
@@ -259,15 +267,10 @@ void MusicExtractor::compute() {
   // Descriptors that require values from other descriptors in the previous chain
   lowlevel->computeAverageLoudness(results);  // requires 'loudness'
 
-  streaming::Algorithm* loader_2 = factory.create("EasyLoader",
-                                       "filename",   audioFilename,
-                                       "sampleRate", analysisSampleRate,
-                                       "startTime",  startTime,
-                                       "endTime",    endTime,
-                                       "replayGain", replayGain,
-                                       "downmix",    downmix);
+  streaming::VectorInput<Real>* loader_2 = new streaming::VectorInput<Real>(&audio);
+  loader_2->setAcquireSize(loaderChunkSize);
 
-  SourceBase& source_2 = loader_2->output("audio");
+  SourceBase& source_2 = loader_2->output("data");
   rhythm->createNetworkBeatsLoudness(source_2, results);  // requires 'beat_positions'
   tonal->createNetwork(source_2, results);                // requires 'tuning frequency'
 
@@ -483,6 +486,7 @@ void MusicExtractor::computeAudioMetadata(const string& audioFilename, Pool& res
   streaming::Algorithm* loudness = factory.create("LoudnessEBUR128");
 
   Real inputSampleRate = lastTokenProduced<Real>(loader->output("sampleRate"));
+  _analysisChannels = lastTokenProduced<int>(loader->output("numberChannels"));
   resampleR->configure("inputSampleRate", inputSampleRate,
                        "outputSampleRate", analysisSampleRate);
   resampleL->configure("inputSampleRate", inputSampleRate,
@@ -499,17 +503,22 @@ void MusicExtractor::computeAudioMetadata(const string& audioFilename, Pool& res
   resampleL->output("signal")  >> muxer->input("left");
   muxer->output("audio")       >> trimmer->input("signal");
   trimmer->output("signal")    >> loudness->input("signal");
+  trimmer->output("signal")    >> _analysisAudio;
   loudness->output("integratedLoudness") >> PC(results, "lowlevel.loudness_ebu128.integrated");
   loudness->output("momentaryLoudness") >> PC(results, "lowlevel.loudness_ebu128.momentary");
   loudness->output("shortTermLoudness") >> PC(results, "lowlevel.loudness_ebu128.short_term");
   loudness->output("loudnessRange") >> PC(results, "lowlevel.loudness_ebu128.loudness_range");
 
+  _analysisAudio.clear();
+
   scheduler::Network network(loader);
   network.run();
   
   // set length (actually duration) of the file and length of analyzed segment
   Real length = loader->output("audio").totalProduced() / inputSampleRate;
   Real analysis_length = trimmer->output("signal").totalProduced() / analysisSampleRate;
+  _analysisAudioIsComplete = (startTime == 0 &&
+                              muxer->output("audio").totalProduced() == trimmer->output("signal").totalProduced());
 
   if (!analysis_length) {
     ostringstream msg;
@@ -535,7 +544,32 @@ void MusicExtractor::computeAudioMetadata(const string& audioFilename, Pool& res
 }
 
 
-void MusicExtractor::computeReplayGain(const string& audioFilename, Pool& results) {
+void MusicExtractor::downmixAnalysisAudio(vector<Real>& audio, Real gain) {
+  // same downmixing as MonoMixer: mono files are only decoded on the left
+  // channel, which is taken as is whatever the downmixing type
+  audio.resize(_analysisAudio.size());
+
+  if (_analysisChannels == 1) {
+    for (int i=0; i<(int)audio.size(); i++) audio[i] = gain * _analysisAudio[i].left();
+  }
+  else if (downmix == "mix") {
+    for (int i=0; i<(int)audio.size(); i++) {
+      audio[i] = gain * 0.5*(_analysisAudio[i].left() + _analysisAudio[i].right());
+    }
+  }
+  else if (downmix == "left") {
+    for (int i=0; i<(int)audio.size(); i++) audio[i] = gain * _analysisAudio[i].left();
+  }
+  else if (downmix == "right") {
+    for (int i=0; i<(int)audio.size(); i++) audio[i] = gain * _analysisAudio[i].right();
+  }
+  else {
+    throw EssentiaException("MusicExtractor: Unknown downmixing type");
+  }
+}
+
+
+void MusicExtractor::computeReplayGain(Pool& results) {
 
   streaming::AlgorithmFactory& factory = streaming::AlgorithmFactory::instance();
 
@@ -543,15 +577,17 @@ void MusicExtractor::computeReplayGain(const string& audioFilename, Pool& result
   //int length = 0;
 
   while (true) {
-    streaming::Algorithm* audio = factory.create("EqloudLoader",
-                                      "filename",   audioFilename,
-                                      "sampleRate", analysisSampleRate,
-                                      "startTime",  startTime,
-                                      "endTime",    endTime,
-                                      "downmix",    downmix);
+    // equivalent to EqloudLoader, without decoding the file again
+    vector<Real> signal;
+    downmixAnalysisAudio(signal);
+
+    streaming::VectorInput<Real>* audio = new streaming::VectorInput<Real>(&signal);
+    audio->setAcquireSize(loaderChunkSize);
+    streaming::Algorithm* eqloud = factory.create("EqualLoudness", "sampleRate", analysisSampleRate);
     streaming::Algorithm* rgain = factory.create("ReplayGain", "applyEqloud", false);
 
-    audio->output("audio")      >> rgain->input("signal");
+    audio->output("data")       >> eqloud->input("signal");
+    eqloud->output("signal")    >> rgain->input("signal");
     rgain->output("replayGain") >> PC(results, "metadata.audio_properties.replay_gain");
 
     try {
@@ -614,10 +650,19 @@ void MusicExtractor::setExtractorOptions(const std::string& filename) {
 void MusicExtractor::computeChromaPrint(const string& audioFilename, Pool& results) {
   AlgorithmFactory& factory = standard::AlgorithmFactory::instance();
 
-  Algorithm* audio = factory.create("MonoLoader",
-                                    "filename", audioFilename,
-                                    "sampleRate", analysisSampleRate,
-                                    "downmix", downmix);
+  // the fingerprint is computed from the beginning of the file, so we can only
+  // reuse the decoded audio if it hasn't been trimmed before the required duration
+  bool useAnalysisAudio = startTime == 0 &&
+    (_analysisAudioIsComplete ||
+     (chromaprintDuration > 0 && _analysisAudio.size() >= chromaprintDuration * analysisSampleRate));
+
+  Algorithm* audio = 0;
+  if (!useAnalysisAudio) {
+    audio = factory.create("MonoLoader",
+                           "filename", audioFilename,
+                           "sampleRate", analysisSampleRate,
+                           "downmix", downmix);
+  }
   Algorithm* chromaprinter = factory.create("Chromaprinter",
                                             "sampleRate", analysisSampleRate,
                                             "maxLength", chromaprintDuration);
@@ -625,13 +670,14 @@ void MusicExtractor::computeChromaPrint(const string& audioFilename, Pool& resul
   vector<Real> siganl;
   string chromaprint;
 
-  audio->output("audio").set(siganl);
+  if (audio) audio->output("audio").set(siganl);
   chromaprinter->input("signal").set(siganl);
 
   chromaprinter->output("fingerprint").set(chromaprint);
 
   try {
-    audio->compute();
+    if (audio) audio->compute();
+    else downmixAnalysisAudio(siganl);
     chromaprinter->compute();
 
     results.add("chromaprint.string", chromaprint);
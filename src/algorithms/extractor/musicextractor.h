@@ -82,12 +82,23 @@ class MusicExtractor : public Algorithm {
   std::string downmix;
   standard::Algorithm* _svms;
 
+  // the audio is decoded only once, in computeAudioMetadata(): the stereo
+  // signal, resampled to the analysis sample rate and trimmed, is kept here
+  // and feeds all the other analysis passes
+  std::vector<StereoSample> _analysisAudio;
+  // whether _analysisAudio contains the whole file (ie: it hasn't been trimmed)
+  bool _analysisAudioIsComplete;
+  // number of channels of the input file
+  int _analysisChannels;
+
+  void downmixAnalysisAudio(std::vector<Real>& audio, Real gain=1.);
+
   void setExtractorOptions(const std::string& filename);
   void setExtractorDefaultOptions();
   void mergeValues(Pool &pool);
   void readMetadata(const std::string& audioFilename, Pool& results);
   void computeAudioMetadata(const std::string& audioFilename, Pool& results);
-  void computeReplayGain(const std::string& audioFilename, Pool& results);
+  void computeReplayGain(Pool& results);
 
 #if HAVE_LIBCHROMAPRINT
   void computeChromaPrint(const std::string& audioFilename, Pool& results);
@@ -18,10 +18,97 @@
  */
 
 #include "medianfilter.h"
-#include "essentiamath.h"
 
-using namespace essentia;
-using namespace standard;
+using namespace std;
+
+namespace essentia {
+
+void SlidingMedian::reset(int kernelSize, Real value) {
+  _half = kernelSize / 2;
+  _oldest = 0;
+  _values.assign(kernelSize, value);
+  _heap.resize(kernelSize);
+  _pos.resize(kernelSize);
+
+  // all the values are equal, so any arrangement is a valid double heap
+  for (int i=0; i<kernelSize; i++) {
+    _heap[i] = i;
+    _pos[i] = i - _half;
+  }
+}
+
+void SlidingMedian::swapPositions(int p, int q) {
+  int& a = _heap[p + _half];
+  int& b = _heap[q + _half];
+  std::swap(a, b);
+  _pos[a] = p;
+  _pos[b] = q;
+}
+
+int SlidingMedian::siftUp(int sign, int i) {
+  while (i > 1 && before(sign, valueAt(sign*i), valueAt(sign*(i/2)))) {
+    swapPositions(sign*i, sign*(i/2));
+    i /= 2;
+  }
+  return i;
+}
+
+int SlidingMedian::siftDown(int sign, int i) {
+  while (2*i <= _half) {
+    int child = 2*i;
+    if (child < _half && before(sign, valueAt(sign*(child+1)), valueAt(sign*child))) child++;
+    if (!before(sign, valueAt(sign*child), valueAt(sign*i))) break;
+    swapPositions(sign*i, sign*child);
+    i = child;
+  }
+  return i;
+}
+
+void SlidingMedian::push(Real value) {
+  int index = _oldest;
+  _oldest = (_oldest + 1) % (int)_values.size();
+  _values[index] = value;
+
+  int p = _pos[index];
+
+  if (p == 0) {
+    // the median itself was replaced, swap it with the root of the heap it
+    // should belong to if it is not in between both heaps anymore
+    if (_half == 0) return;
+    if (valueAt(0) < valueAt(-1)) {
+      swapPositions(0, -1);
+      siftDown(-1, 1);
+    }
+    else if (valueAt(1) < valueAt(0)) {
+      swapPositions(0, 1);
+      siftDown(1, 1);
+    }
+    return;
+  }
+
+  int sign = p > 0 ? 1 : -1;
+  int i = siftUp(sign, sign*p);
+  if (i == sign*p) i = siftDown(sign, i);
+
+  // the new value made it to the root of its heap and crossed the median: it
+  // becomes the median, and the previous median becomes the root of the heap
+  // (it is a valid root as it was already ordered with the rest of the heap)
+  if (i == 1 && before(sign, valueAt(sign), valueAt(0))) {
+    swapPositions(sign, 0);
+
+    // the new median still has to be ordered with the other heap
+    if (before(-sign, valueAt(-sign), valueAt(0))) {
+      swapPositions(-sign, 0);
+      siftDown(-sign, 1);
+    }
+  }
+}
+
+} // namespace essentia
+
+
+namespace essentia {
+namespace standard {
 
 const char *MedianFilter::name = "MedianFilter";
 const char *MedianFilter::category = "Filters";
@@ -29,6 +116,11 @@ const char *MedianFilter::description =
     DOC("This algorithm computes the median filtered version of the input "
         "signal giving the kernel size as detailed in [1].\n"
         "\n"
+        "The beginning and the end of the signal are padded with its first and "
+        "last values, respectively, so that the output has the same size as the "
+        "input. The median is updated incrementally from one window to the next "
+        "in O(log(kernelSize)) time.\n"
+        "\n"
         "References:\n"
         "  [1] Median Filter -- from Wikipedia.org, \n"
         "  https://en.wikipedia.org/wiki/Median_filter");
@@ -52,15 +144,15 @@ void MedianFilter::compute() {
         EssentiaException("kernelSize has to be smaller than the input size"));
   output.resize(inputSize);
 
-  // add padding at the beginning and end so the ouput fits the input size.
-  std::vector<Real> paddedArray = input;
-  paddedArray.insert(paddedArray.begin(), paddingSize, input[0]);
-  paddedArray.insert(paddedArray.end(), paddingSize, input.back());
-
-  std::vector<Real>::const_iterator first = paddedArray.begin();
-  std::vector<Real> window;
-  for (int i = 0; i < inputSize; i++) {
-    window.assign(first + i, first + i + _kernelSize);
-    output[i] = median(window);
+  // the window ending at input[i] is centered on output[i - paddingSize]. The
+  // window starts filled with the first value and is fed with the last value
+  // once the input is exhausted, which pads both ends of the input.
+  _window.reset(_kernelSize, input[0]);
+  for (int i = 0; i < inputSize + paddingSize; i++) {
+    if (i > 0) _window.push(input[std::min(i, inputSize - 1)]);
+    if (i >= paddingSize) output[i - paddingSize] = _window.median();
   }
 }
+
+}  // namespace standard
+}  // namespace essentia
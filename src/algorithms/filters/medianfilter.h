@@ -23,6 +23,44 @@
 #include "algorithm.h"
 
 namespace essentia {
+
+/**
+ * Running median of the last kernelSize values pushed into it (kernelSize must
+ * be odd). The values are kept in an indexable double heap centered on the
+ * median: a max-heap with the smaller half of the values and a min-heap with
+ * the larger half. Replacing the oldest value by a new one only sifts that
+ * value within the heaps, which takes O(log(kernelSize)) and does not allocate.
+ */
+class SlidingMedian {
+ public:
+  /**
+   * Fills the window with kernelSize copies of the given value.
+   */
+  void reset(int kernelSize, Real value);
+
+  /**
+   * Replaces the oldest value in the window with the given one.
+   */
+  void push(Real value);
+
+  Real median() const { return _values[_heap[_half]]; }
+
+ protected:
+  std::vector<Real> _values; // window values, in circular order
+  std::vector<int> _heap;    // heap position + _half -> index in _values
+  std::vector<int> _pos;     // index in _values -> heap position
+  int _half;
+  int _oldest;
+
+  // positions -1..-_half are the max-heap, 1.._half the min-heap and 0 is the
+  // median. Heap node i (1-based) of the heap of given sign is at sign*i
+  Real valueAt(int p) const { return _values[_heap[p + _half]]; }
+  bool before(int sign, Real a, Real b) const { return sign > 0 ? a < b : b < a; }
+  void swapPositions(int p, int q);
+  int siftUp(int sign, int i);
+  int siftDown(int sign, int i);
+};
+
 namespace standard {
 
 class MedianFilter : public Algorithm {
@@ -32,6 +70,7 @@ class MedianFilter : public Algorithm {
   Output<std::vector<Real>> _filteredArray;
 
   int _kernelSize;
+  SlidingMedian _window;
 
  public:
   MedianFilter() {
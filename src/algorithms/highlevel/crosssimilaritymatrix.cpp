@@ -18,6 +18,7 @@
  */
 #include "crosssimilaritymatrix.h"
 #include "essentiamath.h"
+#include "utils/threadpool.h"
 #include <vector>
 #include <iostream>
 #include <string>
@@ -43,18 +44,46 @@ void CrossSimilarityMatrix::configure() {
   _frameStackSize = parameter("frameStackSize").toInt();
   _binarizePercentile = parameter("binarizePercentile").toReal();
   _binarize = parameter("binarize").toBool();
+  _numberThreads = parameter("numberThreads").toInt();
+
+  delete _threadPool;
+  _threadPool = 0;
+  if (_numberThreads > 1) _threadPool = new ThreadPool(_numberThreads);
 }
 
-// Construct a 'stacked-frames' feature vector from an input audio feature vector by given 'frameStackSize' and 'frameStackStride'
-std::vector<std::vector<Real> > CrossSimilarityMatrix::stackFrames(std::vector<std::vector<Real> >& frames, int frameStackSize, int frameStackStride) const {
+CrossSimilarityMatrix::~CrossSimilarityMatrix() {
+  delete _threadPool;
+}
 
-  if (frameStackSize == 1) {
-    return frames;
+// pairwise euclidean distances, the blocks of query frames being split over
+// the thread pool if there is one
+void CrossSimilarityMatrix::pairwiseDistances(const std::vector<std::vector<Real> >& query,
+                                              const std::vector<std::vector<Real> >& reference,
+                                              std::vector<std::vector<Real> >& distances) {
+  if (!_threadPool) {
+    pairwiseDistance(query, reference, distances);
+    return;
   }
+
+  ThreadPool* pool = _threadPool;
+  pairwiseDistance(query, reference, distances,
+                   [pool](size_t nBlocks, const std::function<void(size_t)>& computeBlock) {
+    for (size_t block=0; block<nBlocks; block++) {
+      pool->submit([&computeBlock, block]() { computeBlock(block); });
+    }
+    pool->wait();
+  });
+}
+
+// Construct a 'stacked-frames' feature vector from an input audio feature vector by given 'frameStackSize' and 'frameStackStride'
+void CrossSimilarityMatrix::stackFrames(const std::vector<std::vector<Real> >& frames, int frameStackSize, int frameStackStride,
+                                        std::vector<std::vector<Real> >& stackedFrames) const {
   size_t stopIdx;
   int increment = frameStackSize * frameStackStride;
-  std::vector<std::vector<Real> > stackedFrames;
-  stackedFrames.reserve(frames.size() - increment);
+  stackedFrames.clear();
+  if (frames.size() <= (size_t)increment) return;
+
+  stackedFrames.reserve((frames.size() - increment + frameStackStride - 1) / frameStackStride);
   std::vector<Real> stack;
   stack.reserve(frames[0].size() * frameStackSize);
   for (size_t i=0; i<(frames.size() - increment); i+=frameStackStride) {
@@ -65,14 +94,13 @@ std::vector<std::vector<Real> > CrossSimilarityMatrix::stackFrames(std::vector<s
     stackedFrames.push_back(stack);
     stack.clear();
   }
-  return stackedFrames;
 }
 
 
 void CrossSimilarityMatrix::compute() {
   // get inputs and output
-  std::vector<std::vector<Real> > queryFeature = _queryFeature.get();
-  std::vector<std::vector<Real> > referenceFeature = _referenceFeature.get();
+  const std::vector<std::vector<Real> >& queryFeature = _queryFeature.get();
+  const std::vector<std::vector<Real> >& referenceFeature = _referenceFeature.get();
   std::vector<std::vector<Real> >& csm = _csm.get();
 
   if (queryFeature.empty())
@@ -80,58 +108,55 @@ void CrossSimilarityMatrix::compute() {
   if (referenceFeature.empty())
     throw EssentiaException("CrossSimilarityMatrix: input referenceFeature array is empty.");
 
-  // construct a new vector by stacking the input features by an specified 'frameStackStride' and 'frameStackSize'
-  std::vector<std::vector<Real> >  queryFeatureStack = stackFrames(queryFeature, _frameStackSize, _frameStackStride);
-  std::vector<std::vector<Real> >  referenceFeatureStack = stackFrames(referenceFeature, _frameStackSize, _frameStackStride);
+  // construct a new vector by stacking the input features by an specified 'frameStackStride' and 'frameStackSize'.
+  // Without stacking, the input features are used as they are
+  std::vector<std::vector<Real> > queryFeatureStack;
+  std::vector<std::vector<Real> > referenceFeatureStack;
+  const std::vector<std::vector<Real> >* query = &queryFeature;
+  const std::vector<std::vector<Real> >* reference = &referenceFeature;
+  if (_frameStackSize != 1) {
+    stackFrames(queryFeature, _frameStackSize, _frameStackStride, queryFeatureStack);
+    stackFrames(referenceFeature, _frameStackSize, _frameStackStride, referenceFeatureStack);
+    query = &queryFeatureStack;
+    reference = &referenceFeatureStack;
+  }
 
   // check whether to binarize the euclidean cross-similarity matrix using the given threshold kappa
   if (_binarize) {
     // pairwise euclidean distance
-    std::vector<std::vector<Real> > pdistances = pairwiseDistance(queryFeatureStack, referenceFeatureStack);
+    std::vector<std::vector<Real> > pdistances;
+    pairwiseDistances(*query, *reference, pdistances);
     size_t queryFeatureSize = pdistances.size();
     size_t referenceFeatureSize = pdistances[0].size();
 
+    // thresholds computed along the queryFeature axis
     std::vector<Real> thresholdQuery(queryFeatureSize);
-    std::vector<Real> thresholdReference(referenceFeatureSize);
-
-    csm.assign(queryFeatureSize, std::vector<Real>(referenceFeatureSize, 1));
-    // construct the binary output similarity matrix using the thresholds computed along the queryFeature axis
-    for (size_t k=0; k<queryFeatureSize; k++) {
-      thresholdQuery[k] = percentile(pdistances[k], _binarizePercentile*100);
-      for (size_t l=0; l<referenceFeatureSize; l++) {
-        if (pdistances[k][l] > thresholdQuery[k]) {
-          csm[k][l] = 0;
-        }
-      }
+    for (size_t i=0; i<queryFeatureSize; i++) {
+      thresholdQuery[i] = percentile(pdistances[i], _binarizePercentile*100);
     }
-    // update the binary output similarity matrix by multiplying with the thresholds computed along the referenceFeature axis
+    // thresholds computed along the referenceFeature axis
+    std::vector<Real> thresholdReference(referenceFeatureSize);
+    std::vector<Real> column(queryFeatureSize);
     for (size_t j=0; j<referenceFeatureSize; j++) {
-      _status = true;
-      for (size_t i=0; i<queryFeatureSize; i++) {
-        if (_status) thresholdReference[j] = percentile(getColsAtVecIndex(pdistances, j), _binarizePercentile * 100);
-        if (pdistances[i][j] > thresholdReference[j]) {
-          csm[i][j] = 0;
-        }
-        _status = false;
+      for (size_t i=0; i<queryFeatureSize; i++) column[i] = pdistances[i][j];
+      thresholdReference[j] = percentile(column, _binarizePercentile*100);
+    }
+
+    // construct the binary output similarity matrix: a pair of frames is
+    // similar if its distance is below the thresholds along both axes
+    csm.resize(queryFeatureSize);
+    for (size_t i=0; i<queryFeatureSize; i++) {
+      csm[i].resize(referenceFeatureSize);
+      for (size_t j=0; j<referenceFeatureSize; j++) {
+        csm[i][j] = (pdistances[i][j] > thresholdQuery[i] || pdistances[i][j] > thresholdReference[j]) ? 0 : 1;
       }
     }
   }
   // Use default cross-similarity computation method based on euclidean distances
   else {
     // returns pairwise euclidean distance
-    csm = pairwiseDistance(queryFeatureStack, referenceFeatureStack);
-  }
-}
-
-// returns a column corresponding to a specified index in the given 2D input matrix
-std::vector<Real> CrossSimilarityMatrix::getColsAtVecIndex(std::vector<std::vector<Real> >& inputMatrix, int index) const {
-  
-  std::vector<Real> cols;
-  cols.reserve(inputMatrix.size());
-  for (size_t i=0; i<inputMatrix.size(); i++) {
-    cols.push_back(inputMatrix[i][index]);
+    pairwiseDistances(*query, *reference, csm);
   }
-  return cols;
 }
 
 } // namespace standard
@@ -21,6 +21,10 @@
 #include "algorithmfactory.h"
 #include <complex>
 
+namespace essentia {
+class ThreadPool;
+}
+
 namespace essentia {
 namespace standard {
 
@@ -30,17 +34,20 @@ class CrossSimilarityMatrix : public Algorithm {
    Input<std::vector<std::vector<Real> > > _referenceFeature;
    Output<std::vector<std::vector<Real> > > _csm;
   public:
-   CrossSimilarityMatrix() {
+   CrossSimilarityMatrix() : _threadPool(0) {
     declareInput(_queryFeature, "queryFeature", "input frame features of the query song (e.g., a chromagram)");
     declareInput(_referenceFeature, "referenceFeature", "input frame features of the reference song (e.g., a chromagram)");
     declareOutput(_csm, "csm", "2D cross-similarity matrix of two input frame sequences (query vs reference)");
    }
 
+   ~CrossSimilarityMatrix();
+
    void declareParameters() {
     declareParameter("frameStackStride", "stride size to form a stack of frames (e.g., 'frameStackStride'=1 to use consecutive frames; 'frameStackStride'=2 for using every second frame)", "[1,inf)", 1);
     declareParameter("frameStackSize", "number of input frames to stack together and treat as a feature vector for similarity computation. Choose 'frameStackSize=1' to use the original input frames without stacking", "[0,inf)", 1);
     declareParameter("binarizePercentile", "maximum percent of distance values to consider as similar in each row and each column", "[0,1]", 0.095);
     declareParameter("binarize", "whether to binarize the euclidean cross-similarity matrix", "{true,false}", false);
+    declareParameter("numberThreads", "number of threads used to compute the pairwise distances", "[1,inf)", 1);
   }
 
    void configure();
@@ -55,9 +62,13 @@ class CrossSimilarityMatrix : public Algorithm {
    int _frameStackSize;
    Real _binarizePercentile;
    bool _binarize;
-   bool _status;
-   std::vector<std::vector<Real> > stackFrames(std::vector<std::vector<Real> >& frames, int frameStackSize, int frameStackStride) const;
-   std::vector<Real> getColsAtVecIndex(std::vector<std::vector<Real> >& inputMatrix, int index) const;
+   int _numberThreads;
+   ThreadPool* _threadPool;
+   void pairwiseDistances(const std::vector<std::vector<Real> >& query,
+                          const std::vector<std::vector<Real> >& reference,
+                          std::vector<std::vector<Real> >& distances);
+   void stackFrames(const std::vector<std::vector<Real> >& frames, int frameStackSize, int frameStackStride,
+                    std::vector<std::vector<Real> >& stackedFrames) const;
 };
 
 } // namespace standard
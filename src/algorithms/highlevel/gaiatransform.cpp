@@ -171,7 +171,7 @@ void pointToPool(const gaia2::Point* p, Pool& pool, const Pool& origPool) {
 
     // if desc was a vector<vector<Real> >, it will have been converted to a single
     // vector<Real>, where the first 2 values are the dimensions. Construct this matrix back.
-    const PoolOf(std::vector<Real>)& vrpool = origPool.getVectorRealPool();
+    const std::map<std::string, VectorRealFrames>& vrpool = origPool.getVectorRealFramesPool();
 
     if (vrpool.find(pooldesc) != vrpool.end()) {
       int rows = int(desc[0]);
@@ -47,20 +47,79 @@ void AudioLoader::configure() {
     //av_log_set_level(AV_LOG_VERBOSE);
     _computeMD5 = parameter("computeMD5").toBool();
     _selectedStream = parameter("audioStream").toInt();
+
+    if (parameter("startTime").toReal() > parameter("endTime").toReal()) {
+        throw EssentiaException("AudioLoader: startTime cannot be larger than endTime.");
+    }
+
     reset();
 }
 
 
-void AudioLoader::openAudioFile(const string& filename) {
-    E_DEBUG(EAlgorithm, "AudioLoader: opening file: " << filename);
+void AudioLoader::setInputSource(const std::shared_ptr<AudioInputSource>& source) {
+    closeAudioFile();
+    _inputSource = source;
+    _inputSourceOpened = false;
+    reset();
+}
+
+
+int AudioLoader::readInputSource(void* opaque, uint8_t* buffer, int size) {
+    AudioInputSource* source = (AudioInputSource*)opaque;
+    int result = source->read(buffer, size);
+    if (result == 0) return AVERROR_EOF;
+    if (result < 0) return AVERROR(EIO);
+    return result;
+}
 
-    // Open file
+
+int64_t AudioLoader::seekInputSource(void* opaque, int64_t offset, int whence) {
+    AudioInputSource* source = (AudioInputSource*)opaque;
+    if (whence & AVSEEK_SIZE) return source->size();
+    return source->seek(offset, whence & ~AVSEEK_FORCE);
+}
+
+
+void AudioLoader::openAudioFile(const string& filename) {
     int errnum;
-    if ((errnum = avformat_open_input(&_demuxCtx, filename.c_str(), NULL, NULL)) != 0) {
-        char errorstr[128];
-        string error = "Unknown error";
-        if (av_strerror(errnum, errorstr, 128) == 0) error = errorstr;
-        throw EssentiaException("AudioLoader: Could not open file \"", filename, "\", error = ", error);
+
+    if (_inputSource) {
+        E_DEBUG(EAlgorithm, "AudioLoader: opening input source");
+
+        // the demuxer reads the source through our callbacks instead of
+        // opening a file. It takes ownership of the IO buffer.
+        uint8_t* ioBuffer = (uint8_t*)av_malloc(IO_BUFFER_SIZE);
+        if (ioBuffer) {
+            _ioCtx = avio_alloc_context(ioBuffer, IO_BUFFER_SIZE, 0, _inputSource.get(),
+                                        &readInputSource, NULL, &seekInputSource);
+            if (!_ioCtx) av_free(ioBuffer);
+        }
+        if (_ioCtx) _demuxCtx = avformat_alloc_context();
+        if (!_demuxCtx) {
+            closeInputSource();
+            throw EssentiaException("AudioLoader: Could not allocate the context to read the input source");
+        }
+        _demuxCtx->pb = _ioCtx;
+        _inputSourceOpened = true;
+
+        if ((errnum = avformat_open_input(&_demuxCtx, NULL, NULL, NULL)) != 0) {
+            char errorstr[128];
+            string error = "Unknown error";
+            if (av_strerror(errnum, errorstr, 128) == 0) error = errorstr;
+            closeAudioFile();
+            throw EssentiaException("AudioLoader: Could not open input source, error = ", error);
+        }
+    }
+    else {
+        E_DEBUG(EAlgorithm, "AudioLoader: opening file: " << filename);
+
+        // Open file
+        if ((errnum = avformat_open_input(&_demuxCtx, filename.c_str(), NULL, NULL)) != 0) {
+            char errorstr[128];
+            string error = "Unknown error";
+            if (av_strerror(errnum, errorstr, 128) == 0) error = errorstr;
+            throw EssentiaException("AudioLoader: Could not open file \"", filename, "\", error = ", error);
+        }
     }
 
     // Retrieve stream information
@@ -147,8 +206,58 @@ void AudioLoader::openAudioFile(const string& filename) {
 }
 
 
+/**
+ * Seeks to the closest point before _startSample from which the stream can be
+ * decoded, so that we don't need to decode everything that comes before it.
+ * The samples between that point and _startSample are dropped when copying
+ * the decoded frames, after reading the actual position from their timestamps.
+ */
+void AudioLoader::seekAudioFile() {
+    AVStream* stream = _demuxCtx->streams[_streamIdx];
+    AVRational sampleTimeBase = { 1, _audioCtx->sample_rate };
+
+    // the decoders of compressed formats only output the right samples after a
+    // few frames (e.g., about 0.1s for mp3 at 44.1kHz, more at lower rates)
+    int64_t preroll = max((int64_t)SEEK_PREROLL * _audioCtx->sample_rate,
+                          (int64_t)stream->codecpar->seek_preroll);
+    if (_startSample <= preroll) return;
+
+    int64_t timestamp = av_rescale_q(_startSample - preroll, sampleTimeBase, stream->time_base);
+    if (stream->start_time != AV_NOPTS_VALUE) timestamp += stream->start_time;
+
+    if (av_seek_frame(_demuxCtx, _streamIdx, timestamp, AVSEEK_FLAG_BACKWARD) < 0) {
+        // not all formats can seek, decode them from the beginning instead
+        E_WARNING("AudioLoader: could not seek to the requested startTime, decoding the file from the beginning");
+        return;
+    }
+
+    avcodec_flush_buffers(_audioCtx);
+    _syncPosition = true;
+}
+
+
+/**
+ * Goes back to the beginning of the stream after seekAudioFile(), when the
+ * position reached by seeking cannot be known.
+ */
+void AudioLoader::rewindAudioFile() {
+    E_WARNING("AudioLoader: could not find the position reached by seeking to the requested startTime, decoding the file from the beginning");
+
+    AVStream* stream = _demuxCtx->streams[_streamIdx];
+    int64_t timestamp = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+
+    if (av_seek_frame(_demuxCtx, _streamIdx, timestamp, AVSEEK_FLAG_BACKWARD) < 0) {
+        throw EssentiaException("AudioLoader: could not find the position reached by seeking to the requested startTime, nor seek back to the beginning of the file");
+    }
+
+    avcodec_flush_buffers(_audioCtx);
+    _position = 0;
+}
+
+
 void AudioLoader::closeAudioFile() {
     if (!_demuxCtx) {
+        closeInputSource();
         return;
     }
 
@@ -167,6 +276,18 @@ void AudioLoader::closeAudioFile() {
     av_packet_unref(_packet);
     _demuxCtx = 0;
     _audioCtx = 0;
+
+    closeInputSource();
+}
+
+
+void AudioLoader::closeInputSource() {
+    if (!_ioCtx) return;
+
+    // custom IO contexts are not freed when closing the demuxer, which may
+    // also have replaced their buffer with another one
+    av_freep(&_ioCtx->buffer);
+    avio_context_free(&_ioCtx);
 }
 
 
@@ -201,9 +322,22 @@ string uint8_t_to_hex(uint8_t* input, int size) {
 
 
 AlgorithmStatus AudioLoader::process() {
-    if (!parameter("filename").isConfigured()) {
+    if (!parameter("filename").isConfigured() && !_inputSource) {
         throw EssentiaException("AudioLoader: Trying to call process() on an AudioLoader algo which hasn't been correctly configured.");
     }
+    if (!_demuxCtx) {
+        // already loaded, and not reopened by reset()
+        if (_inputSource) {
+            throw EssentiaException("AudioLoader: the input source is not open. It can only be loaded again after a reset, if it can seek");
+        }
+        throw EssentiaException("AudioLoader: the file \"", parameter("filename").toString(), "\" is not open. Reset the algorithm to load it again");
+    }
+
+    // stop as soon as the requested slice has been decoded, unless we still
+    // need to read the rest of the file to compute its checksum
+    if (_position >= _endSample && !_computeMD5) {
+        return finishAudioFile();
+    }
 
     // read frames until we get a good one
     do {
@@ -220,18 +354,7 @@ AlgorithmStatus AudioLoader::process() {
             }
             // TODO: should try reading again on EAGAIN error?
             //       https://github.com/FFmpeg/FFmpeg/blob/master/ffmpeg.c
-            shouldStop(true);
-            flushPacket();
-            closeAudioFile();
-            if (_computeMD5) {
-                av_md5_final(_md5Encoded, _checksum);
-                _md5.push(uint8_t_to_hex(_checksum, 16));
-            }
-            else {
-                string md5 = "";
-                _md5.push(md5);
-            }
-            return FINISHED;
+            return finishAudioFile();
         }
     } while (_packet->stream_index != _streamIdx);
 
@@ -240,8 +363,8 @@ AlgorithmStatus AudioLoader::process() {
         av_md5_update(_md5Encoded, _packet->data, _packet->size);
     }
 
-    // decode frames in packet
-    while(_packet->size > 0) {
+    // decode frames in packet, if we are not past the requested slice
+    while(_packet->size > 0 && _position < _endSample) {
         if (!decodePacket()) break;
             copyFFmpegOutput();
     }
@@ -252,6 +375,22 @@ AlgorithmStatus AudioLoader::process() {
 }
 
 
+AlgorithmStatus AudioLoader::finishAudioFile() {
+    shouldStop(true);
+    flushPacket();
+    closeAudioFile();
+    if (_computeMD5) {
+        av_md5_final(_md5Encoded, _checksum);
+        _md5.push(uint8_t_to_hex(_checksum, 16));
+    }
+    else {
+        string md5 = "";
+        _md5.push(md5);
+    }
+    return FINISHED;
+}
+
+
 int AudioLoader::decode_audio_frame(AVCodecContext* audioCtx,
                                     float* output,
                                     int* outputSize,
@@ -272,6 +411,27 @@ int AudioLoader::decode_audio_frame(AVCodecContext* audioCtx,
     ret = avcodec_receive_frame(audioCtx, _decodedFrame);
 
     if (ret == 0) {
+        if (_syncPosition) {
+            // first frame after seeking, find out where it starts
+            int64_t pts = _decodedFrame->best_effort_timestamp;
+            _syncPosition = false;
+            if (pts == AV_NOPTS_VALUE) {
+                // we can't tell where we landed, so decode the stream from its
+                // beginning instead, dropping this frame and the rest of its packet
+                if (!packet->data) {
+                    // flushing at the end of the stream, too late to go back
+                    throw EssentiaException("AudioLoader: could not find the position reached by seeking to the requested startTime");
+                }
+                rewindAudioFile();
+                *outputSize = 0;
+                return packet->size;
+            }
+            AVStream* stream = _demuxCtx->streams[_streamIdx];
+            AVRational sampleTimeBase = { 1, audioCtx->sample_rate };
+            if (stream->start_time != AV_NOPTS_VALUE) pts -= stream->start_time;
+            _position = av_rescale_q(pts, stream->time_base, sampleTimeBase);
+        }
+
         int inputSamples = _decodedFrame->nb_samples;
         int inputPlaneSize = av_samples_get_buffer_size(NULL, _nChannels, inputSamples,
                                                         audioCtx->sample_fmt, 1);
@@ -435,6 +595,15 @@ void AudioLoader::copyFFmpegOutput() {
     int nsamples = _dataSize / (av_get_bytes_per_sample(AV_SAMPLE_FMT_FLT)  * _nChannels);
     if (nsamples == 0) return;
 
+    // only output the samples of _buffer that lie within the requested slice
+    int64_t first = max(_startSample - _position, (int64_t)0);
+    int64_t last = min(_endSample - _position, (int64_t)nsamples);
+    _position += nsamples;
+    if (first >= last) return;
+
+    const float* buffer = _buffer + first * _nChannels;
+    nsamples = (int)(last - first);
+
     // acquire necessary data
     bool ok = _audio.acquire(nsamples);
     if (!ok) {
@@ -445,15 +614,15 @@ void AudioLoader::copyFFmpegOutput() {
 
     if (_nChannels == 1) {
         for (int i=0; i<nsamples; i++) {
-          audio[i].left() = _buffer[i];
+          audio[i].left() = buffer[i];
           //audio[i].left() = scale(_buffer[i]);
         }
     }
     else { // _nChannels == 2
       // The output format is always AV_SAMPLE_FMT_FLT, which is interleaved
       for (int i=0; i<nsamples; i++) {
-        audio[i].left() = _buffer[2*i];
-        audio[i].right() = _buffer[2*i+1];
+        audio[i].left() = buffer[2*i];
+        audio[i].right() = buffer[2*i+1];
         //audio[i].left() = scale(_buffer[2*i]);
         //audio[i].right() = scale(_buffer[2*i+1]);
       }
@@ -473,11 +642,16 @@ void AudioLoader::copyFFmpegOutput() {
 void AudioLoader::reset() {
     Algorithm::reset();
 
-    if (!parameter("filename").isConfigured()) return;
-
-    string filename = parameter("filename").toString();
+    if (!parameter("filename").isConfigured() && !_inputSource) return;
 
     closeAudioFile();
+
+    if (_inputSource && _inputSource->seek(0, SEEK_SET) < 0 && _inputSourceOpened) {
+        // we already consumed some of the source and cannot rewind it
+        return;
+    }
+
+    string filename = _inputSource ? "" : parameter("filename").toString();
     openAudioFile(filename);
 
 #if LIBAVCODEC_VERSION_MAJOR < 59
@@ -486,6 +660,16 @@ void AudioLoader::reset() {
     pushChannelsSampleRateInfo(_audioCtx->ch_layout.nb_channels, _audioCtx->sample_rate);
 #endif
     pushCodecInfo(_audioCodecName, _audioCtx->bit_rate);
+
+    Real sampleRate = _audioCtx->sample_rate;
+    _startSample = (int64_t)(parameter("startTime").toReal() * sampleRate);
+    _endSample = (int64_t)(parameter("endTime").toReal() * sampleRate);
+    _position = 0;
+    _syncPosition = false;
+
+    // the checksum is computed on the whole file, so we can only skip its
+    // beginning when we don't need it
+    if (_startSample > 0 && !_computeMD5) seekAudioFile();
 }
 
 } // namespace streaming
@@ -502,6 +686,10 @@ const char* AudioLoader::description = DOC("This algorithm loads the single audi
 "This algorithm will throw an exception if it was not properly configured which is normally due to not specifying a valid filename. Invalid names comprise those with extensions different than the supported  formats and non existent files. If using this algorithm on Windows, you must ensure that the filename is encoded as UTF-8\n\n"
 "Note: ogg files are decoded in reverse phase, due to be using ffmpeg library.\n"
 "\n"
+"Instead of a file, the audio can be decoded from memory or from any other source of encoded data set from C++ with setInputBuffer() or setInputSource() (see AudioInputSource), or from Python with setInputBuffer(bytes) or setInputSource(fileobj). This avoids writing the data to a temporary file first.\n"
+"\n"
+"The \"startTime\" and \"endTime\" parameters allow to load only a slice of the stream. The decoder seeks directly to the start of the slice and stops decoding once its end is reached, so loading a short excerpt of a long file is much faster than loading the whole file and trimming it. The slice is sample-accurate for formats with reliable timestamps. When \"computeMD5\" is enabled the whole file is still read, as the checksum always covers the whole audio payload.\n"
+"\n"
 "References:\n"
 "  [1] WAV - Wikipedia, the free encyclopedia,\n"
 "      http://en.wikipedia.org/wiki/Wav\n"
@@ -531,11 +719,14 @@ void AudioLoader::createInnerNetwork() {
 void AudioLoader::configure() {
     _loader->configure(INHERIT("filename"),
                        INHERIT("computeMD5"),
-                       INHERIT("audioStream"));
+                       INHERIT("audioStream"),
+                       INHERIT("startTime"),
+                       INHERIT("endTime"));
 }
 
 void AudioLoader::compute() {
-    if (!parameter("filename").isConfigured()) {
+    if (!parameter("filename").isConfigured() &&
+        !static_cast<streaming::AudioLoader*>(_loader)->hasInputSource()) {
         throw EssentiaException("AudioLoader: Trying to call compute() on an "
                                 "AudioLoader algo which hasn't been correctly configured.");
     }
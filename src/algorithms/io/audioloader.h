@@ -24,6 +24,7 @@
 #include "network.h"
 #include "ffmpegapi.h"
 #include "poolstorage.h"
+#include "audioinputsource.h"
 
 
 #define MAX_AUDIO_FRAME_SIZE 192000
@@ -31,7 +32,7 @@
 namespace essentia {
 namespace streaming {
 
-class AudioLoader : public Algorithm {
+class AudioLoader : public Algorithm, public AudioInputSourceReader {
  protected:
   Source<StereoSample> _audio;
   AbsoluteSource<Real> _sampleRate;
@@ -66,9 +67,35 @@ class AudioLoader : public Algorithm {
   int _selectedStream;
   bool _configured;
 
+  // slice of the stream to be loaded, in samples, and index of the first
+  // sample in _buffer (or of the next sample to be decoded)
+  int64_t _startSample;
+  int64_t _endSample;
+  int64_t _position;
+  // whether _position has to be read from the timestamp of the next decoded
+  // frame, as we just seeked into the stream
+  bool _syncPosition;
+
+  // custom source of the audio data, read through _ioCtx instead of opening
+  // the file given by the "filename" parameter
+  std::shared_ptr<AudioInputSource> _inputSource;
+  AVIOContext* _ioCtx;
+  bool _inputSourceOpened;
+
+  const static int IO_BUFFER_SIZE = 32768;
+
+  // time decoded before the requested slice when seeking to it [s]
+  const static int SEEK_PREROLL = 1;
+
+  static int readInputSource(void* opaque, uint8_t* buffer, int size);
+  static int64_t seekInputSource(void* opaque, int64_t offset, int whence);
 
   void openAudioFile(const std::string& filename);
+  void seekAudioFile();
+  void rewindAudioFile();
   void closeAudioFile();
+  void closeInputSource();
+  AlgorithmStatus finishAudioFile();
 
   void pushChannelsSampleRateInfo(int nChannels, Real sampleRate);
   void pushCodecInfo(std::string codec, int bit_rate);
@@ -82,7 +109,8 @@ class AudioLoader : public Algorithm {
  public:
   AudioLoader() : Algorithm(), _buffer(0),  _demuxCtx(0),
 	          _audioCtx(0), _audioCodecName(), _decodedFrame(0),
-            _convertCtxAv(0), _configured(false) {
+            _convertCtxAv(0), _configured(false), _startSample(0), _endSample(0),
+            _position(0), _syncPosition(false), _ioCtx(0), _inputSourceOpened(false) {
 
     declareOutput(_audio, 1, "audio", "the input audio signal");
     declareOutput(_sampleRate, 0, "sampleRate", "the sampling rate of the audio signal [Hz]");
@@ -107,10 +135,20 @@ class AudioLoader : public Algorithm {
   AlgorithmStatus process();
   void reset();
 
+  /**
+   * Decodes the audio from @c source instead of the file given by the
+   * "filename" parameter. The source is rewound every time the loader is
+   * reset, so sources that cannot seek can only be loaded once.
+   */
+  void setInputSource(const std::shared_ptr<AudioInputSource>& source);
+  bool hasInputSource() const { return (bool)_inputSource; }
+
   void declareParameters() {
     declareParameter("filename", "the name of the file from which to read", "", Parameter::STRING);
     declareParameter("computeMD5", "compute the MD5 checksum", "{true,false}", false);
     declareParameter("audioStream", "audio stream index to be loaded. Other streams are not taken into account (e.g. if stream 0 is video and 1 is audio use index 0 to access it.)", "[0,inf)", 0);
+    declareParameter("startTime", "the start time of the slice to be loaded [s]", "[0,inf)", 0.0);
+    declareParameter("endTime", "the end time of the slice to be loaded [s]", "[0,inf)", 1e6);
   }
 
   void configure();
@@ -133,7 +171,7 @@ namespace standard {
 
 // Standard non-streaming algorithm comes after the streaming one as it
 // depends on it
-class AudioLoader : public Algorithm {
+class AudioLoader : public Algorithm, public AudioInputSourceReader {
 
  protected:
   Output<std::vector<StereoSample> > _audio;
@@ -172,6 +210,8 @@ class AudioLoader : public Algorithm {
     declareParameter("filename", "the name of the file from which to read", "", Parameter::STRING);
     declareParameter("computeMD5", "compute the MD5 checksum", "{true,false}", false);
     declareParameter("audioStream", "audio stream index to be loaded. Other streams are no taken into account (e.g. if stream 0 is video and 1 is audio use index 0 to access it.)", "[0,inf)", 0);
+    declareParameter("startTime", "the start time of the slice to be loaded [s]", "[0,inf)", 0.0);
+    declareParameter("endTime", "the end time of the slice to be loaded [s]", "[0,inf)", 1e6);
   }
 
   void configure();
@@ -179,6 +219,10 @@ class AudioLoader : public Algorithm {
   void compute();
   void reset();
 
+  void setInputSource(const std::shared_ptr<AudioInputSource>& source) {
+    static_cast<streaming::AudioLoader*>(_loader)->setInputSource(source);
+  }
+
   static const char* name;
   static const char* category;
   static const char* description;
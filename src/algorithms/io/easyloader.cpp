@@ -58,16 +58,26 @@ void EasyLoader::configure() {
   // if no file has been specified, do not do anything
   if (!parameter("filename").isConfigured()) return;
 
+  // only decode the requested slice, with some margin on each side so that the
+  // resampler has some context around it, and trim it to its exact boundaries
+  // at the output sampling rate
+  const Real margin = 0.1;
+  Real startTime = parameter("startTime").toReal();
+  Real endTime = parameter("endTime").toReal();
+  Real loadStartTime = max(startTime - margin, (Real)0.);
+
   _monoLoader->configure(INHERIT("filename"),
                          INHERIT("sampleRate"),
                          INHERIT("downmix"),
-                         INHERIT("audioStream"));
+                         INHERIT("audioStream"),
+                         "startTime", loadStartTime,
+                         "endTime", endTime + margin);
 
   _params.add("originalSampleRate", _monoLoader->parameter("originalSampleRate"));
 
   _trimmer->configure(INHERIT("sampleRate"),
-                      INHERIT("startTime"),
-                      INHERIT("endTime"));
+                      "startTime", startTime - loadStartTime,
+                      "endTime", endTime - loadStartTime);
 
   // apply a 6dB preamp, as done by all audio players.
   Real scalingFactor = db2amp(parameter("replayGain").toReal() + 6.0);
@@ -86,6 +96,8 @@ const char* EasyLoader::name = "EasyLoader";
 const char* EasyLoader::category = "Input/output";
 const char* EasyLoader::description = DOC("This algorithm loads the raw audio data from an audio file, downmixes it to mono and normalizes using replayGain. The audio is resampled in case the given sampling rate does not match the sampling rate of the input signal and is normalized by the given replayGain value.\n"
 "\n"
+"Only the slice of the file between \"startTime\" and \"endTime\" is decoded, so loading a short excerpt of a long file does not require decoding the whole file.\n"
+"\n"
 "This algorithm uses MonoLoader and therefore inherits all of its input requirements and exceptions.\n"
 "\n"
 "References:\n"
@@ -55,13 +55,23 @@ void EqloudLoader::configure() {
   // if no file has been specified, do not do anything
   if (!parameter("filename").isConfigured()) return;
 
+  // only decode the requested slice, with some margin on each side so that the
+  // resampler has some context around it, and trim it to its exact boundaries
+  // at the output sampling rate
+  const Real margin = 0.1;
+  Real startTime = parameter("startTime").toReal();
+  Real endTime = parameter("endTime").toReal();
+  Real loadStartTime = max(startTime - margin, (Real)0.);
+
   _monoLoader->configure(INHERIT("filename"),
                          INHERIT("sampleRate"),
-                         INHERIT("downmix"));
+                         INHERIT("downmix"),
+                         "startTime", loadStartTime,
+                         "endTime", endTime + margin);
 
   _trimmer->configure(INHERIT("sampleRate"),
-                      INHERIT("startTime"),
-                      INHERIT("endTime"));
+                      "startTime", startTime - loadStartTime,
+                      "endTime", endTime - loadStartTime);
 
   // apply a 6dB preamp, as done by all audio players.
   Real scalingFactor = db2amp(parameter("replayGain").toReal() + 6.0);
@@ -151,9 +151,9 @@ struct YamlNode {
 };
 
 
-template <typename IterType>
-void fillYamlTreeHelper(YamlNode* root, const IterType it) {
-  vector<string> pathparts = split(it->first);
+template <typename T>
+void fillYamlTreeHelper(YamlNode* root, const string& name, const T& value) {
+  vector<string> pathparts = split(name);
   YamlNode* currNode = root;
 
   // iterate over each of the pieces of the path
@@ -177,7 +177,7 @@ void fillYamlTreeHelper(YamlNode* root, const IterType it) {
   }
 
   // end of the path
-  currNode->value = new Parameter(it->second);
+  currNode->value = new Parameter(value);
 }
 
 /*
@@ -216,13 +216,21 @@ void fillYamlTree (const Pool& p, YamlNode* root) {
   #define FILL_YAML_TREE_MACRO(type, tname)                                    \
   for (map<string, type >::const_iterator it = p.get##tname##Pool().begin();   \
        it != p.get##tname##Pool().end(); ++it) {                               \
-    fillYamlTreeHelper(root, it);                                              \
+    fillYamlTreeHelper(root, it->first, it->second);                           \
   }
 
   FILL_YAML_TREE_MACRO(Real, SingleReal);
   FILL_YAML_TREE_MACRO(vector<Real>, Real);
   FILL_YAML_TREE_MACRO(vector<Real>, SingleVectorReal);
-  FILL_YAML_TREE_MACRO(vector<vector<Real> >, VectorReal);
+
+  // the frames are copied one descriptor at a time, the copy only living
+  // until the parameter holding them is built
+  for (map<string, VectorRealFrames>::const_iterator it = p.getVectorRealFramesPool().begin();
+       it != p.getVectorRealFramesPool().end(); ++it) {
+    vector<vector<Real> > frames;
+    it->second.copyTo(frames);
+    fillYamlTreeHelper(root, it->first, frames);
+  }
 
   FILL_YAML_TREE_MACRO(string, SingleString);
   FILL_YAML_TREE_MACRO(vector<string>, String);
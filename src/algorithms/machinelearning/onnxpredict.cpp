@@ -0,0 +1,399 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "onnxpredict.h"
+#include <algorithm>
+
+using namespace std;
+using namespace essentia;
+using namespace standard;
+
+const char* OnnxPredict::name = "OnnxPredict";
+const char* OnnxPredict::category = "Machine Learning";
+const char* OnnxPredict::description = DOC("This algorithm runs an ONNX model and stores the desired output tensors in a pool.\n"
+"It is the ONNX Runtime [1] counterpart of TensorflowPredict: models exported to the ONNX format [2] (e.g., with tf2onnx [3]) run with the same interface, "
+"and the lighter runtime reduces the time to load the models and the latency of each inference on CPU.\n"
+"The model should be stored in an .onnx file given by `graphFilename`.\n"
+"The parameter `inputs` should contain a list with the names of the inputs of the model. The input Pool should contain the tensors corresponding to each input stored using Essentia tensors. "
+"The pool namespace for each input tensor has to match the input's name. "
+"In the same way, the `outputs` parameter should contain the names of the outputs to save. These tensors will be stored inside the output pool under a namespace that matches the output's name. "
+"When `inputs` or `outputs` are empty, all the inputs or outputs of the model are used, in the order in which the model declares them.\n"
+"\n"
+"As in TensorflowPredict, by default (`shareModel`) the model and its session are shared by all the instances of this algorithm in the process configured with the same model and number of threads, "
+"so that the model is only loaded once. ONNX Runtime sessions do not keep any state between runs, so the reset method does not do anything.\n"
+"\n"
+"Only models with 32-bit floating point inputs and outputs of up to 4 dimensions (including the batch dimension) are supported.\n"
+"\n"
+"References:\n"
+"  [1] ONNX Runtime - A cross-platform inference and training machine-learning accelerator.\n"
+"  https://onnxruntime.ai/\n\n"
+"  [2] ONNX - Open Neural Network Exchange.\n"
+"  https://onnx.ai/\n\n"
+"  [3] tf2onnx - Convert TensorFlow, Keras, Tensorflow.js and Tflite models to ONNX.\n"
+"  https://github.com/onnx/tensorflow-onnx");
+
+
+// Throws an exception with the message of a failed ONNX Runtime call.
+static void checkStatus(OrtStatus* status, const string& message) {
+  if (status == NULL) return;
+
+  string error = OnnxModel::api()->GetErrorMessage(status);
+  OnnxModel::api()->ReleaseStatus(status);
+  throw EssentiaException("OnnxPredict: ", message, " ", error);
+}
+
+
+OnnxPredict::OnnxPredict() : _nInputs(0), _nOutputs(0), _memoryInfo(NULL), _isConfigured(false) {
+  declareInput(_poolIn, "poolIn", "the pool where to get the feature tensors");
+  declareOutput(_poolOut, "poolOut", "the pool where to store the output tensors");
+
+  checkStatus(OnnxModel::api()->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &_memoryInfo),
+              "Error creating the memory info of the input tensors.");
+}
+
+
+OnnxPredict::~OnnxPredict() {
+  deleteTensors();
+  if (_memoryInfo) OnnxModel::api()->ReleaseMemoryInfo(_memoryInfo);
+}
+
+
+void OnnxPredict::configure() {
+  _graphFilename = parameter("graphFilename").toString();
+
+  if (_graphFilename.empty() && _isConfigured) {
+    E_WARNING("OnnxPredict: You are trying to update a valid configuration with invalid parameters. "
+              "If you want to update the configuration specify a valid `graphFilename` parameter.");
+  };
+
+  // Do not do anything if we did not get a non-empty model name.
+  if (_graphFilename.empty()) return;
+
+  _squeeze = parameter("squeeze").toBool();
+
+  // Drop the previous model before loading the new one, so that it is not
+  // kept in memory twice when the same model is reloaded without sharing it.
+  _model.reset();
+  _isConfigured = false;
+
+  _model = OnnxModel::load(_graphFilename,
+                           parameter("intraOpThreads").toInt(),
+                           parameter("interOpThreads").toInt(),
+                           parameter("shareModel").toBool());
+
+  _inputNames = parameter("inputs").toVectorString();
+  _outputNames = parameter("outputs").toVectorString();
+
+  if (_inputNames.empty()) _inputNames = _model->inputNames();
+  if (_outputNames.empty()) _outputNames = _model->outputNames();
+
+  checkNames(_inputNames, _model->inputNames(), "input");
+  checkNames(_outputNames, _model->outputNames(), "output");
+
+  _nInputs = _inputNames.size();
+  _nOutputs = _outputNames.size();
+
+  _inputNodes.resize(_nInputs);
+  for (size_t i = 0; i < _nInputs; i++) _inputNodes[i] = _inputNames[i].c_str();
+
+  _outputNodes.resize(_nOutputs);
+  for (size_t i = 0; i < _nOutputs; i++) _outputNodes[i] = _outputNames[i].c_str();
+
+  _inputTensors.assign(_nInputs, NULL);
+  _outputTensors.assign(_nOutputs, NULL);
+
+  _isConfigured = true;
+}
+
+
+void OnnxPredict::checkNames(const vector<string>& names,
+                             const vector<string>& available,
+                             const string& kind) {
+  for (size_t i = 0; i < names.size(); i++) {
+    if (find(available.begin(), available.end(), names[i]) != available.end()) continue;
+
+    string info;
+    for (size_t j = 0; j < available.size(); j++) {
+      info += (j ? ", " : "") + available[j];
+    }
+    throw EssentiaException("OnnxPredict: '" + names[i] + "' is not a valid " + kind +
+                            " of the model. Available " + kind + "s are: " + info + ".");
+  }
+}
+
+
+void OnnxPredict::reset() {}
+
+
+void OnnxPredict::compute() {
+  const Pool& poolIn = _poolIn.get();
+  Pool& poolOut = _poolOut.get();
+
+  // The input tensors are passed from the pool to ONNX Runtime without copies.
+  _inputData.resize(_nInputs);
+  for (size_t i = 0; i < _nInputs; i++) {
+    _inputData[i] = &poolIn.value<Tensor<Real> >(_inputNames[i]);
+  }
+
+  predict(_inputData, _outputData);
+
+  // Copy the desired tensors into the output pool.
+  for (size_t i = 0; i < _nOutputs; i++) {
+    poolOut.set(_outputNames[i], _outputData[i]);
+  }
+}
+
+
+void OnnxPredict::predict(const vector<const Tensor<Real>*>& inputs,
+                          vector<Tensor<Real> >& outputs) {
+  if (!_isConfigured) {
+    throw EssentiaException("OnnxPredict: This algorithm is not configured. To configure this algorithm you "
+                            "should specify a valid `graphFilename` as input parameter.");
+  }
+
+  if (inputs.size() != _nInputs) {
+    throw EssentiaException("OnnxPredict: Expected ", _nInputs, " input tensors but got ", inputs.size());
+  }
+
+  try {
+    // Wrap the input tensors into ONNX Runtime values.
+    for (size_t i = 0; i < _nInputs; i++) {
+      _inputTensors[i] = TensorToOrt(*inputs[i]);
+    }
+
+    // The output values are allocated by ONNX Runtime.
+    checkStatus(OnnxModel::api()->Run(_model->session(),
+                                      NULL,                // Run options.
+                                      &_inputNodes[0],     // Input names.
+                                      &_inputTensors[0],   // Input values.
+                                      _nInputs,            // Number of inputs.
+                                      &_outputNodes[0],    // Output names.
+                                      _nOutputs,           // Number of outputs.
+                                      &_outputTensors[0]), // Output values.
+                "Error running the model.");
+
+    // Copy the desired tensors into the output buffers.
+    outputs.resize(_nOutputs);
+    for (size_t i = 0; i < _nOutputs; i++) {
+      OrtToTensor(_outputTensors[i], outputs[i]);
+    }
+  }
+  catch (EssentiaException&) {
+    deleteTensors();
+    throw;
+  }
+
+  deleteTensors();
+}
+
+
+void OnnxPredict::deleteTensors() {
+  for (size_t i = 0; i < _inputTensors.size(); i++) {
+    if (_inputTensors[i]) OnnxModel::api()->ReleaseValue(_inputTensors[i]);
+    _inputTensors[i] = NULL;
+  }
+
+  for (size_t i = 0; i < _outputTensors.size(); i++) {
+    if (_outputTensors[i]) OnnxModel::api()->ReleaseValue(_outputTensors[i]);
+    _outputTensors[i] = NULL;
+  }
+}
+
+
+OrtValue* OnnxPredict::TensorToOrt(const Tensor<Real>& tensorIn) {
+  vector<int64_t> shape;
+
+  // With squeeze, the Batch dimension is the only one allowed to be singleton
+  shape.push_back((int64_t)tensorIn.dimension(0));
+
+  if (_squeeze) {
+    for (int i = 1; i < tensorIn.rank(); i++) {
+      if (tensorIn.dimension(i) > 1) shape.push_back((int64_t)tensorIn.dimension(i));
+    }
+
+    // There should be at least 2 dimensions (batch, data)
+    if (shape.size() == 1) shape.push_back((int64_t)1);
+  }
+  else {
+    for (int i = 1; i < tensorIn.rank(); i++) shape.push_back((int64_t)tensorIn.dimension(i));
+  }
+
+  // Squeezing does not change the layout of the data, so the ONNX Runtime
+  // value can point to the memory of the Essentia tensor.
+  OrtValue* tensorOut = NULL;
+  checkStatus(OnnxModel::api()->CreateTensorWithDataAsOrtValue(
+                  _memoryInfo, const_cast<Real*>(tensorIn.data()),
+                  (size_t)tensorIn.size() * sizeof(Real),
+                  &shape[0], shape.size(),
+                  ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &tensorOut),
+              "Error generating input tensor.");
+
+  return tensorOut;
+}
+
+
+void OnnxPredict::OrtToTensor(OrtValue* tensor, Tensor<Real>& tensorOut) {
+  const OrtApi* api = OnnxModel::api();
+
+  OrtTensorTypeAndShapeInfo* info = NULL;
+  checkStatus(api->GetTensorTypeAndShape(tensor, &info), "Error getting the output tensor's shape.");
+
+  size_t outNDims = 0;
+  ONNXTensorElementDataType type = ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED;
+  OrtStatus* status = api->GetDimensionsCount(info, &outNDims);
+  if (!status) status = api->GetTensorElementType(info, &type);
+
+  vector<int64_t> dims(outNDims);
+  if (!status && outNDims) status = api->GetDimensions(info, &dims[0], outNDims);
+
+  api->ReleaseTensorTypeAndShapeInfo(info);
+  checkStatus(status, "Error getting the output tensor's shape.");
+
+  if (type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+    throw EssentiaException("OnnxPredict: Only 32-bit floating point outputs are supported.");
+  }
+
+  if (outNDims < 1 || outNDims > 4) {
+    throw EssentiaException("OnnxPredict: Only outputs with 1 to 4 dimensions are supported, but got ", outNDims);
+  }
+
+  // As in TensorflowPredict, we are assuming one of the following cases:
+  //       1 - outNDims = 2 -> Batch + Feats
+  //       2 - outNDims = 3 -> Batch + Timestamps + Feats
+  //       3 - outNDims = 4 -> Batch + Channels + Timestamps + Feats
+  array<long int, 4> shape {1, 1, 1, 1};
+  shape[0] = (long int)dims[0];
+  for (size_t i = 1; i < outNDims; i++) {
+    shape[shape.size() - outNDims + i] = (long int)dims[i];
+  }
+
+  // Reuse the memory of the output tensor when the shape did not change.
+  bool sameShape = true;
+  for (int i = 0; i < tensorOut.rank(); i++) {
+    if (tensorOut.dimension(i) != shape[i]) sameShape = false;
+  }
+  if (!sameShape) tensorOut.resize(shape);
+
+  void* outputData = NULL;
+  checkStatus(api->GetTensorMutableData(tensor, &outputData), "Error getting the output tensor's data.");
+
+  memcpy(tensorOut.data(), outputData, tensorOut.size() * sizeof(Real));
+}
+
+
+OrtEnv* OnnxModel::_environment = NULL;
+ForcedMutex OnnxModel::_environmentMutex;
+SharedInstances<OnnxModel> OnnxModel::_sharedModels;
+
+
+const OrtApi* OnnxModel::api() {
+  // Returns NULL if the ONNX Runtime library is older than its headers.
+  static const OrtApi* ortApi = OrtGetApiBase()->GetApi(ORT_API_VERSION);
+
+  if (!ortApi) {
+    throw EssentiaException("OnnxPredict: The ONNX Runtime library does not support the API version ",
+                            ORT_API_VERSION, " Essentia was built with.");
+  }
+  return ortApi;
+}
+
+
+OnnxModel::~OnnxModel() {
+  if (_session) api()->ReleaseSession(_session);
+  if (_sessionOptions) api()->ReleaseSessionOptions(_sessionOptions);
+}
+
+
+shared_ptr<OnnxModel> OnnxModel::load(const string& graphFilename,
+                                      int intraOpThreads, int interOpThreads,
+                                      bool shared) {
+  string key = graphFilename + "|" + to_string(intraOpThreads) + "|" + to_string(interOpThreads);
+
+  {
+    // The environment holds the global thread pools and logger. It is never
+    // released, as it must outlive all the sessions.
+    ForcedMutexLocker lock(_environmentMutex);
+    if (!_environment) {
+      checkStatus(api()->CreateEnv(ORT_LOGGING_LEVEL_WARNING, "essentia", &_environment),
+                  "Error creating the ONNX Runtime environment.");
+    }
+  }
+
+  SharedInstances<OnnxModel>::Creator create = [&]() {
+    shared_ptr<OnnxModel> model(new OnnxModel());
+    model->loadModel(graphFilename, intraOpThreads, interOpThreads);
+    return model;
+  };
+
+  if (!shared) return create();
+
+  // As for TensorFlow, only the callers asking for the same model wait for
+  // each other.
+  return _sharedModels.get(key, create);
+}
+
+
+void OnnxModel::loadModel(const string& graphFilename, int intraOpThreads, int interOpThreads) {
+  checkStatus(api()->CreateSessionOptions(&_sessionOptions), "Error creating the session options.");
+
+  if (intraOpThreads > 0) {
+    checkStatus(api()->SetIntraOpNumThreads(_sessionOptions, intraOpThreads),
+                "Error setting the number of threads of the session.");
+  }
+  if (interOpThreads > 0) {
+    checkStatus(api()->SetInterOpNumThreads(_sessionOptions, interOpThreads),
+                "Error setting the number of threads of the session.");
+  }
+  checkStatus(api()->SetSessionGraphOptimizationLevel(_sessionOptions, ORT_ENABLE_ALL),
+              "Error setting the optimization level of the session.");
+
+  // ONNX Runtime takes wide-character paths on Windows.
+#ifdef _WIN32
+  wstring path(graphFilename.begin(), graphFilename.end());
+#else
+  const string& path = graphFilename;
+#endif
+
+  checkStatus(api()->CreateSession(_environment, path.c_str(), _sessionOptions, &_session),
+              "Error loading the model `" + graphFilename + "`.");
+
+  // Keep the names of the inputs and outputs, which are needed to run it.
+  OrtAllocator* allocator = NULL;
+  checkStatus(api()->GetAllocatorWithDefaultOptions(&allocator), "Error getting the default allocator.");
+
+  size_t nInputs = 0, nOutputs = 0;
+  checkStatus(api()->SessionGetInputCount(_session, &nInputs), "Error getting the inputs of the model.");
+  checkStatus(api()->SessionGetOutputCount(_session, &nOutputs), "Error getting the outputs of the model.");
+
+  for (size_t i = 0; i < nInputs; i++) {
+    char* name = NULL;
+    checkStatus(api()->SessionGetInputName(_session, i, allocator, &name), "Error getting the inputs of the model.");
+    _inputNames.push_back(name);
+    checkStatus(api()->AllocatorFree(allocator, name), "Error releasing the name of an input.");
+  }
+
+  for (size_t i = 0; i < nOutputs; i++) {
+    char* name = NULL;
+    checkStatus(api()->SessionGetOutputName(_session, i, allocator, &name), "Error getting the outputs of the model.");
+    _outputNames.push_back(name);
+    checkStatus(api()->AllocatorFree(allocator, name), "Error releasing the name of an output.");
+  }
+
+  E_INFO("OnnxPredict: Successfully loaded model: `" << graphFilename << "`");
+}
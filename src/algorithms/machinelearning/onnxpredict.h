@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_ONNXPREDICT_H
+#define ESSENTIA_ONNXPREDICT_H
+
+#include <memory>
+#include "algorithm.h"
+#include "pool.h"
+#include "threading.h"
+#include "sharedinstances.h"
+#include <onnxruntime_c_api.h>
+
+
+namespace essentia {
+
+/**
+ * An ONNX model loaded into an ONNX Runtime session.
+ *
+ * Sessions can be run concurrently, so by default a model is loaded only once
+ * and shared by all the algorithms using it (see load()). All the sessions
+ * belong to a single ONNX Runtime environment, created the first time a model
+ * is loaded.
+ */
+class OnnxModel {
+ public:
+  ~OnnxModel();
+
+  /**
+   * Loads the model stored in @c graphFilename. If @c shared is true and the
+   * same model is already loaded with the same number of threads, the loaded
+   * instance is returned instead.
+   */
+  static std::shared_ptr<OnnxModel> load(const std::string& graphFilename,
+                                         int intraOpThreads, int interOpThreads,
+                                         bool shared);
+
+  OrtSession* session() { return _session; }
+  const std::vector<std::string>& inputNames() const { return _inputNames; }
+  const std::vector<std::string>& outputNames() const { return _outputNames; }
+
+  static const OrtApi* api();
+
+ protected:
+  OnnxModel() : _sessionOptions(NULL), _session(NULL) {}
+
+  void loadModel(const std::string& graphFilename, int intraOpThreads, int interOpThreads);
+
+  OrtSessionOptions* _sessionOptions;
+  OrtSession* _session;
+
+  std::vector<std::string> _inputNames;
+  std::vector<std::string> _outputNames;
+
+  static OrtEnv* _environment;
+  static ForcedMutex _environmentMutex;
+  static SharedInstances<OnnxModel> _sharedModels;
+};
+
+
+namespace standard {
+
+class OnnxPredict : public Algorithm {
+
+ protected:
+  Input<Pool> _poolIn;
+  Output<Pool> _poolOut;
+
+  std::string _graphFilename;
+  std::vector<std::string> _inputNames;
+  std::vector<std::string> _outputNames;
+
+  // null-terminated versions of the names, as taken by ONNX Runtime
+  std::vector<const char*> _inputNodes;
+  std::vector<const char*> _outputNodes;
+
+  std::vector<OrtValue*> _inputTensors;
+  std::vector<OrtValue*> _outputTensors;
+
+  size_t _nInputs;
+  size_t _nOutputs;
+
+  std::shared_ptr<OnnxModel> _model;
+  OrtMemoryInfo* _memoryInfo;
+
+  bool _squeeze;
+
+  bool _isConfigured;
+
+  std::vector<const Tensor<Real>*> _inputData;
+  std::vector<Tensor<Real> > _outputData;
+
+  OrtValue* TensorToOrt(const Tensor<Real>& tensorIn);
+  void OrtToTensor(OrtValue* tensor, Tensor<Real>& tensorOut);
+  void deleteTensors();
+  void checkNames(const std::vector<std::string>& names,
+                  const std::vector<std::string>& available,
+                  const std::string& kind);
+
+ public:
+  OnnxPredict();
+  ~OnnxPredict();
+
+  void declareParameters() {
+    declareParameter("graphFilename", "the name of the file from which to load the ONNX model", "", "");
+    declareParameter("inputs", "will look for these namespaces in poolIn. Should match the names of the inputs of the ONNX model. Leave it empty to use all the inputs of the model", "", std::vector<std::string>());
+    declareParameter("outputs", "will save the tensors of the ONNX model outputs named after `outputs` to the same namespaces in the output pool. Leave it empty to use all the outputs of the model", "", std::vector<std::string>());
+    declareParameter("squeeze", "remove singleton dimensions of the inputs tensors. Does not apply to the batch dimension", "{true,false}", true);
+    declareParameter("shareModel", "share the loaded model and its session with the other instances of this algorithm configured with the same model and number of threads", "{true,false}", true);
+    declareParameter("intraOpThreads", "the number of threads used to run each ONNX operator (0 to let ONNX Runtime decide)", "[0,inf)", 0);
+    declareParameter("interOpThreads", "the number of ONNX operators that can run in parallel (0 to let ONNX Runtime decide)", "[0,inf)", 0);
+  }
+
+  void configure();
+  void compute();
+  void reset();
+
+  /**
+   * Runs the model on the given tensors (one for each of the `inputs`) and
+   * stores the tensors of the `outputs` in @c outputs. The input tensors are
+   * passed to ONNX Runtime without copying them, so they must stay alive and
+   * unmodified until this method returns, and the output tensors are only
+   * reallocated when their shape changes from the previous call.
+   */
+  void predict(const std::vector<const Tensor<Real>*>& inputs,
+               std::vector<Tensor<Real> >& outputs);
+
+  const std::vector<std::string>& inputNames() const { return _inputNames; }
+  const std::vector<std::string>& outputNames() const { return _outputNames; }
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} //namespace standard
+} //namespace essentia
+
+
+#include "streamingalgorithmwrapper.h"
+
+namespace essentia {
+namespace streaming {
+
+class OnnxPredict : public StreamingAlgorithmWrapper {
+
+ protected:
+  Sink<Pool> _poolIn;
+  Source<Pool> _poolOut;
+
+ public:
+  OnnxPredict() {
+    declareAlgorithm("OnnxPredict");
+    declareInput(_poolIn, TOKEN, "poolIn");
+    declareOutput(_poolOut, TOKEN, "poolOut");
+    _poolOut.setBufferType(BufferUsage::forSingleFrames);
+  }
+};
+
+} //namespace streaming
+} //namespace essentia
+
+#endif // ESSENTIA_ONNXPREDICT_H
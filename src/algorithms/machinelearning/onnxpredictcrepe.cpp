@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "onnxpredictcrepe.h"
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+const char* OnnxPredictCREPE::name = essentia::standard::OnnxPredictCREPE::name;
+const char* OnnxPredictCREPE::category = essentia::standard::OnnxPredictCREPE::category;
+const char* OnnxPredictCREPE::description = essentia::standard::OnnxPredictCREPE::description;
+
+
+Algorithm* OnnxPredictCREPE::createPredictor() {
+  return AlgorithmFactory::create("OnnxPredictTensor");
+}
+
+
+void OnnxPredictCREPE::configurePredictor() {
+  string input = parameter("input").toString();
+  string output = parameter("output").toString();
+
+  // Without names, OnnxPredictTensor takes the only input and output of the model.
+  vector<string> inputs, outputs;
+  if (!input.empty()) inputs.push_back(input);
+  if (!output.empty()) outputs.push_back(output);
+
+  _predictor->configure("graphFilename", parameter("graphFilename"),
+                        "inputs", inputs,
+                        "outputs", outputs);
+}
+
+} // namespace streaming
+} // namespace essentia
+
+
+
+namespace essentia {
+namespace standard {
+
+const char* OnnxPredictCREPE::name = "OnnxPredictCREPE";
+const char* OnnxPredictCREPE::category = "Machine Learning";
+const char* OnnxPredictCREPE::description = DOC(
+  "This algorithm generates activations of monophonic audio signals using CREPE models "
+  "exported to the ONNX format. It works as TensorflowPredictCREPE, but runs the models "
+  "with ONNX Runtime (see OnnxPredict), which is lighter and faster to load.\n"
+  "\n"
+  "`input` and `output` are the names of the input and output of the model, and can be "
+  "left empty for models with a single input and output. `hopSize` allows to change the pitch "
+  "estimation rate. `batchSize` controls how many pitch timestamps to process in parallel. "
+  "By default it processes everything at the end of the audio stream, but it can be set to "
+  "process batches periodically for online applications.\n"
+  "\n"
+  "The recommended pipeline is as follows::\n"
+  "\n"
+  "  MonoLoader(sampleRate=16000)       >> OnnxPredictCREPE()\n"
+  "\n"
+  "Notes:\n"
+  "This algorithm does not make any check on the input model so it is "
+  "the user's responsibility to make sure it is a valid one.\n"
+  "The required sample rate of input signal is 16 KHz. "
+  "Other sample rates will lead to an incorrect behavior.\n"
+  "\n"
+  "References:\n"
+  "\n"
+  "1. CREPE: A Convolutional Representation for Pitch Estimation. "
+  "Jong Wook Kim, Justin Salamon, Peter Li, Juan Pablo Bello. "
+  "Proceedings of the IEEE International Conference on Acoustics, Speech, and Signal "
+  "Processing (ICASSP), 2018.\n"
+  "\n"
+  "2. Original models and code at https://github.com/marl/crepe/\n"
+  "\n"
+  "3. Supported models at https://essentia.upf.edu/models/\n\n");
+
+} // namespace standard
+} // namespace essentia
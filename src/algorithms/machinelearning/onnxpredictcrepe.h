@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_ONNXPREDICTCREPE_H
+#define ESSENTIA_ONNXPREDICTCREPE_H
+
+
+#include "tensorflowpredictcrepe.h"
+
+namespace essentia {
+namespace streaming {
+
+// Same network as TensorflowPredictCREPE, with the model run by OnnxPredictTensor.
+class OnnxPredictCREPE : public TensorflowPredictCREPE {
+ protected:
+  Algorithm* createPredictor();
+  void configurePredictor();
+
+ public:
+  void declareParameters() {
+    declareParameter("graphFilename", "the name of the file from which to load the ONNX model", "", "");
+    declareParameter("input", "the name of the input of the ONNX model. It can be left empty for models with a single input", "", "");
+    declareParameter("output", "the name of the output of the ONNX model from which to retrieve the predictions. It can be left empty for models with a single output", "", "");
+    declareParameter("hopSize", "the hop size in milliseconds for running pitch estimations", "(0,inf)", 10.0);
+    declareParameter("batchSize", "the batch size for prediction. This allows parallelization when a GPU is available. Set it to -1 or 0 to accumulate all the patches and run the model a single time at the end of the stream", "[-1,inf)", 64);
+  }
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+
+};
+
+} // namespace streaming
+} // namespace essentia
+
+namespace essentia {
+namespace standard {
+
+class OnnxPredictCREPE : public TensorflowPredictCREPE {
+ public:
+  OnnxPredictCREPE() : TensorflowPredictCREPE("OnnxPredictCREPE") {}
+
+  void declareParameters() {
+    declareParameter("graphFilename", "the name of the file from which to load the ONNX model", "", "");
+    declareParameter("input", "the name of the input of the ONNX model. It can be left empty for models with a single input", "", "");
+    declareParameter("output", "the name of the output of the ONNX model from which to retrieve the predictions. It can be left empty for models with a single output", "", "");
+    declareParameter("hopSize", "the hop size in milliseconds for running pitch estimations", "(0,inf)", 10.0);
+    declareParameter("batchSize", "the batch size for prediction. This allows parallelization when a GPU is available. Set it to -1 or 0 to accumulate all the patches and run the model a single time at the end of the stream", "[-1,inf)", 16);
+  }
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} // namespace standard
+} // namespace essentia
+
+#endif // ESSENTIA_ONNXPREDICTCREPE_H
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "onnxpredicteffnetdiscogs.h"
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+const char* OnnxPredictEffnetDiscogs::name = essentia::standard::OnnxPredictEffnetDiscogs::name;
+const char* OnnxPredictEffnetDiscogs::category = essentia::standard::OnnxPredictEffnetDiscogs::category;
+const char* OnnxPredictEffnetDiscogs::description = essentia::standard::OnnxPredictEffnetDiscogs::description;
+
+
+Algorithm* OnnxPredictEffnetDiscogs::createPredictor() {
+  return AlgorithmFactory::create("OnnxPredictTensor");
+}
+
+
+void OnnxPredictEffnetDiscogs::configurePredictor() {
+  string input = parameter("input").toString();
+  string output = parameter("output").toString();
+
+  // Without names, OnnxPredictTensor takes the only input and output of the model.
+  vector<string> inputs, outputs;
+  if (!input.empty()) inputs.push_back(input);
+  if (!output.empty()) outputs.push_back(output);
+
+  _predictor->configure("graphFilename", parameter("graphFilename"),
+                        "inputs", inputs,
+                        "outputs", outputs);
+}
+
+} // namespace streaming
+} // namespace essentia
+
+
+
+namespace essentia {
+namespace standard {
+
+const char* OnnxPredictEffnetDiscogs::name = "OnnxPredictEffnetDiscogs";
+const char* OnnxPredictEffnetDiscogs::category = "Machine Learning";
+const char* OnnxPredictEffnetDiscogs::description = DOC(
+  "This algorithm makes predictions using EffnetDiscogs-based models exported to the ONNX "
+  "format. It works as TensorflowPredictEffnetDiscogs, but runs the models with ONNX "
+  "Runtime (see OnnxPredict), which is lighter and faster to load.\n"
+  "\n"
+  "Internally, it uses TensorflowInputMusiCNN for the input feature extraction "
+  "(mel-spectrograms). It feeds the model with patches of 128 frames and "
+  "jumps a constant amount of frames determined by `patchHopSize`.\n"
+  "\n"
+  "By setting the `batchSize` parameter to -1 or 0 the patches are stored to run a single "
+  "inference at the end of the stream. This allows to take advantage "
+  "of parallelization when GPUs are available, but at the same time it can be "
+  "memory exhausting for long files. "
+  "This option is not supported by some EffnetDiscogs models that require a fixed batch size.\n"
+  "\n"
+  "The recommended pipeline is as follows::\n"
+  "\n"
+  "  MonoLoader(sampleRate=16000)          >> OnnxPredictEffnetDiscogs\n"
+  "\n"
+  "Note: This algorithm does not make any check on the input model so it is "
+  "the user's responsibility to make sure it is a valid one.\n"
+  "\n"
+  "References:\n"
+  "\n"
+  "1. Supported models at https://essentia.upf.edu/models/\n\n");
+
+} // namespace standard
+} // namespace essentia
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_ONNXPREDICTTEMPOCNN_H
+#define ESSENTIA_ONNXPREDICTTEMPOCNN_H
+
+
+#include "tensorflowpredicttempocnn.h"
+
+namespace essentia {
+namespace streaming {
+
+// Same network as TensorflowPredictTempoCNN, with the model run by OnnxPredictTensor.
+class OnnxPredictTempoCNN : public TensorflowPredictTempoCNN {
+ protected:
+  Algorithm* createPredictor();
+  void configurePredictor();
+
+ public:
+  void declareParameters() {
+    declareParameter("graphFilename", "the name of the file from which to load the ONNX model", "", "");
+    declareParameter("input", "the name of the input of the ONNX model. It can be left empty for models with a single input", "", "");
+    declareParameter("output", "the name of the output of the ONNX model from which to retrieve the predictions. It can be left empty for models with a single output", "", "");
+    declareParameter("patchHopSize", "the number of frames between the beginnings of adjacent patches. 0 to avoid overlap", "[0,inf)", 128);
+    declareParameter("lastPatchMode", "what to do with the last frames: `repeat` them to fill the last patch or `discard` them", "{discard,repeat}", "discard");
+    declareParameter("batchSize", "number of patches to process in parallel. Use -1 or 0 to accumulate all the patches and run the model a single time at the end of the stream.", "[-1,inf)", 64);
+  }
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+
+};
+
+} // namespace streaming
+} // namespace essentia
+
+namespace essentia {
+namespace standard {
+
+class OnnxPredictTempoCNN : public TensorflowPredictTempoCNN {
+ public:
+  OnnxPredictTempoCNN() : TensorflowPredictTempoCNN("OnnxPredictTempoCNN") {}
+
+  void declareParameters() {
+    declareParameter("graphFilename", "the name of the file from which to load the ONNX model", "", "");
+    declareParameter("input", "the name of the input of the ONNX model. It can be left empty for models with a single input", "", "");
+    declareParameter("output", "the name of the output of the ONNX model from which to retrieve the predictions. It can be left empty for models with a single output", "", "");
+    declareParameter("patchHopSize", "number of frames between the beginnings of adjacent patches. 0 to avoid overlap", "[0,inf)", 128);
+    declareParameter("lastPatchMode", "what to do with the last frames: `repeat` them to fill the last patch or `discard` them", "{discard,repeat}", "discard");
+    declareParameter("batchSize", "number of patches to process in parallel. Use -1 or 0 to accumulate all the patches and run the model a single time at the end of the stream.", "[-1,inf)", 16);
+  }
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} // namespace standard
+} // namespace essentia
+
+#endif // ESSENTIA_ONNXPREDICTTEMPOCNN_H
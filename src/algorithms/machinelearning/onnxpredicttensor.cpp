@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "onnxpredicttensor.h"
+#include "algorithmfactory.h"
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+const char* OnnxPredictTensor::name = "OnnxPredictTensor";
+const char* OnnxPredictTensor::category = "Machine Learning";
+const char* OnnxPredictTensor::description = DOC("This algorithm runs an ONNX model on a stream of tensors and outputs the tensors of the given output.\n"
+"It works as OnnxPredict (see its documentation for the details of the parameters), with a single input and a single output, but without storing the tensors in pools: "
+"the memory of the input tensors is passed to ONNX Runtime without copying it, and the output tensors are written into reused buffers. "
+"This makes it the preferred way of running models inside streaming networks.");
+
+
+OnnxPredictTensor::OnnxPredictTensor() : Algorithm(), _inputData(1), _outputData(1) {
+  declareInput(_tensorIn, 1, "tensor", "the input tensor");
+  declareOutput(_tensorOut, 1, "tensor", "the tensor of the output");
+
+  _onnxPredict = static_cast<standard::OnnxPredict*>(
+      standard::AlgorithmFactory::create("OnnxPredict"));
+}
+
+
+OnnxPredictTensor::~OnnxPredictTensor() {
+  delete _onnxPredict;
+}
+
+
+void OnnxPredictTensor::configure() {
+  // Both algorithms share the same parameters.
+  _onnxPredict->Configurable::configure(_params);
+
+  // Without a model there are no inputs or outputs to check.
+  if (parameter("graphFilename").toString().empty()) return;
+
+  // Empty names stand for all the inputs or outputs of the model.
+  if (_onnxPredict->inputNames().size() != 1 || _onnxPredict->outputNames().size() != 1) {
+    throw EssentiaException("OnnxPredictTensor: only a single input and a single output are supported. "
+                            "Specify the ones to use with `inputs` and `outputs` when the model has several");
+  }
+}
+
+
+void OnnxPredictTensor::reset() {
+  Algorithm::reset();
+  _onnxPredict->reset();
+}
+
+
+AlgorithmStatus OnnxPredictTensor::process() {
+  EXEC_DEBUG("process()");
+  AlgorithmStatus status = acquireData();
+  EXEC_DEBUG("data acquired (in: " << _tensorIn.acquireSize()
+             << " - out: " << _tensorOut.acquireSize() << ")");
+
+  if (status != OK) {
+    return status;
+  }
+
+  const vector<Tensor<Real> >& tensorIn = _tensorIn.tokens();
+  vector<Tensor<Real> >& tensorOut = _tensorOut.tokens();
+
+  for (size_t i = 0; i < tensorIn.size(); i++) {
+    _inputData[0] = &tensorIn[i];
+
+    // Predict directly into the output token, whose memory is reused when the
+    // shape of the predictions does not change.
+    swap(_outputData[0], tensorOut[i]);
+    _onnxPredict->predict(_inputData, _outputData);
+    swap(_outputData[0], tensorOut[i]);
+  }
+
+  EXEC_DEBUG("releasing");
+  releaseData();
+  EXEC_DEBUG("released");
+
+  return OK;
+}
+
+} // namespace streaming
+} // namespace essentia
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_ONNXPREDICTTENSOR_H
+#define ESSENTIA_ONNXPREDICTTENSOR_H
+
+#include "streamingalgorithm.h"
+#include "onnxpredict.h"
+
+namespace essentia {
+namespace streaming {
+
+class OnnxPredictTensor : public Algorithm {
+ protected:
+  Sink<Tensor<Real> > _tensorIn;
+  Source<Tensor<Real> > _tensorOut;
+
+  standard::OnnxPredict* _onnxPredict;
+  std::vector<const Tensor<Real>*> _inputData;
+  std::vector<Tensor<Real> > _outputData;
+
+ public:
+  OnnxPredictTensor();
+  ~OnnxPredictTensor();
+
+  void declareParameters() {
+    declareParameter("graphFilename", "the name of the file from which to load the ONNX model", "", "");
+    declareParameter("inputs", "a list with the name of the input of the ONNX model. It can be left empty for models with a single input", "", std::vector<std::string>());
+    declareParameter("outputs", "a list with the name of the output of the ONNX model to retrieve. It can be left empty for models with a single output", "", std::vector<std::string>());
+    declareParameter("squeeze", "remove singleton dimensions of the inputs tensors. Does not apply to the batch dimension", "{true,false}", true);
+    declareParameter("shareModel", "share the loaded model and its session with the other instances configured with the same model and number of threads", "{true,false}", true);
+    declareParameter("intraOpThreads", "the number of threads used to run each ONNX operator (0 to let ONNX Runtime decide)", "[0,inf)", 0);
+    declareParameter("interOpThreads", "the number of ONNX operators that can run in parallel (0 to let ONNX Runtime decide)", "[0,inf)", 0);
+  }
+
+  void configure();
+  void reset();
+  AlgorithmStatus process();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_ONNXPREDICTTENSOR_H
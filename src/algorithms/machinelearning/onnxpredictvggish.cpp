@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "onnxpredictvggish.h"
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+const char* OnnxPredictVGGish::name = essentia::standard::OnnxPredictVGGish::name;
+const char* OnnxPredictVGGish::category = essentia::standard::OnnxPredictVGGish::category;
+const char* OnnxPredictVGGish::description = essentia::standard::OnnxPredictVGGish::description;
+
+
+Algorithm* OnnxPredictVGGish::createPredictor() {
+  return AlgorithmFactory::create("OnnxPredictTensor");
+}
+
+
+void OnnxPredictVGGish::configurePredictor() {
+  string input = parameter("input").toString();
+  string output = parameter("output").toString();
+
+  // Without names, OnnxPredictTensor takes the only input and output of the model.
+  vector<string> inputs, outputs;
+  if (!input.empty()) inputs.push_back(input);
+  if (!output.empty()) outputs.push_back(output);
+
+  _predictor->configure("graphFilename", parameter("graphFilename"),
+                        "inputs", inputs,
+                        "outputs", outputs);
+}
+
+} // namespace streaming
+} // namespace essentia
+
+
+
+namespace essentia {
+namespace standard {
+
+const char* OnnxPredictVGGish::name = "OnnxPredictVGGish";
+const char* OnnxPredictVGGish::category = "Machine Learning";
+const char* OnnxPredictVGGish::description = DOC(
+  "This algorithm makes predictions using VGGish-based models exported to the ONNX "
+  "format. It works as TensorflowPredictVGGish, but runs the models with ONNX "
+  "Runtime (see OnnxPredict), which is lighter and faster to load.\n"
+  "\n"
+  "Internally, it uses TensorflowInputVGGish for the input feature extraction "
+  "(mel bands). It feeds the model with patches of 96 mel bands frames and "
+  "jumps a constant amount of frames determined by `patchHopSize`.\n"
+  "\n"
+  "By setting the `batchSize` parameter to -1 or 0 the patches are stored to run a single "
+  "inference at the end of the stream. This allows to take advantage "
+  "of parallelization when GPUs are available, but at the same time it can be "
+  "memory exhausting for long files.\n"
+  "\n"
+  "The recommended pipeline is as follows::\n"
+  "\n"
+  "  MonoLoader(sampleRate=16000)         >> OnnxPredictVGGish\n"
+  "\n"
+  "Note: This algorithm does not make any check on the input model so it is "
+  "the user's responsibility to make sure it is a valid one.\n"
+  "\n"
+  "References:\n"
+  "\n"
+  "1. Gemmeke, J. et. al., AudioSet: An ontology and human-labelled dataset "
+  "for audio events, ICASSP 2017\n\n"
+  "2. Hershey, S. et. al., CNN Architectures for Large-Scale Audio "
+  "Classification, ICASSP 2017\n\n"
+  "3. Supported models at https://essentia.upf.edu/models/\n\n");
+
+} // namespace standard
+} // namespace essentia
@@ -51,8 +51,14 @@ const char* TensorflowPredict::description = DOC("This algorithm runs a Tensorfl
 "To print a list with all the available nodes in the graph set the first element of `outputs` as an empty string (i.e., \"\")."
 "\n"
 "This algorithm is a wrapper for the Tensorflow C API [3]. The first time it is configured with a non-empty `graphFilename` it will try to load the contained graph and to attach a Tensorflow session to it. "
-"The reset method deletes the current session (and the resources attached to it) and creates a new one relying on the available graph. "
-"By reconfiguring the algorithm the graph is reloaded and the reset method is called.\n"
+"By default (`shareModel`), the graph and its session are shared by all the instances of this algorithm in the process configured with the same model and number of threads, so that the model is only loaded once. "
+"Otherwise, each instance loads its own copy of the model and the reset method deletes the current session (and the resources attached to it) and creates a new one relying on the available graph. "
+"By reconfiguring the algorithm the graph is reloaded, unless the model is shared: shared instances reuse the graph already loaded by another instance alive with the same model and number of threads.\n"
+"\n"
+"When several instances sharing a model run it concurrently (e.g., processing different files in different threads), their inputs can be gathered into larger batches, which makes a better use of the hardware than many small ones. "
+"Set `dynamicBatchSize` to the maximum number of patches (i.e., elements of the batch dimension) per batch to enable it. "
+"Each call waits up to `dynamicBatchTimeout` seconds for the batch to fill before running it with the inputs available. "
+"Dynamic batching only applies to graphs with a single input and a single output, and is not suitable for models expecting a fixed batch size.\n"
 "\n"
 "References:\n"
 "  [1] TensorFlow - An open source machine learning library for research and production.\n"
@@ -87,6 +93,8 @@ void TensorflowPredict::configure() {
   _isTraining = parameter("isTraining").toBool();
   _isTrainingName = parameter("isTrainingName").toString();
   _squeeze = parameter("squeeze").toBool();
+  _dynamicBatchSize = parameter("dynamicBatchSize").toInt();
+  _dynamicBatchTimeout = parameter("dynamicBatchTimeout").toReal();
 
   (_isTrainingName == "") ? _isTrainingSet = false : _isTrainingSet = true;
 
@@ -100,13 +108,20 @@ void TensorflowPredict::configure() {
   _outputTensors.resize(_nOutputs);
   _outputNodes.resize(_nOutputs);
 
-  TF_DeleteGraph(_graph);
-  _graph = TF_NewGraph();
+  // Drop the previous model before loading the new one, so that it is not
+  // kept in memory twice when the same model is reloaded without sharing it.
+  _batcher.reset();
+  _model.reset();
+  _graph = NULL;
+  _isConfigured = false;
 
-  openGraph();
+  _model = TensorflowModel::load(_graphFilename, _savedModel, _tags,
+                                 parameter("intraOpThreads").toInt(),
+                                 parameter("interOpThreads").toInt(),
+                                 parameter("shareModel").toBool());
+  _graph = _model->graph();
 
   _isConfigured = true;
-  reset();
 
   // If the first output name is empty just print out the list of nodes and return.
   if (_outputNames[0] == "") {
@@ -140,115 +155,312 @@ void TensorflowPredict::configure() {
     _inputTensors[_nInputs] = isTraining;
     _inputNodes[_nInputs] = graphOperationByName(_isTrainingName);
   }
+
+  // Only the instances running the same nodes of a shared session can be
+  // batched together.
+  if (_dynamicBatchSize > 0) {
+    if (_nInputs != 1 || _nOutputs != 1) {
+      E_WARNING("TensorflowPredict: Dynamic batching is only supported for graphs with a single input and output. Disabling it.");
+    }
+    else if (!_model->isShared()) {
+      E_WARNING("TensorflowPredict: Dynamic batching requires sharing the model (`shareModel`). Disabling it.");
+    }
+    else {
+      string key = _inputNames[0] + "|" + _outputNames[0] + "|" + _isTrainingName +
+                   "|" + to_string(_isTraining) + "|" + to_string(_squeeze);
+      _batcher = _model->batcher(key);
+    }
+  }
 }
 
 
-void TensorflowPredict::openGraph() {
-  // Prioritize savedModel when both are specified.
-  if (!_savedModel.empty()) {
-    std::vector<char*> tags_c;
-    tags_c.reserve(_tags.size());
-    for (size_t i = 0; i < _tags.size(); i++) {
-      tags_c.push_back(const_cast<char*>(_tags[i].c_str()));
-    }
+SharedInstances<TensorflowModel> TensorflowModel::_sharedModels;
 
-    TF_LoadSessionFromSavedModel(_sessionOptions, _runOptions,
-      _savedModel.c_str(), &tags_c[0], (int)tags_c.size(),
-      _graph, NULL, _status);
 
-    if (TF_GetCode(_status) != TF_OK) {
-      throw EssentiaException("TensorflowPredict: Error importing SavedModel specified in the `savedModel` parameter. ", TF_Message(_status));
+// Appends a varint field of a protocol buffer message.
+static void appendVarintField(string& message, int field, uint64_t value) {
+  message += (char)(field << 3);
+  do {
+    char byte = (char)(value & 0x7F);
+    value >>= 7;
+    if (value) byte |= 0x80;
+    message += byte;
+  } while (value);
+}
+
+
+TensorflowModel::TensorflowModel(int intraOpThreads, int interOpThreads, bool shared) :
+    _graph(TF_NewGraph()), _sessionOptions(TF_NewSessionOptions()), _session(NULL),
+    _shared(shared) {
+  if (intraOpThreads > 0 || interOpThreads > 0) {
+    // The C API only takes the session configuration as a serialized
+    // ConfigProto, whose fields 2 and 5 are intra_op_parallelism_threads and
+    // inter_op_parallelism_threads.
+    string config;
+    if (intraOpThreads > 0) appendVarintField(config, 2, intraOpThreads);
+    if (interOpThreads > 0) appendVarintField(config, 5, interOpThreads);
+
+    TF_Status* status = TF_NewStatus();
+    TF_SetConfig(_sessionOptions, config.data(), config.size(), status);
+    bool ok = TF_GetCode(status) == TF_OK;
+    string message = TF_Message(status);
+    TF_DeleteStatus(status);
+
+    if (!ok) {
+      TF_DeleteSessionOptions(_sessionOptions);
+      TF_DeleteGraph(_graph);
+      throw EssentiaException("TensorflowPredict: Error setting the number of threads of the session. ", message);
     }
+  }
+}
 
-    E_INFO("TensorflowPredict: Successfully loaded SavedModel: `" << _savedModel << "`");
 
-    return;
+TensorflowModel::~TensorflowModel() {
+  TF_Status* status = TF_NewStatus();
+  if (_session) {
+    TF_CloseSession(_session, status);
+    TF_DeleteSession(_session, status);
   }
+  TF_DeleteSessionOptions(_sessionOptions);
+  TF_DeleteGraph(_graph);
+  TF_DeleteStatus(status);
+}
 
-  if (!_graphFilename.empty()) {
-    // First we load and initialize the model.
-    const auto f = fopen(_graphFilename.c_str(), "rb");
-    if (f == NULL) {
-      throw EssentiaException(
-          "TensorflowPredict: could not open the Tensorflow graph file.");
-    }
 
-    fseek(f, 0, SEEK_END);
-    const auto fsize = ftell(f);
-    fseek(f, 0, SEEK_SET);
+shared_ptr<TensorflowModel> TensorflowModel::load(const string& graphFilename,
+                                                  const string& savedModel,
+                                                  const vector<string>& tags,
+                                                  int intraOpThreads, int interOpThreads,
+                                                  bool shared) {
+  // Prioritize savedModel when both are specified.
+  string key;
+  if (!savedModel.empty()) {
+    key = "savedModel:" + savedModel;
+    for (size_t i = 0; i < tags.size(); i++) key += ":" + tags[i];
+  }
+  else {
+    key = "graph:" + graphFilename;
+  }
+  key += "|" + to_string(intraOpThreads) + "|" + to_string(interOpThreads);
+
+  SharedInstances<TensorflowModel>::Creator create = [&]() {
+    shared_ptr<TensorflowModel> model(new TensorflowModel(intraOpThreads, interOpThreads, shared));
+    if (!savedModel.empty()) model->loadSavedModel(savedModel, tags);
+    else model->loadGraph(graphFilename);
+    return model;
+  };
+
+  if (!shared) return create();
+
+  // Only the callers asking for the same model wait for each other, so that
+  // it is loaded once while unrelated models load at the same time.
+  return _sharedModels.get(key, create);
+}
+
+
+void TensorflowModel::loadSavedModel(const string& savedModel, const vector<string>& tags) {
+  std::vector<char*> tags_c;
+  tags_c.reserve(tags.size());
+  for (size_t i = 0; i < tags.size(); i++) {
+    tags_c.push_back(const_cast<char*>(tags[i].c_str()));
+  }
+
+  TF_Status* status = TF_NewStatus();
+  _session = TF_LoadSessionFromSavedModel(_sessionOptions, NULL,
+    savedModel.c_str(), &tags_c[0], (int)tags_c.size(),
+    _graph, NULL, status);
+
+  if (TF_GetCode(status) != TF_OK) {
+    string message = TF_Message(status);
+    TF_DeleteStatus(status);
+    throw EssentiaException("TensorflowPredict: Error importing SavedModel specified in the `savedModel` parameter. ", message);
+  }
+  TF_DeleteStatus(status);
+
+  E_INFO("TensorflowPredict: Successfully loaded SavedModel: `" << savedModel << "`");
+}
 
-    // Graph size sanity check.
-    if (fsize < 1) {
-      fclose(f);
-      throw(EssentiaException("TensorflowPredict: Graph file is empty."));
-    }
 
-    // Reserve memory and read the graph.
-    const auto data = malloc(fsize);
-    fread(data, fsize, 1, f);
+void TensorflowModel::loadGraph(const string& graphFilename) {
+  // First we load and initialize the model.
+  const auto f = fopen(graphFilename.c_str(), "rb");
+  if (f == NULL) {
+    throw EssentiaException(
+        "TensorflowPredict: could not open the Tensorflow graph file.");
+  }
+
+  fseek(f, 0, SEEK_END);
+  const auto fsize = ftell(f);
+  fseek(f, 0, SEEK_SET);
+
+  // Graph size sanity check.
+  if (fsize < 1) {
     fclose(f);
+    throw(EssentiaException("TensorflowPredict: Graph file is empty."));
+  }
 
-    TF_Buffer* buffer = TF_NewBuffer();
-    buffer->data = data;
-    buffer->length = fsize;
-    buffer->data_deallocator = DeallocateBuffer;
+  // Reserve memory and read the graph.
+  const auto data = malloc(fsize);
+  fread(data, fsize, 1, f);
+  fclose(f);
 
-    TF_GraphImportGraphDef(_graph, buffer, _options, _status);
+  TF_Buffer* buffer = TF_NewBuffer();
+  buffer->data = data;
+  buffer->length = fsize;
+  buffer->data_deallocator = DeallocateBuffer;
 
-    TF_DeleteBuffer(buffer);
+  TF_Status* status = TF_NewStatus();
+  TF_ImportGraphDefOptions* options = TF_NewImportGraphDefOptions();
+  TF_GraphImportGraphDef(_graph, buffer, options, status);
 
-    if (TF_GetCode(_status) != TF_OK) {
-      throw EssentiaException("TensorflowPredict: Error importing graph. ", TF_Message(_status));
-    }
+  TF_DeleteImportGraphDefOptions(options);
+  TF_DeleteBuffer(buffer);
 
-    E_INFO("TensorflowPredict: Successfully loaded graph file: `" << _graphFilename << "`");
+  if (TF_GetCode(status) != TF_OK) {
+    string message = TF_Message(status);
+    TF_DeleteStatus(status);
+    throw EssentiaException("TensorflowPredict: Error importing graph. ", message);
   }
+
+  _session = TF_NewSession(_graph, _sessionOptions, status);
+  if (TF_GetCode(status) != TF_OK) {
+    string message = TF_Message(status);
+    TF_DeleteStatus(status);
+    throw EssentiaException("TensorflowPredict: Error creating the session. ", message);
+  }
+  TF_DeleteStatus(status);
+
+  E_INFO("TensorflowPredict: Successfully loaded graph file: `" << graphFilename << "`");
 }
 
 
-void TensorflowPredict::reset() {
-  if (!_isConfigured) return;
+shared_ptr<TensorflowBatcher> TensorflowModel::batcher(const string& key) {
+  ForcedMutexLocker lock(_batchersMutex);
 
-  TF_CloseSession(_session, _status);
-  if (TF_GetCode(_status) != TF_OK) {
-    throw EssentiaException("TensorflowPredict: Error closing session. ", TF_Message(_status));
+  shared_ptr<TensorflowBatcher>& batcher = _batchers[key];
+  if (!batcher) batcher.reset(new TensorflowBatcher());
+  return batcher;
+}
+
+
+void TensorflowModel::resetSession() {
+  TF_Status* status = TF_NewStatus();
+
+  TF_CloseSession(_session, status);
+  if (TF_GetCode(status) != TF_OK) {
+    string message = TF_Message(status);
+    TF_DeleteStatus(status);
+    throw EssentiaException("TensorflowPredict: Error closing session. ", message);
   }
 
-  TF_DeleteSession(_session, _status);
-  if (TF_GetCode(_status) != TF_OK) {
-    throw EssentiaException("TensorflowPredict: Error deleting session. ", TF_Message(_status));
+  TF_DeleteSession(_session, status);
+  _session = NULL;
+  if (TF_GetCode(status) != TF_OK) {
+    string message = TF_Message(status);
+    TF_DeleteStatus(status);
+    throw EssentiaException("TensorflowPredict: Error deleting session. ", message);
   }
 
-  _session = TF_NewSession(_graph, _sessionOptions, _status);
-  if (TF_GetCode(_status) != TF_OK) {
-    throw EssentiaException("TensorflowPredict: Error creating new session after reset. ", TF_Message(_status));
+  _session = TF_NewSession(_graph, _sessionOptions, status);
+  if (TF_GetCode(status) != TF_OK) {
+    string message = TF_Message(status);
+    TF_DeleteStatus(status);
+    throw EssentiaException("TensorflowPredict: Error creating new session after reset. ", message);
   }
+  TF_DeleteStatus(status);
+}
+
+
+void TensorflowPredict::reset() {
+  if (!_isConfigured) return;
+
+  // A shared session may be in use by other instances. Sessions running
+  // inference graphs do not keep any state between runs anyway.
+  if (_model->isShared()) return;
+
+  _model->resetSession();
 }
 
 
 void TensorflowPredict::compute() {
+  const Pool& poolIn = _poolIn.get();
+  Pool& poolOut = _poolOut.get();
+
+  // The input tensors are passed from the pool to TensorFlow without copies.
+  _inputData.resize(_nInputs);
+  for (size_t i = 0; i < _nInputs; i++) {
+    _inputData[i] = &poolIn.value<Tensor<Real> >(_inputNames[i]);
+  }
+
+  predict(_inputData, _outputData);
+
+  // Copy the desired tensors into the output pool.
+  for (size_t i = 0; i < _nOutputs; i++) {
+    poolOut.set(_outputNames[i], _outputData[i]);
+  }
+}
+
+
+void TensorflowPredict::predict(const vector<const Tensor<Real>*>& inputs,
+                                vector<Tensor<Real> >& outputs) {
   if (!_isConfigured) {
     throw EssentiaException("TensorflowPredict: This algorithm is not configured. To configure this algorithm you "
                             "should specify a valid `graphFilename` or `savedModel` as input parameter.");
   }
 
-  const Pool& poolIn = _poolIn.get();
-  Pool& poolOut = _poolOut.get();
+  if (inputs.size() != _nInputs) {
+    throw EssentiaException("TensorflowPredict: Expected ", _nInputs, " input tensors but got ", inputs.size());
+  }
+
+  if (!_batcher) {
+    run(inputs, outputs);
+    return;
+  }
 
-  // Parse the input tensors from the pool into Tensorflow tensors.
+  // The batch may be run by this instance or by any other one sharing the
+  // batcher, so the inputs are given to the batcher along with the way to
+  // run them from here.
+  outputs.resize(1);
+  _batcher->predict(*inputs[0], outputs[0], _dynamicBatchSize, _dynamicBatchTimeout,
+                    std::bind(&TensorflowPredict::runBatch, this,
+                              std::placeholders::_1, std::placeholders::_2));
+}
+
+
+void TensorflowPredict::runBatch(const Tensor<Real>& input, Tensor<Real>& output) {
+  vector<const Tensor<Real>*> inputs(1, &input);
+  vector<Tensor<Real> > outputs(1);
+
+  swap(outputs[0], output);
+  run(inputs, outputs);
+  swap(outputs[0], output);
+}
+
+
+void TensorflowPredict::run(const vector<const Tensor<Real>*>& inputs,
+                            vector<Tensor<Real> >& outputs) {
+  // Initialize the tensors so that only the ones allocated are deleted on errors.
   for (size_t i = 0; i < _nInputs; i++) {
-    const Tensor<Real>& inputData =
-        poolIn.value<Tensor<Real> >(_inputNames[i]);
-    _inputTensors[i] = TensorToTF(inputData);
+    _inputTensors[i] = NULL;
   }
 
-  // Initialize output tensors.
   for (size_t i = 0; i < _nOutputs; i++) {
     _outputTensors[i] = NULL;
   }
 
+  // Wrap the input tensors into Tensorflow tensors.
+  try {
+    for (size_t i = 0; i < _nInputs; i++) {
+      _inputTensors[i] = TensorToTF(*inputs[i]);
+    }
+  }
+  catch (EssentiaException&) {
+    deleteTensors();
+    throw;
+  }
+
   // Run the Tensorflow session.
-  TF_SessionRun(_session,
+  TF_SessionRun(_model->session(),
                 NULL,                            // Run options.
                 &_inputNodes[0],                 // Input node names.
                 &_inputTensors[0],               // input tensor values.
@@ -262,25 +474,158 @@ void TensorflowPredict::compute() {
                );
 
   if (TF_GetCode(_status) != TF_OK) {
+    deleteTensors();
     throw EssentiaException("TensorflowPredict: Error running the Tensorflow session. ", TF_Message(_status));
   }
 
-  // Copy the desired tensors into the output pool.
-  for (size_t i = 0; i < _nOutputs; i++) {
-    poolOut.set(_outputNames[i], TFToTensor(_outputTensors[i], _outputNodes[i]));
+  // Copy the desired tensors into the output buffers.
+  outputs.resize(_nOutputs);
+  try {
+    for (size_t i = 0; i < _nOutputs; i++) {
+      TFToTensor(_outputTensors[i], _outputNodes[i], outputs[i]);
+    }
   }
+  catch (EssentiaException&) {
+    deleteTensors();
+    throw;
+  }
+
+  deleteTensors();
+}
+
 
-  // Deallocate tensors.
+void TensorflowPredict::deleteTensors() {
+  // The isTraining flag is kept for all the runs.
   for (size_t i = 0; i < _nInputs; i++) {
-    TF_DeleteTensor(_inputTensors[i]);
+    if (_inputTensors[i]) TF_DeleteTensor(_inputTensors[i]);
+    _inputTensors[i] = NULL;
   }
 
   for (size_t i = 0; i < _nOutputs; i++) {
-    TF_DeleteTensor(_outputTensors[i]);
+    if (_outputTensors[i]) TF_DeleteTensor(_outputTensors[i]);
+    _outputTensors[i] = NULL;
   }
 }
 
 
+void TensorflowBatcher::predict(const Tensor<Real>& input, Tensor<Real>& output,
+                                int maxBatchSize, Real timeout, const Runner& run) {
+  Request request = { &input, &output, false, exception_ptr() };
+
+  unique_lock<ForcedMutex> lock(_mutex);
+  _pending.push_back(&request);
+  _pendingPatches += (int)input.dimension(0);
+
+  // Let the leader know in case the batch is full now.
+  _condition.notify_all();
+
+  while (!request.done) {
+    if (_hasLeader) {
+      _condition.wait(lock);
+      continue;
+    }
+
+    // Nobody is running the pending requests, so lead the next batch.
+    _hasLeader = true;
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::now() +
+      chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(timeout));
+    _condition.wait_until(lock, deadline, [&]() { return _pendingPatches >= maxBatchSize; });
+
+    // Take the oldest requests that fit in the batch and have the same
+    // non-batch dimensions than the first one. At least one request is taken
+    // even if it is larger than the batch.
+    vector<Request*> batch;
+    int patches = 0;
+    const Tensor<Real>& first = *_pending[0]->input;
+
+    for (vector<Request*>::iterator it = _pending.begin(); it != _pending.end();) {
+      const Tensor<Real>& tensor = *(*it)->input;
+      int n = (int)tensor.dimension(0);
+
+      bool sameShape = true;
+      for (int i = 1; i < tensor.rank(); i++) {
+        if (tensor.dimension(i) != first.dimension(i)) sameShape = false;
+      }
+
+      if (sameShape && (batch.empty() || patches + n <= maxBatchSize)) {
+        batch.push_back(*it);
+        patches += n;
+        _pendingPatches -= n;
+        it = _pending.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+
+    lock.unlock();
+    runBatch(batch, run);
+    lock.lock();
+
+    for (size_t i = 0; i < batch.size(); i++) batch[i]->done = true;
+    _hasLeader = false;
+    _condition.notify_all();
+  }
+
+  if (request.error) rethrow_exception(request.error);
+}
+
+
+void TensorflowBatcher::runBatch(const vector<Request*>& batch, const Runner& run) {
+  try {
+    if (batch.size() == 1) {
+      run(*batch[0]->input, *batch[0]->output);
+      return;
+    }
+
+    // Concatenate the inputs along the batch dimension.
+    const Tensor<Real>& first = *batch[0]->input;
+    int patches = 0;
+    for (size_t i = 0; i < batch.size(); i++) {
+      patches += (int)batch[i]->input->dimension(0);
+    }
+
+    array<long int, 4> shape = {patches, (long int)first.dimension(1),
+                                (long int)first.dimension(2), (long int)first.dimension(3)};
+    if (_input.dimensions() != shape) _input.resize(shape);
+
+    Real* dst = _input.data();
+    for (size_t i = 0; i < batch.size(); i++) {
+      const Tensor<Real>& tensor = *batch[i]->input;
+      memcpy(dst, tensor.data(), tensor.size() * sizeof(Real));
+      dst += tensor.size();
+    }
+
+    run(_input, _output);
+
+    if (_output.dimension(0) != patches) {
+      throw EssentiaException("TensorflowPredict: Dynamic batching requires the output tensor to have the same batch size as the input one, "
+                              "but got ", _output.dimension(0), " patches");
+    }
+
+    // Hand each request its part of the output.
+    const Real* src = _output.data();
+    long int patchSize = _output.size() / patches;
+    for (size_t i = 0; i < batch.size(); i++) {
+      Tensor<Real>& tensor = *batch[i]->output;
+      array<long int, 4> outShape = {batch[i]->input->dimension(0), _output.dimension(1),
+                                     _output.dimension(2), _output.dimension(3)};
+      if (tensor.dimensions() != outShape) tensor.resize(outShape);
+
+      memcpy(tensor.data(), src, tensor.size() * sizeof(Real));
+      src += outShape[0] * patchSize;
+    }
+  }
+  catch (...) {
+    for (size_t i = 0; i < batch.size(); i++) batch[i]->error = current_exception();
+  }
+}
+
+
+// The memory of the input tensors belongs to Essentia.
+static void NoDeallocate(void*, size_t, void*) {}
+
+
 TF_Tensor* TensorflowPredict::TensorToTF(
     const Tensor<Real>& tensorIn) {
   int dims = 1;
@@ -310,32 +655,25 @@ TF_Tensor* TensorflowPredict::TensorToTF(
       }
   }
 
-  TF_Tensor* tensorOut = TF_AllocateTensor(
+  // Squeezing does not change the layout of the data, so the Tensorflow tensor
+  // can point to the memory of the Essentia tensor. Note that Tensorflow still
+  // makes an aligned copy of it when the data is not aligned as it expects.
+  TF_Tensor* tensorOut = TF_NewTensor(
       TF_FLOAT, &shape[0], dims,
-      (size_t)tensorIn.size() * sizeof(Real));
+      const_cast<Real*>(tensorIn.data()),
+      (size_t)tensorIn.size() * sizeof(Real),
+      NoDeallocate, NULL);
 
   if (tensorOut == NULL) {
     throw EssentiaException("TensorflowPredict: Error generating input tensor.");
   }
 
-  // Get a pointer to the data and fill the tensor.
-  void* tensorData = TF_TensorData(tensorOut);
-
-  if (tensorData == NULL) {
-    TF_DeleteTensor(tensorOut);
-    throw EssentiaException("TensorflowPredict: Error generating input tensors data.");
-  }
-
-  memcpy(tensorData, tensorIn.data(),
-         std::min(tensorIn.size() * sizeof(Real),
-                  TF_TensorByteSize(tensorOut)));
-
   return tensorOut;
 }
 
 
-const Tensor<Real> TensorflowPredict::TFToTensor(
-    const TF_Tensor* tensor, TF_Output node) {
+void TensorflowPredict::TFToTensor(
+    const TF_Tensor* tensor, TF_Output node, Tensor<Real>& tensorOut) {
   const Real* outputData = static_cast<Real*>(TF_TensorData(tensor));
 
   // Get the output tensor's shape.
@@ -358,8 +696,15 @@ const Tensor<Real> TensorflowPredict::TFToTensor(
     shape[i] = (int)TF_Dim(tensor, idx);
   }
 
-  // Return a const reference to the data in Eigen format.
-  return TensorMap<const Real>(outputData, shape);
+  // Reuse the memory of the output tensor when the shape did not change.
+  bool sameShape = true;
+  for (int i = 0; i < tensorOut.rank(); i++) {
+    if (tensorOut.dimension(i) != shape[i]) sameShape = false;
+  }
+  if (!sameShape) tensorOut.resize(shape);
+
+  memcpy(tensorOut.data(), outputData,
+         std::min(tensorOut.size() * sizeof(Real), TF_TensorByteSize(tensor)));
 }
 
 
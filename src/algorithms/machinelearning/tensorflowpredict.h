@@ -20,12 +20,112 @@
 #ifndef ESSENTIA_TENSORFLOWPREDICT_H
 #define ESSENTIA_TENSORFLOWPREDICT_H
 
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
 #include "algorithm.h"
 #include "pool.h"
+#include "threading.h"
+#include "sharedinstances.h"
 #include <tensorflow/c/c_api.h>
 
 
 namespace essentia {
+
+/**
+ * Gathers the tensors given by concurrent callers into larger batches.
+ *
+ * The first caller to arrive becomes the leader: it waits until enough
+ * patches (i.e., elements of the batch dimension) have been given to fill a
+ * batch, or until the timeout expires, runs the batch on behalf of all the
+ * callers in it, and hands each of them the rows of the output corresponding
+ * to their input. Tensors whose non-batch dimensions differ from the ones of
+ * the batch are left for the next one.
+ */
+class TensorflowBatcher {
+ public:
+  typedef std::function<void(const Tensor<Real>&, Tensor<Real>&)> Runner;
+
+  TensorflowBatcher() : _pendingPatches(0), _hasLeader(false) {}
+
+  void predict(const Tensor<Real>& input, Tensor<Real>& output,
+               int maxBatchSize, Real timeout, const Runner& run);
+
+ protected:
+  struct Request {
+    const Tensor<Real>* input;
+    Tensor<Real>* output;
+    bool done;
+    std::exception_ptr error;
+  };
+
+  void runBatch(const std::vector<Request*>& batch, const Runner& run);
+
+  // only used by the leader
+  Tensor<Real> _input;
+  Tensor<Real> _output;
+
+  ForcedMutex _mutex;
+  std::condition_variable_any _condition;
+  std::vector<Request*> _pending;
+  int _pendingPatches;
+  bool _hasLeader;
+};
+
+
+/**
+ * A TensorFlow graph and the session running it.
+ *
+ * Shared models are loaded only once per process: all the callers asking for
+ * the same model file with the same session options get the same instance,
+ * which is released when the last of them drops it. This is possible because
+ * the TensorFlow sessions allow concurrent calls to TF_SessionRun.
+ */
+class TensorflowModel {
+ public:
+  static std::shared_ptr<TensorflowModel> load(const std::string& graphFilename,
+                                               const std::string& savedModel,
+                                               const std::vector<std::string>& tags,
+                                               int intraOpThreads, int interOpThreads,
+                                               bool shared);
+  ~TensorflowModel();
+
+  TF_Graph* graph() const { return _graph; }
+  TF_Session* session() const { return _session; }
+  bool isShared() const { return _shared; }
+
+  /**
+   * Replaces the session with a new one, releasing the resources attached to
+   * it. This must not be called on shared models.
+   */
+  void resetSession();
+
+  /**
+   * @returns the batcher shared by the callers running the graph with the
+   *          same configuration (e.g., the same input and output nodes),
+   *          identified by @c key
+   */
+  std::shared_ptr<TensorflowBatcher> batcher(const std::string& key);
+
+ protected:
+  TensorflowModel(int intraOpThreads, int interOpThreads, bool shared);
+
+  void loadGraph(const std::string& graphFilename);
+  void loadSavedModel(const std::string& savedModel, const std::vector<std::string>& tags);
+
+  TF_Graph* _graph;
+  TF_SessionOptions* _sessionOptions;
+  TF_Session* _session;
+  bool _shared;
+
+  std::map<std::string, std::shared_ptr<TensorflowBatcher> > _batchers;
+  ForcedMutex _batchersMutex;
+
+  static SharedInstances<TensorflowModel> _sharedModels;
+};
+
+
 namespace standard {
 
 class TensorflowPredict : public Algorithm {
@@ -47,15 +147,16 @@ class TensorflowPredict : public Algorithm {
   size_t _nInputs;
   size_t _nOutputs;
 
+  std::shared_ptr<TensorflowModel> _model;
   TF_Graph* _graph;
   TF_Status* _status;
-  TF_ImportGraphDefOptions* _options;
-  TF_SessionOptions* _sessionOptions;
-  TF_Session* _session;
+
+  std::shared_ptr<TensorflowBatcher> _batcher;
+  int _dynamicBatchSize;
+  Real _dynamicBatchTimeout;
 
   std::string _savedModel;
   std::vector<std::string> _tags;
-  TF_Buffer* _runOptions;
 
   bool _isTraining;
   bool _isTrainingSet;
@@ -65,9 +166,15 @@ class TensorflowPredict : public Algorithm {
 
   bool _isConfigured;
 
-  void openGraph();
+  std::vector<const Tensor<Real>*> _inputData;
+  std::vector<Tensor<Real> > _outputData;
+
+  void run(const std::vector<const Tensor<Real>*>& inputs,
+           std::vector<Tensor<Real> >& outputs);
+  void runBatch(const Tensor<Real>& input, Tensor<Real>& output);
   TF_Tensor* TensorToTF(const Tensor<Real>& tensorIn);
-  const Tensor<Real> TFToTensor(const TF_Tensor* tensor, TF_Output node);
+  void TFToTensor(const TF_Tensor* tensor, TF_Output node, Tensor<Real>& tensorOut);
+  void deleteTensors();
   TF_Output graphOperationByName(const std::string nodeName);
   std::vector<std::string> nodeNames();
 
@@ -79,22 +186,14 @@ class TensorflowPredict : public Algorithm {
   }
 
  public:
-  TensorflowPredict() : _graph(TF_NewGraph()), _status(TF_NewStatus()),
-      _options(TF_NewImportGraphDefOptions()), _sessionOptions(TF_NewSessionOptions()),
-      _session(TF_NewSession(_graph, _sessionOptions, _status)), _runOptions(NULL),
-      _isConfigured(false) {
+  TensorflowPredict() : _graph(NULL), _status(TF_NewStatus()),
+      _dynamicBatchSize(0), _dynamicBatchTimeout(0), _isConfigured(false) {
     declareInput(_poolIn, "poolIn", "the pool where to get the feature tensors");
     declareOutput(_poolOut, "poolOut", "the pool where to store the output tensors");
   }
 
   ~TensorflowPredict(){
-    TF_CloseSession(_session, _status);
-    TF_DeleteSessionOptions(_sessionOptions);
-    TF_DeleteSession(_session, _status);
-    TF_DeleteImportGraphDefOptions(_options);
     TF_DeleteStatus(_status);
-    TF_DeleteGraph(_graph);
-    TF_DeleteBuffer(_runOptions);
   }
 
   void declareParameters() {
@@ -109,12 +208,29 @@ class TensorflowPredict : public Algorithm {
     declareParameter("isTraining", "run the model in training mode (normalized with statistics of the current batch) instead of inference mode (normalized with moving statistics). This only applies to some models", "{true,false}", false);
     declareParameter("isTrainingName", "the name of an additional input node indicating whether the model is to be run in a training mode (for models with a training mode, leave it empty otherwise)", "", "");
     declareParameter("squeeze", "remove singleton dimensions of the inputs tensors. Does not apply to the batch dimension", "{true,false}", true);
+    declareParameter("shareModel", "share the loaded model and its session with the other instances of this algorithm configured with the same model and number of threads", "{true,false}", true);
+    declareParameter("intraOpThreads", "the number of threads used to run each TensorFlow operation (0 to let TensorFlow decide)", "[0,inf)", 0);
+    declareParameter("interOpThreads", "the number of TensorFlow operations that can run in parallel (0 to let TensorFlow decide)", "[0,inf)", 0);
+    declareParameter("dynamicBatchSize", "the maximum number of patches of the instances sharing the model (see `shareModel`) that are gathered into a single batch. Only applies to graphs with a single input and output. Set it to 0 to run the batches as they come", "[0,inf)", 0);
+    declareParameter("dynamicBatchTimeout", "the maximum time to wait for other instances to fill a dynamic batch [s]", "[0,inf)", 0.01);
   }
 
   void configure();
   void compute();
   void reset();
 
+  /**
+   * Runs the graph on the given tensors (one for each of the `inputs` nodes)
+   * and stores the tensors of the `outputs` nodes in @c outputs. The input
+   * tensors are passed to TensorFlow without copying them, so they must stay
+   * alive and unmodified until this method returns, and the output tensors
+   * are only reallocated when their shape changes from the previous call.
+   * With `dynamicBatchSize`, the inputs may be run in the same batch as the
+   * ones of other instances calling this method concurrently.
+   */
+  void predict(const std::vector<const Tensor<Real>*>& inputs,
+               std::vector<Tensor<Real> >& outputs);
+
   static const char* name;
   static const char* category;
   static const char* description;
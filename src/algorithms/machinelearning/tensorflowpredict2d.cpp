@@ -32,7 +32,7 @@ const char* TensorflowPredict2D::description = essentia::standard::TensorflowPre
 
 
 TensorflowPredict2D::TensorflowPredict2D() : AlgorithmComposite(),
-    _vectorRealToTensor(0), _tensorToPool(0), _tensorflowPredict(0), _poolToTensor(0),
+    _vectorRealToTensor(0), _tensorflowPredict(0),
     _tensorToVectorReal(0), _configured(false) {
 
   declareInput(_features, 4096, "features", "the input features");
@@ -44,18 +44,14 @@ void TensorflowPredict2D::createInnerNetwork() {
   AlgorithmFactory& factory = AlgorithmFactory::instance();
 
   _vectorRealToTensor     = factory.create("VectorRealToTensor");
-  _tensorToPool           = factory.create("TensorToPool");
-  _tensorflowPredict      = factory.create("TensorflowPredict");
-  _poolToTensor           = factory.create("PoolToTensor");
+  _tensorflowPredict      = factory.create("TensorflowPredictTensor");
   _tensorToVectorReal     = factory.create("TensorToVectorReal");
 
   // _tensorflowInput2D->output("bands").setBufferType(BufferUsage::forMultipleFrames);
 
   _features >> _vectorRealToTensor->input("frame");
-  _vectorRealToTensor->output("tensor") >> _tensorToPool->input("tensor");
-  _tensorToPool->output("pool") >> _tensorflowPredict->input("poolIn");
-  _tensorflowPredict->output("poolOut") >> _poolToTensor->input("pool");
-  _poolToTensor->output("tensor") >> _tensorToVectorReal->input("tensor");
+  _vectorRealToTensor->output("tensor") >> _tensorflowPredict->input("tensor");
+  _tensorflowPredict->output("tensor") >> _tensorToVectorReal->input("tensor");
 
   attach(_tensorToVectorReal->output("frame"), _predictions);
 
@@ -107,10 +103,6 @@ void TensorflowPredict2D::configure() {
   string output = parameter("output").toString();
   string isTrainingName = parameter("isTrainingName").toString();
 
-  _tensorToPool->configure("namespace", input);
-
-  _poolToTensor->configure("namespace", output);
-
   string graphFilename = parameter("graphFilename").toString();
   string savedModel = parameter("savedModel").toString();
 
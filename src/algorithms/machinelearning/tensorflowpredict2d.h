@@ -33,9 +33,7 @@ namespace streaming {
 class TensorflowPredict2D : public AlgorithmComposite {
  protected:
   Algorithm* _vectorRealToTensor;
-  Algorithm* _tensorToPool;
   Algorithm* _tensorflowPredict;
-  Algorithm* _poolToTensor;
   Algorithm* _tensorToVectorReal;
 
   SinkProxy<std::vector<Real> > _features;
@@ -30,8 +30,8 @@ const char* TensorflowPredictCREPE::description = essentia::standard::Tensorflow
 
 
 TensorflowPredictCREPE::TensorflowPredictCREPE() : AlgorithmComposite(),
-    _frameCutter(0), _vectorRealToTensor(0), _tensorNormalize(0), _tensorToPool(0),
-    _tensorflowPredict(0), _poolToTensor(0), _tensorToVectorReal(0), _configured(false) {
+    _frameCutter(0), _vectorRealToTensor(0), _tensorNormalize(0),
+    _predictor(0), _tensorToVectorReal(0), _configured(false) {
 
   declareInput(_signal, 4096, "signal", "the input audio signal sampled at 16 kHz");
   declareOutput(_predictions, 0, "predictions", "the output values from the model node named after `output`");
@@ -44,18 +44,14 @@ void TensorflowPredictCREPE::createInnerNetwork() {
   _frameCutter            = factory.create("FrameCutter");
   _vectorRealToTensor     = factory.create("VectorRealToTensor");
   _tensorNormalize        = factory.create("TensorNormalize");
-  _tensorToPool           = factory.create("TensorToPool");
-  _tensorflowPredict      = factory.create("TensorflowPredict");
-  _poolToTensor           = factory.create("PoolToTensor");
+  _predictor              = createPredictor();
   _tensorToVectorReal     = factory.create("TensorToVectorReal");
 
   _signal                                  >> _frameCutter->input("signal");
   _frameCutter->output("frame")            >> _vectorRealToTensor->input("frame");
   _vectorRealToTensor->output("tensor")    >> _tensorNormalize->input("tensor");
-  _tensorNormalize->output("tensor")       >> _tensorToPool->input("tensor");
-  _tensorToPool->output("pool")            >> _tensorflowPredict->input("poolIn");
-  _tensorflowPredict->output("poolOut")    >> _poolToTensor->input("pool");
-  _poolToTensor->output("tensor")          >> _tensorToVectorReal->input("tensor");
+  _tensorNormalize->output("tensor")       >> _predictor->input("tensor");
+  _predictor->output("tensor")             >> _tensorToVectorReal->input("tensor");
 
   attach(_tensorToVectorReal->output("frame"), _predictions);
 
@@ -110,21 +106,26 @@ void TensorflowPredictCREPE::configure() {
 
   _configured = true;
 
-  string input = parameter("input").toString();
-  string output = parameter("output").toString();
+  configurePredictor();
+}
 
-  _tensorToPool->configure("namespace", input);
 
-  _poolToTensor->configure("namespace", output);
+Algorithm* TensorflowPredictCREPE::createPredictor() {
+  return AlgorithmFactory::create("TensorflowPredictTensor");
+}
+
 
+void TensorflowPredictCREPE::configurePredictor() {
+  string input = parameter("input").toString();
+  string output = parameter("output").toString();
 
   string graphFilename = parameter("graphFilename").toString();
   string savedModel = parameter("savedModel").toString();
 
-  _tensorflowPredict->configure("graphFilename", graphFilename,
-                                "savedModel", savedModel,
-                                "inputs", vector<string>({input}),
-                                "outputs", vector<string>({output}));
+  _predictor->configure("graphFilename", graphFilename,
+                        "savedModel", savedModel,
+                        "inputs", vector<string>({input}),
+                        "outputs", vector<string>({output}));
 }
 
 } // namespace streaming
@@ -168,11 +169,15 @@ const char* TensorflowPredictCREPE::description = DOC(
   "3. Supported models at https://essentia.upf.edu/models/\n\n");
 
 
-TensorflowPredictCREPE::TensorflowPredictCREPE() {
+TensorflowPredictCREPE::TensorflowPredictCREPE()
+    : TensorflowPredictCREPE("TensorflowPredictCREPE") {}
+
+
+TensorflowPredictCREPE::TensorflowPredictCREPE(const char* streamingName) {
     declareInput(_signal, "signal", "the input audio signal sampled at 16 kHz");
     declareOutput(_predictions, "predictions", "the output values from the model node named after `output`");
 
-    createInnerNetwork();
+    createInnerNetwork(streamingName);
   }
 
 
@@ -181,24 +186,20 @@ TensorflowPredictCREPE::~TensorflowPredictCREPE() {
 }
 
 
-void TensorflowPredictCREPE::createInnerNetwork() {
-  _tensorflowPredictCREPE = streaming::AlgorithmFactory::create("TensorflowPredictCREPE");
+void TensorflowPredictCREPE::createInnerNetwork(const char* streamingName) {
+  _predictCREPE = streaming::AlgorithmFactory::create(streamingName);
   _vectorInput = new streaming::VectorInput<Real>();
 
-  *_vectorInput >> _tensorflowPredictCREPE->input("signal");
-  _tensorflowPredictCREPE->output("predictions") >> PC(_pool, "predictions");
+  *_vectorInput >> _predictCREPE->input("signal");
+  _predictCREPE->output("predictions") >> PC(_pool, "predictions");
 
   _network = new scheduler::Network(_vectorInput);
 }
 
 
 void TensorflowPredictCREPE::configure() {
-  _tensorflowPredictCREPE->configure(INHERIT("graphFilename"),
-                                     INHERIT("savedModel"),
-                                     INHERIT("input"),
-                                     INHERIT("output"),
-                                     INHERIT("hopSize"),
-                                     INHERIT("batchSize"));
+  // The streaming algorithm takes the same parameters.
+  _predictCREPE->configure(_params);
 }
 
 
@@ -207,7 +208,7 @@ void TensorflowPredictCREPE::compute() {
   vector<vector<Real> >& predictions = _predictions.get();
 
   if (!signal.size()) {
-    throw EssentiaException("TensorflowPredictCREPE: empty input signal");
+    throw EssentiaException(Configurable::name(), ": empty input signal");
   }
 
   _vectorInput->setVector(&signal);
@@ -34,9 +34,7 @@ class TensorflowPredictCREPE : public AlgorithmComposite {
   Algorithm* _frameCutter;
   Algorithm* _vectorRealToTensor;
   Algorithm* _tensorNormalize;
-  Algorithm* _tensorToPool;
-  Algorithm* _tensorflowPredict;
-  Algorithm* _poolToTensor;
+  Algorithm* _predictor;
   Algorithm* _tensorToVectorReal;
 
   SinkProxy<Real> _signal;
@@ -48,6 +46,11 @@ class TensorflowPredictCREPE : public AlgorithmComposite {
   void createInnerNetwork();
   void clearAlgos();
 
+  // The model is run by TensorflowPredictTensor. The wrappers of the same
+  // models for other backends override these (see OnnxPredictCREPE).
+  virtual Algorithm* createPredictor();
+  virtual void configurePredictor();
+
   // Hardcoded parameters matching the training setup:
   // https://github.com/marl/crepe/blob/a666a03011a9cdab70e9abd0b5009ad60c5f8926/crepe/core.py#L200
   const float _sampleRate = 16000;
@@ -96,12 +99,15 @@ class TensorflowPredictCREPE : public Algorithm {
   Input<std::vector<Real> > _signal;
   Output<std::vector<std::vector<Real> > > _predictions;
 
-  streaming::Algorithm* _tensorflowPredictCREPE;
+  streaming::Algorithm* _predictCREPE;
   streaming::VectorInput<Real>* _vectorInput;
   scheduler::Network* _network;
   Pool _pool;
 
-  void createInnerNetwork();
+  // Wraps the streaming algorithm named @c streamingName, which is the one
+  // with the same name unless for the wrappers of other backends.
+  TensorflowPredictCREPE(const char* streamingName);
+  void createInnerNetwork(const char* streamingName);
 
  public:
   TensorflowPredictCREPE();
@@ -31,8 +31,8 @@ const char* TensorflowPredictEffnetDiscogs::description = essentia::standard::Te
 
 
 TensorflowPredictEffnetDiscogs::TensorflowPredictEffnetDiscogs() : AlgorithmComposite(),
-    _frameCutter(0), _tensorflowInputMusiCNN(0), _vectorRealToTensor(0), _tensorToPool(0),
-    _tensorflowPredict(0), _poolToTensor(0), _tensorToVectorReal(0), _configured(false) {
+    _frameCutter(0), _tensorflowInputMusiCNN(0), _vectorRealToTensor(0),
+    _predictor(0), _tensorToVectorReal(0), _configured(false) {
 
   declareInput(_signal, 4096, "signal", "the input audio signal sampled at 16 kHz");
   declareOutput(_predictions, 0, "predictions", "the output values from the model node named after `output`");
@@ -45,9 +45,7 @@ void TensorflowPredictEffnetDiscogs::createInnerNetwork() {
   _frameCutter            = factory.create("FrameCutter");
   _tensorflowInputMusiCNN = factory.create("TensorflowInputMusiCNN");
   _vectorRealToTensor     = factory.create("VectorRealToTensor");
-  _tensorToPool           = factory.create("TensorToPool");
-  _tensorflowPredict      = factory.create("TensorflowPredict");
-  _poolToTensor           = factory.create("PoolToTensor");
+  _predictor              = createPredictor();
   _tensorToVectorReal     = factory.create("TensorToVectorReal");
 
   _tensorflowInputMusiCNN->output("bands").setBufferType(BufferUsage::forMultipleFrames);
@@ -55,10 +53,8 @@ void TensorflowPredictEffnetDiscogs::createInnerNetwork() {
   _signal                                  >> _frameCutter->input("signal");
   _frameCutter->output("frame")            >> _tensorflowInputMusiCNN->input("frame");
   _tensorflowInputMusiCNN->output("bands") >> _vectorRealToTensor->input("frame");
-  _vectorRealToTensor->output("tensor")    >> _tensorToPool->input("tensor");
-  _tensorToPool->output("pool")            >> _tensorflowPredict->input("poolIn");
-  _tensorflowPredict->output("poolOut")    >> _poolToTensor->input("pool");
-  _poolToTensor->output("tensor")          >> _tensorToVectorReal->input("tensor");
+  _vectorRealToTensor->output("tensor")    >> _predictor->input("tensor");
+  _predictor->output("tensor")             >> _tensorToVectorReal->input("tensor");
 
   attach(_tensorToVectorReal->output("frame"), _predictions);
 
@@ -95,7 +91,7 @@ void TensorflowPredictEffnetDiscogs::configure() {
   int batchSize = parameter("batchSize").toInt();
 
   if (patchSize == 0) {
-    throw EssentiaException("TensorflowPredictEffnetDiscogs: `patchSize` cannot be 0");
+    throw EssentiaException(Configurable::name(), ": `patchSize` cannot be 0");
   }
 
 
@@ -110,20 +106,28 @@ void TensorflowPredictEffnetDiscogs::configure() {
 
   _configured = true;
 
-  string input = parameter("input").toString();
-  string output = parameter("output").toString();
+  configurePredictor();
+}
 
-  _tensorToPool->configure("namespace", input);
 
-  _poolToTensor->configure("namespace", output);
+Algorithm* TensorflowPredictEffnetDiscogs::createPredictor() {
+  return AlgorithmFactory::create("TensorflowPredictTensor");
+}
+
+
+void TensorflowPredictEffnetDiscogs::configurePredictor() {
+  string input = parameter("input").toString();
+  string output = parameter("output").toString();
 
   string graphFilename = parameter("graphFilename").toString();
   string savedModel = parameter("savedModel").toString();
 
-  _tensorflowPredict->configure("graphFilename", graphFilename,
-                                "savedModel", savedModel,
-                                "inputs", vector<string>({input}),
-                                "outputs", vector<string>({output}));
+  _predictor->configure("graphFilename", graphFilename,
+                        "savedModel", savedModel,
+                        "inputs", vector<string>({input}),
+                        "outputs", vector<string>({output}),
+                        "dynamicBatchSize", parameter("dynamicBatchSize"),
+                        "dynamicBatchTimeout", parameter("dynamicBatchTimeout"));
 }
 
 } // namespace streaming
@@ -161,11 +165,15 @@ const char* TensorflowPredictEffnetDiscogs::description = DOC(
   "1. Supported models at https://essentia.upf.edu/models/\n\n");
 
 
-TensorflowPredictEffnetDiscogs::TensorflowPredictEffnetDiscogs() {
+TensorflowPredictEffnetDiscogs::TensorflowPredictEffnetDiscogs()
+    : TensorflowPredictEffnetDiscogs("TensorflowPredictEffnetDiscogs") {}
+
+
+TensorflowPredictEffnetDiscogs::TensorflowPredictEffnetDiscogs(const char* streamingName) {
     declareInput(_signal, "signal", "the input audio signal sampled at 16 kHz");
     declareOutput(_predictions, "predictions", "the output values from the model node named after `output`");
 
-    createInnerNetwork();
+    createInnerNetwork(streamingName);
   }
 
 
@@ -174,26 +182,22 @@ TensorflowPredictEffnetDiscogs::~TensorflowPredictEffnetDiscogs() {
 }
 
 
-void TensorflowPredictEffnetDiscogs::createInnerNetwork() {
-  _tensorflowPredictEffnetDiscogs = streaming::AlgorithmFactory::create("TensorflowPredictEffnetDiscogs");
+void TensorflowPredictEffnetDiscogs::createInnerNetwork(const char* streamingName) {
+  _predictEffnetDiscogs = streaming::AlgorithmFactory::create(streamingName);
   _vectorInput = new streaming::VectorInput<Real>();
 
-  *_vectorInput  >> _tensorflowPredictEffnetDiscogs->input("signal");
-  _tensorflowPredictEffnetDiscogs->output("predictions") >>  PC(_pool, "predictions");
+  *_vectorInput  >> _predictEffnetDiscogs->input("signal");
+  _predictEffnetDiscogs->output("predictions") >>  PC(_pool, "predictions");
 
   _network = new scheduler::Network(_vectorInput);
 }
 
 
 void TensorflowPredictEffnetDiscogs::configure() {
-  _tensorflowPredictEffnetDiscogs->configure(INHERIT("graphFilename"),
-                                             INHERIT("savedModel"),
-                                             INHERIT("input"),
-                                             INHERIT("output"),
-                                             INHERIT("patchHopSize"),
-                                             INHERIT("lastPatchMode"),
-                                             INHERIT("batchSize"),
-                                             INHERIT("patchSize"));
+  // The streaming algorithm takes the same parameters but `lastBatchMode`.
+  ParameterMap params = _params;
+  params.erase("lastBatchMode");
+  _predictEffnetDiscogs->configure(params);
 
   _patchHopSize = parameter("patchHopSize").toInt();
   _patchSize = parameter("patchSize").toInt();
@@ -208,7 +212,7 @@ void TensorflowPredictEffnetDiscogs::compute() {
   vector<vector<Real> >& predictions = _predictions.get();
 
   if (!signal->size()) {
-    throw EssentiaException("TensorflowPredictEffnetDiscogs: empty input signal");
+    throw EssentiaException(Configurable::name(), ": empty input signal");
   }
 
   vector<Real> paddedSignal;
@@ -264,7 +268,7 @@ int TensorflowPredictEffnetDiscogs::padSignal(const std::vector<Real> &signal, s
   } else if (_lastPatchMode == "discard") {
     nPatches = 1 + floor(patchHops);
   } else {
-    throw EssentiaException("TensorflowPredictEffnetDiscogs: incorrect `lastPatchMode`");
+    throw EssentiaException(Configurable::name(), ": incorrect `lastPatchMode`");
   }
 
   // Patches to batches.
@@ -34,9 +34,7 @@ class TensorflowPredictEffnetDiscogs : public AlgorithmComposite {
   Algorithm* _frameCutter;
   Algorithm* _tensorflowInputMusiCNN;
   Algorithm* _vectorRealToTensor;
-  Algorithm* _tensorToPool;
-  Algorithm* _tensorflowPredict;
-  Algorithm* _poolToTensor;
+  Algorithm* _predictor;
   Algorithm* _tensorToVectorReal;
 
   SinkProxy<Real> _signal;
@@ -48,6 +46,11 @@ class TensorflowPredictEffnetDiscogs : public AlgorithmComposite {
   void createInnerNetwork();
   void clearAlgos();
 
+  // The model is run by TensorflowPredictTensor. The wrappers of the same
+  // models for other backends override these (see OnnxPredictEffnetDiscogs).
+  virtual Algorithm* createPredictor();
+  virtual void configurePredictor();
+
   // Hardcoded parameters matching the training setup. We used MusiCNN style mel-spectrograms:
   // https://github.com/jordipons/musicnn-training/blob/master/src/config_file.py
   const int _frameSize = 512;
@@ -67,6 +70,8 @@ class TensorflowPredictEffnetDiscogs : public AlgorithmComposite {
     declareParameter("lastPatchMode", "what to do with the last frames: `repeat` them to fill the last patch or `discard` them", "{discard,repeat}", "discard");
     declareParameter("batchSize", "the batch size for prediction. This allows parallelization when GPUs are available. Set it to -1 or 0 to accumulate all the patches and run a single TensorFlow session at the end of the stream", "[-1,inf)", 64);
     declareParameter("patchSize", "number of frames required for each inference. This parameter should match the model's expected input shape.", "[0,inf)", 128);
+    declareParameter("dynamicBatchSize", "the maximum number of patches of the instances running the same model concurrently that are gathered into a single TensorFlow batch. 0 to run the batches of each instance separately", "[0,inf)", 0);
+    declareParameter("dynamicBatchTimeout", "the maximum time to wait for other instances to fill a dynamic batch [s]", "[0,inf)", 0.01);
   }
 
   void declareProcessOrder() {
@@ -99,7 +104,7 @@ class TensorflowPredictEffnetDiscogs : public Algorithm {
   Input<std::vector<Real> > _signal;
   Output<std::vector<std::vector<Real> > > _predictions;
 
-  streaming::Algorithm* _tensorflowPredictEffnetDiscogs;
+  streaming::Algorithm* _predictEffnetDiscogs;
   streaming::VectorInput<Real>* _vectorInput;
   scheduler::Network* _network;
   Pool _pool;
@@ -116,7 +121,10 @@ class TensorflowPredictEffnetDiscogs : public Algorithm {
   const int _hopSize = 256;
   const int _sampleRate = 16000;
 
-  void createInnerNetwork();
+  // Wraps the streaming algorithm named @c streamingName, which is the one
+  // with the same name unless for the wrappers of other backends.
+  TensorflowPredictEffnetDiscogs(const char* streamingName);
+  void createInnerNetwork(const char* streamingName);
   int padSignal(const std::vector<Real> &signal, std::vector<Real> &paddedSignal);
 
  public:
@@ -132,6 +140,8 @@ class TensorflowPredictEffnetDiscogs : public Algorithm {
     declareParameter("lastPatchMode", "what to do with the last frames: `repeat` them to fill the last patch or `discard` them", "{discard,repeat}", "discard");
     declareParameter("batchSize", "the batch size for prediction. This allows parallelization when GPUs are available. Set it to -1 or 0 to accumulate all the patches and run a single TensorFlow session at the end of the stream", "[-1,inf)", 64);
     declareParameter("patchSize", "number of frames required for each inference. This parameter should match the model's expected input shape.", "[0,inf)", 128);
+    declareParameter("dynamicBatchSize", "the maximum number of patches of the instances running the same model concurrently that are gathered into a single TensorFlow batch. 0 to run the batches of each instance separately", "[0,inf)", 0);
+    declareParameter("dynamicBatchTimeout", "the maximum time to wait for other instances to fill a dynamic batch [s]", "[0,inf)", 0.01);
     declareParameter("lastBatchMode", "some EffnetDiscogs models operate on a fixed batch size. The options are to `discard` the last patches or to pad with `zeros` to make a final batch. Additionally `same` zero-pads the input but returns only the predictions corresponding to patches with signal", "{discard,zeros,same}", "same");
   }
 
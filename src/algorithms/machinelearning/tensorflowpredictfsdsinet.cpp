@@ -31,8 +31,8 @@ const char* TensorflowPredictFSDSINet::description = essentia::standard::Tensorf
 
 
 TensorflowPredictFSDSINet::TensorflowPredictFSDSINet() : AlgorithmComposite(),
-    _frameCutter(0), _tensorflowInputFSDSINet(0), _vectorRealToTensor(0), _tensorToPool(0),
-    _tensorTranspose(0), _tensorflowPredict(0), _poolToTensor(0), _tensorToVectorReal(0), _configured(false) {
+    _frameCutter(0), _tensorflowInputFSDSINet(0), _vectorRealToTensor(0),
+    _tensorTranspose(0), _tensorflowPredict(0), _tensorToVectorReal(0), _configured(false) {
 
   declareInput(_signal, 4096, "signal", "the input audio signal sampled at 22.05 kHz");
   declareOutput(_predictions, 0, "predictions", "the output values from the model node named after `output`");
@@ -46,9 +46,7 @@ void TensorflowPredictFSDSINet::createInnerNetwork() {
   _tensorflowInputFSDSINet = factory.create("TensorflowInputFSDSINet");
   _vectorRealToTensor     = factory.create("VectorRealToTensor");
   _tensorTranspose        = factory.create("TensorTranspose");
-  _tensorToPool           = factory.create("TensorToPool");
-  _tensorflowPredict      = factory.create("TensorflowPredict");
-  _poolToTensor           = factory.create("PoolToTensor");
+  _tensorflowPredict      = factory.create("TensorflowPredictTensor");
   _tensorToVectorReal     = factory.create("TensorToVectorReal");
 
   _tensorflowInputFSDSINet->output("bands").setBufferType(BufferUsage::forMultipleFrames);
@@ -57,10 +55,8 @@ void TensorflowPredictFSDSINet::createInnerNetwork() {
   _frameCutter->output("frame")            >> _tensorflowInputFSDSINet->input("frame");
   _tensorflowInputFSDSINet->output("bands") >> _vectorRealToTensor->input("frame");
   _vectorRealToTensor->output("tensor")     >> _tensorTranspose->input("tensor");
-  _tensorTranspose-> output("tensor")      >>  _tensorToPool->input("tensor");
-  _tensorToPool->output("pool")            >>  _tensorflowPredict->input("poolIn");
-  _tensorflowPredict->output("poolOut")    >>  _poolToTensor->input("pool");
-  _poolToTensor->output("tensor")          >>  _tensorToVectorReal->input("tensor");
+  _tensorTranspose-> output("tensor")      >>  _tensorflowPredict->input("tensor");
+  _tensorflowPredict->output("tensor")     >>  _tensorToVectorReal->input("tensor");
 
   attach(_tensorToVectorReal->output("frame"), _predictions);
 
@@ -116,9 +112,6 @@ void TensorflowPredictFSDSINet::configure() {
   // {Batch, Channel, Time, Freq} --> {Batch, Time, Freq, Channel}
   vector<int> permutation({0, 2, 3, 1});
   _tensorTranspose->configure("permutation", permutation);
-  _tensorToPool->configure("namespace", input);
-  _poolToTensor->configure("namespace", output);
-
   string graphFilename = parameter("graphFilename").toString();
   string savedModel = parameter("savedModel").toString();
 
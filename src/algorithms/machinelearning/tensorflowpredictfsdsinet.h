@@ -34,10 +34,8 @@ class TensorflowPredictFSDSINet : public AlgorithmComposite {
   Algorithm* _frameCutter;
   Algorithm* _tensorflowInputFSDSINet;
   Algorithm* _vectorRealToTensor;
-  Algorithm* _tensorToPool;
   Algorithm* _tensorTranspose;
   Algorithm* _tensorflowPredict;
-  Algorithm* _poolToTensor;
   Algorithm* _tensorToVectorReal;
 
   SinkProxy<Real> _signal;
@@ -31,7 +31,7 @@ const char* TensorflowPredictMAEST::description = essentia::standard::Tensorflow
 
 TensorflowPredictMAEST::TensorflowPredictMAEST() : AlgorithmComposite(),
     _frameCutter(0), _tensorflowInputMusiCNN(0), _shift(0), _scale(0), _vectorRealToTensor(0),
-    _tensorToPool(0), _tensorflowPredict(0), _poolToTensor(0), _configured(false) {
+    _tensorflowPredict(0), _configured(false) {
 
   declareInput(_signal, 480000, "signal", "the input audio signal sampled at 16 kHz");
   declareOutput(_predictions, 1, "predictions", "the output values from the model node named after `output`");
@@ -46,9 +46,7 @@ void TensorflowPredictMAEST::createInnerNetwork() {
   _shift                  = factory.create("UnaryOperator");
   _scale                  = factory.create("UnaryOperator");
   _vectorRealToTensor     = factory.create("VectorRealToTensor");
-  _tensorToPool           = factory.create("TensorToPool");
-  _tensorflowPredict      = factory.create("TensorflowPredict");
-  _poolToTensor           = factory.create("PoolToTensor");
+  _tensorflowPredict      = factory.create("TensorflowPredictTensor");
 
   _shift->output("array").setBufferType(BufferUsage::forMultipleFrames);
   _scale->output("array").setBufferType(BufferUsage::forMultipleFrames);
@@ -59,11 +57,9 @@ void TensorflowPredictMAEST::createInnerNetwork() {
   _tensorflowInputMusiCNN->output("bands") >> _shift->input("array");
   _shift->output("array")                  >> _scale->input("array");
   _scale->output("array")                  >> _vectorRealToTensor->input("frame");
-  _vectorRealToTensor->output("tensor")    >> _tensorToPool->input("tensor");
-  _tensorToPool->output("pool")            >> _tensorflowPredict->input("poolIn");
-  _tensorflowPredict->output("poolOut")    >> _poolToTensor->input("pool");
+  _vectorRealToTensor->output("tensor")    >> _tensorflowPredict->input("tensor");
 
-  attach(_poolToTensor->output("tensor"), _predictions);
+  attach(_tensorflowPredict->output("tensor"), _predictions);
 
   _network = new scheduler::Network(_frameCutter);
 }
@@ -151,12 +147,6 @@ void TensorflowPredictMAEST::configure() {
 
   _configured = true;
 
-
-  _tensorToPool->configure("namespace", input);
-
-  _poolToTensor->configure("namespace", output);
-
-
   _tensorflowPredict->configure("graphFilename", graphFilename,
                                 "savedModel", savedModel,
                                 "inputs", vector<string>({input}),
@@ -36,9 +36,7 @@ class TensorflowPredictMAEST : public AlgorithmComposite {
   Algorithm* _shift;
   Algorithm* _scale;
   Algorithm* _vectorRealToTensor;
-  Algorithm* _tensorToPool;
   Algorithm* _tensorflowPredict;
-  Algorithm* _poolToTensor;
 
   SinkProxy<Real> _signal;
   SourceProxy<Tensor<Real> > _predictions;
@@ -30,8 +30,8 @@ const char* TensorflowPredictMusiCNN::description = essentia::standard::Tensorfl
 
 
 TensorflowPredictMusiCNN::TensorflowPredictMusiCNN() : AlgorithmComposite(),
-    _frameCutter(0), _tensorflowInputMusiCNN(0), _vectorRealToTensor(0), _tensorToPool(0),
-    _tensorflowPredict(0), _poolToTensor(0), _tensorToVectorReal(0), _configured(false) {
+    _frameCutter(0), _tensorflowInputMusiCNN(0), _vectorRealToTensor(0),
+    _predictor(0), _tensorToVectorReal(0), _configured(false) {
 
   declareInput(_signal, 4096, "signal", "the input audio signal sampled at 16 kHz");
   declareOutput(_predictions, 0, "predictions", "the output values from the model node named after `output`");
@@ -44,9 +44,7 @@ void TensorflowPredictMusiCNN::createInnerNetwork() {
   _frameCutter            = factory.create("FrameCutter");
   _tensorflowInputMusiCNN = factory.create("TensorflowInputMusiCNN");
   _vectorRealToTensor     = factory.create("VectorRealToTensor");
-  _tensorToPool           = factory.create("TensorToPool");
-  _tensorflowPredict      = factory.create("TensorflowPredict");
-  _poolToTensor           = factory.create("PoolToTensor");
+  _predictor              = createPredictor();
   _tensorToVectorReal     = factory.create("TensorToVectorReal");
 
   _tensorflowInputMusiCNN->output("bands").setBufferType(BufferUsage::forMultipleFrames);
@@ -54,10 +52,8 @@ void TensorflowPredictMusiCNN::createInnerNetwork() {
   _signal                                  >> _frameCutter->input("signal");
   _frameCutter->output("frame")            >> _tensorflowInputMusiCNN->input("frame");
   _tensorflowInputMusiCNN->output("bands") >> _vectorRealToTensor->input("frame");
-  _vectorRealToTensor->output("tensor")    >>  _tensorToPool->input("tensor");
-  _tensorToPool->output("pool")            >>  _tensorflowPredict->input("poolIn");
-  _tensorflowPredict->output("poolOut")    >>  _poolToTensor->input("pool");
-  _poolToTensor->output("tensor")          >>  _tensorToVectorReal->input("tensor");
+  _vectorRealToTensor->output("tensor")    >>  _predictor->input("tensor");
+  _predictor->output("tensor")             >>  _tensorToVectorReal->input("tensor");
 
   attach(_tensorToVectorReal->output("frame"), _predictions);
 
@@ -111,22 +107,30 @@ void TensorflowPredictMusiCNN::configure() {
 
   _configured = true;
 
+  configurePredictor();
+}
+
+
+Algorithm* TensorflowPredictMusiCNN::createPredictor() {
+  return AlgorithmFactory::create("TensorflowPredictTensor");
+}
+
+
+void TensorflowPredictMusiCNN::configurePredictor() {
   string input = parameter("input").toString();
   string output = parameter("output").toString();
   string isTrainingName = parameter("isTrainingName").toString();
 
-  _tensorToPool->configure("namespace", input);
-
-  _poolToTensor->configure("namespace", output);
-
   string graphFilename = parameter("graphFilename").toString();
   string savedModel = parameter("savedModel").toString();
 
-  _tensorflowPredict->configure("graphFilename", graphFilename,
-                                "savedModel", savedModel,
-                                "inputs", vector<string>({input}),
-                                "outputs", vector<string>({output}),
-                                "isTrainingName", isTrainingName);
+  _predictor->configure("graphFilename", graphFilename,
+                        "savedModel", savedModel,
+                        "inputs", vector<string>({input}),
+                        "outputs", vector<string>({output}),
+                        "isTrainingName", isTrainingName,
+                        "dynamicBatchSize", parameter("dynamicBatchSize"),
+                        "dynamicBatchTimeout", parameter("dynamicBatchTimeout"));
 }
 
 } // namespace streaming
@@ -165,11 +169,15 @@ const char* TensorflowPredictMusiCNN::description = DOC(
   "2. Supported models at https://essentia.upf.edu/models/\n\n");
 
 
-TensorflowPredictMusiCNN::TensorflowPredictMusiCNN() {
+TensorflowPredictMusiCNN::TensorflowPredictMusiCNN()
+    : TensorflowPredictMusiCNN("TensorflowPredictMusiCNN") {}
+
+
+TensorflowPredictMusiCNN::TensorflowPredictMusiCNN(const char* streamingName) {
     declareInput(_signal, "signal", "the input audio signal sampled at 16 kHz");
     declareOutput(_predictions, "predictions", "the output values from the model node named after `output`");
 
-    createInnerNetwork();
+    createInnerNetwork(streamingName);
   }
 
 
@@ -178,28 +186,20 @@ TensorflowPredictMusiCNN::~TensorflowPredictMusiCNN() {
 }
 
 
-void TensorflowPredictMusiCNN::createInnerNetwork() {
-  _tensorflowPredictMusiCNN = streaming::AlgorithmFactory::create("TensorflowPredictMusiCNN");
+void TensorflowPredictMusiCNN::createInnerNetwork(const char* streamingName) {
+  _predictMusiCNN = streaming::AlgorithmFactory::create(streamingName);
   _vectorInput = new streaming::VectorInput<Real>();
 
-  *_vectorInput  >> _tensorflowPredictMusiCNN->input("signal");
-  _tensorflowPredictMusiCNN->output("predictions") >>  PC(_pool, "predictions");
+  *_vectorInput  >> _predictMusiCNN->input("signal");
+  _predictMusiCNN->output("predictions") >>  PC(_pool, "predictions");
 
   _network = new scheduler::Network(_vectorInput);
 }
 
 
 void TensorflowPredictMusiCNN::configure() {
-  _tensorflowPredictMusiCNN->configure(INHERIT("graphFilename"),
-                                       INHERIT("savedModel"),
-                                       INHERIT("input"),
-                                       INHERIT("output"),
-                                       INHERIT("isTrainingName"),
-                                       INHERIT("patchHopSize"),
-                                       INHERIT("accumulate"),
-                                       INHERIT("lastPatchMode"),
-                                       INHERIT("patchSize"),
-                                       INHERIT("batchSize"));
+  // The streaming algorithm takes the same parameters.
+  _predictMusiCNN->configure(_params);
 }
 
 
@@ -208,7 +208,7 @@ void TensorflowPredictMusiCNN::compute() {
   vector<vector<Real> >& predictions = _predictions.get();
 
   if (!signal.size()) {
-    throw EssentiaException("TensorflowPredictMusiCNN: empty input signal");
+    throw EssentiaException(Configurable::name(), ": empty input signal");
   }
 
   _vectorInput->setVector(&signal);
@@ -34,9 +34,7 @@ class TensorflowPredictMusiCNN : public AlgorithmComposite {
   Algorithm* _frameCutter;
   Algorithm* _tensorflowInputMusiCNN;
   Algorithm* _vectorRealToTensor;
-  Algorithm* _tensorToPool;
-  Algorithm* _tensorflowPredict;
-  Algorithm* _poolToTensor;
+  Algorithm* _predictor;
   Algorithm* _tensorToVectorReal;
 
   SinkProxy<Real> _signal;
@@ -48,6 +46,11 @@ class TensorflowPredictMusiCNN : public AlgorithmComposite {
   void createInnerNetwork();
   void clearAlgos();
 
+  // The model is run by TensorflowPredictTensor. The wrappers of the same
+  // models for other backends override these (see OnnxPredictMusiCNN).
+  virtual Algorithm* createPredictor();
+  virtual void configurePredictor();
+
  public:
   TensorflowPredictMusiCNN();
   ~TensorflowPredictMusiCNN();
@@ -63,6 +66,8 @@ class TensorflowPredictMusiCNN : public AlgorithmComposite {
     declareParameter("accumulate", "(deprecated, use `batchSize`) when true it runs a single Tensorflow session at the end of the stream. Otherwise a session is run for every new patch", "{true,false}", false);
     declareParameter("batchSize", "the batch size for prediction. This allows parallelization when GPUs are available. Set it to -1 or 0 to accumulate all the patches and run a single TensorFlow session at the end of the stream", "[-1,inf)", 64);
     declareParameter("patchSize", "number of frames required for each inference. This parameter should match the model's expected input shape.", "[0,inf)", 187);
+    declareParameter("dynamicBatchSize", "the maximum number of patches of the instances running the same model concurrently that are gathered into a single TensorFlow batch. 0 to run the batches of each instance separately", "[0,inf)", 0);
+    declareParameter("dynamicBatchTimeout", "the maximum time to wait for other instances to fill a dynamic batch [s]", "[0,inf)", 0.01);
   }
 
   void declareProcessOrder() {
@@ -95,12 +100,15 @@ class TensorflowPredictMusiCNN : public Algorithm {
   Input<std::vector<Real> > _signal;
   Output<std::vector<std::vector<Real> > > _predictions;
 
-  streaming::Algorithm* _tensorflowPredictMusiCNN;
+  streaming::Algorithm* _predictMusiCNN;
   streaming::VectorInput<Real>* _vectorInput;
   scheduler::Network* _network;
   Pool _pool;
 
-  void createInnerNetwork();
+  // Wraps the streaming algorithm named @c streamingName, which is the one
+  // with the same name unless for the wrappers of other backends.
+  TensorflowPredictMusiCNN(const char* streamingName);
+  void createInnerNetwork(const char* streamingName);
 
  public:
   TensorflowPredictMusiCNN();
@@ -117,6 +125,8 @@ class TensorflowPredictMusiCNN : public Algorithm {
     declareParameter("accumulate", "(deprecated, use `batchSize`) when true it runs a single Tensorflow session at the end of the stream. Otherwise a session is run for every new patch", "{true,false}", false);
     declareParameter("batchSize", "the batch size for prediction. This allows parallelization when GPUs are available. Set it to -1 or 0 to accumulate all the patches and run a single TensorFlow session at the end of the stream", "[-1,inf)", 64);
     declareParameter("patchSize", "number of frames required for each inference. This parameter should match the model's expected input shape.", "[0,inf)", 187);
+    declareParameter("dynamicBatchSize", "the maximum number of patches of the instances running the same model concurrently that are gathered into a single TensorFlow batch. 0 to run the batches of each instance separately", "[0,inf)", 0);
+    declareParameter("dynamicBatchTimeout", "the maximum time to wait for other instances to fill a dynamic batch [s]", "[0,inf)", 0.01);
   }
 
   void configure();
@@ -31,7 +31,7 @@ const char* TensorflowPredictTempoCNN::description = essentia::standard::Tensorf
 
 TensorflowPredictTempoCNN::TensorflowPredictTempoCNN() : AlgorithmComposite(),
     _frameCutter(0), _tensorflowInputTempoCNN(0), _vectorRealToTensor(0), _tensorNormalize(0),
-    _tensorTranspose(0), _tensorToPool(0), _tensorflowPredict(0), _poolToTensor(0),
+    _tensorTranspose(0), _predictor(0),
     _tensorToVectorReal(0), _configured(false) {
 
   declareInput(_signal, 4096, "signal", "the input audio signal sampled at 11025 Hz");
@@ -47,9 +47,7 @@ void TensorflowPredictTempoCNN::createInnerNetwork() {
   _vectorRealToTensor      = factory.create("VectorRealToTensor");
   _tensorNormalize         = factory.create("TensorNormalize");
   _tensorTranspose         = factory.create("TensorTranspose");
-  _tensorToPool            = factory.create("TensorToPool");
-  _tensorflowPredict       = factory.create("TensorflowPredict");
-  _poolToTensor            = factory.create("PoolToTensor");
+  _predictor               = createPredictor();
   _tensorToVectorReal      = factory.create("TensorToVectorReal");
 
   _tensorflowInputTempoCNN->output("bands").setBufferType(BufferUsage::forMultipleFrames);
@@ -59,10 +57,8 @@ void TensorflowPredictTempoCNN::createInnerNetwork() {
   _tensorflowInputTempoCNN->output("bands") >> _vectorRealToTensor->input("frame");
   _vectorRealToTensor->output("tensor")     >> _tensorNormalize->input("tensor");
   _tensorNormalize->output("tensor")        >> _tensorTranspose->input("tensor");
-  _tensorTranspose->output("tensor")        >> _tensorToPool->input("tensor");
-  _tensorToPool->output("pool")             >> _tensorflowPredict->input("poolIn");
-  _tensorflowPredict->output("poolOut")     >> _poolToTensor->input("pool");
-  _poolToTensor->output("tensor")           >> _tensorToVectorReal->input("tensor");
+  _tensorTranspose->output("tensor")        >> _predictor->input("tensor");
+  _predictor->output("tensor")              >> _tensorToVectorReal->input("tensor");
 
   attach(_tensorToVectorReal->output("frame"), _predictions);
 
@@ -121,21 +117,27 @@ void TensorflowPredictTempoCNN::configure() {
 
   _configured = true;
 
-  string input = parameter("input").toString();
-  string output = parameter("output").toString();
+  configurePredictor();
+}
 
-  _tensorToPool->configure("namespace", input);
 
-  _poolToTensor->configure("namespace", output);
+Algorithm* TensorflowPredictTempoCNN::createPredictor() {
+  return AlgorithmFactory::create("TensorflowPredictTensor");
+}
+
+
+void TensorflowPredictTempoCNN::configurePredictor() {
+  string input = parameter("input").toString();
+  string output = parameter("output").toString();
 
   string graphFilename = parameter("graphFilename").toString();
   string savedModel = parameter("savedModel").toString();
 
-  _tensorflowPredict->configure("graphFilename", graphFilename,
-                                "savedModel", savedModel,
-                                "squeeze", false,
-                                "inputs", vector<string>({input}),
-                                "outputs", vector<string>({output}));
+  _predictor->configure("graphFilename", graphFilename,
+                        "savedModel", savedModel,
+                        "squeeze", false,
+                        "inputs", vector<string>({input}),
+                        "outputs", vector<string>({output}));
 }
 
 } // namespace streaming
@@ -180,11 +182,15 @@ const char* TensorflowPredictTempoCNN::description = DOC(
   "4. Supported models at https://essentia.upf.edu/models/\n\n");
 
 
-TensorflowPredictTempoCNN::TensorflowPredictTempoCNN() {
+TensorflowPredictTempoCNN::TensorflowPredictTempoCNN()
+    : TensorflowPredictTempoCNN("TensorflowPredictTempoCNN") {}
+
+
+TensorflowPredictTempoCNN::TensorflowPredictTempoCNN(const char* streamingName) {
     declareInput(_signal, "signal", "the input audio signal sampled at 11025 Hz");
     declareOutput(_predictions, "predictions", "the output values from the model node named after `output`");
 
-    createInnerNetwork();
+    createInnerNetwork(streamingName);
   }
 
 
@@ -193,25 +199,20 @@ TensorflowPredictTempoCNN::~TensorflowPredictTempoCNN() {
 }
 
 
-void TensorflowPredictTempoCNN::createInnerNetwork() {
-  _tensorflowPredictTempoCNN = streaming::AlgorithmFactory::create("TensorflowPredictTempoCNN");
+void TensorflowPredictTempoCNN::createInnerNetwork(const char* streamingName) {
+  _predictTempoCNN = streaming::AlgorithmFactory::create(streamingName);
   _vectorInput = new streaming::VectorInput<Real>();
 
-  *_vectorInput  >> _tensorflowPredictTempoCNN->input("signal");
-  _tensorflowPredictTempoCNN->output("predictions") >>  PC(_pool, "predictions");
+  *_vectorInput  >> _predictTempoCNN->input("signal");
+  _predictTempoCNN->output("predictions") >>  PC(_pool, "predictions");
 
   _network = new scheduler::Network(_vectorInput);
 }
 
 
 void TensorflowPredictTempoCNN::configure() {
-  _tensorflowPredictTempoCNN->configure(INHERIT("graphFilename"),
-                                        INHERIT("savedModel"),
-                                        INHERIT("input"),
-                                        INHERIT("output"),
-                                        INHERIT("patchHopSize"),
-                                        INHERIT("batchSize"),
-                                        INHERIT("lastPatchMode"));
+  // The streaming algorithm takes the same parameters.
+  _predictTempoCNN->configure(_params);
 }
 
 
@@ -220,7 +221,7 @@ void TensorflowPredictTempoCNN::compute() {
   vector<vector<Real> >& predictions = _predictions.get();
 
   if (!signal.size()) {
-    throw EssentiaException("TensorflowPredictTempoCNN: empty input signal");
+    throw EssentiaException(Configurable::name(), ": empty input signal");
   }
 
   _vectorInput->setVector(&signal);
@@ -36,9 +36,7 @@ class TensorflowPredictTempoCNN : public AlgorithmComposite {
   Algorithm* _vectorRealToTensor;
   Algorithm* _tensorNormalize;
   Algorithm* _tensorTranspose;
-  Algorithm* _tensorToPool;
-  Algorithm* _tensorflowPredict;
-  Algorithm* _poolToTensor;
+  Algorithm* _predictor;
   Algorithm* _tensorToVectorReal;
 
   SinkProxy<Real> _signal;
@@ -50,6 +48,11 @@ class TensorflowPredictTempoCNN : public AlgorithmComposite {
   void createInnerNetwork();
   void clearAlgos();
 
+  // The model is run by TensorflowPredictTensor. The wrappers of the same
+  // models for other backends override these (see OnnxPredictTempoCNN).
+  virtual Algorithm* createPredictor();
+  virtual void configurePredictor();
+
  public:
   TensorflowPredictTempoCNN();
   ~TensorflowPredictTempoCNN();
@@ -94,12 +97,15 @@ class TensorflowPredictTempoCNN : public Algorithm {
   Input<std::vector<Real> > _signal;
   Output<std::vector<std::vector<Real> > > _predictions;
 
-  streaming::Algorithm* _tensorflowPredictTempoCNN;
+  streaming::Algorithm* _predictTempoCNN;
   streaming::VectorInput<Real>* _vectorInput;
   scheduler::Network* _network;
   Pool _pool;
 
-  void createInnerNetwork();
+  // Wraps the streaming algorithm named @c streamingName, which is the one
+  // with the same name unless for the wrappers of other backends.
+  TensorflowPredictTempoCNN(const char* streamingName);
+  void createInnerNetwork(const char* streamingName);
 
  public:
   TensorflowPredictTempoCNN();
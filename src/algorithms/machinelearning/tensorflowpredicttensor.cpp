@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "tensorflowpredicttensor.h"
+#include "algorithmfactory.h"
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+const char* TensorflowPredictTensor::name = "TensorflowPredictTensor";
+const char* TensorflowPredictTensor::category = "Machine Learning";
+const char* TensorflowPredictTensor::description = DOC("This algorithm runs a Tensorflow graph on a stream of tensors and outputs the tensors of the given output node.\n"
+"It works as TensorflowPredict (see its documentation for the details of the parameters), with a single input and a single output node, but without storing the tensors in pools: "
+"the memory of the input tensors is passed to TensorFlow without copying it, and the output tensors are written into reused buffers. "
+"This makes it the preferred way of running models inside streaming networks.");
+
+
+TensorflowPredictTensor::TensorflowPredictTensor() : Algorithm(), _inputData(1), _outputData(1) {
+  declareInput(_tensorIn, 1, "tensor", "the input tensor");
+  declareOutput(_tensorOut, 1, "tensor", "the tensor of the output node");
+
+  _tensorflowPredict = static_cast<standard::TensorflowPredict*>(
+      standard::AlgorithmFactory::create("TensorflowPredict"));
+}
+
+
+TensorflowPredictTensor::~TensorflowPredictTensor() {
+  delete _tensorflowPredict;
+}
+
+
+void TensorflowPredictTensor::configure() {
+  // Do not do anything if we did not get a non-empty model name, as
+  // TensorflowPredict does. This is the case when the algorithm is created by
+  // the factory, before the inputs and outputs are set.
+  if (parameter("savedModel").toString().empty() &&
+      parameter("graphFilename").toString().empty()) return;
+
+  if (parameter("inputs").toVectorString().size() > 1 ||
+      parameter("outputs").toVectorString().size() > 1) {
+    throw EssentiaException("TensorflowPredictTensor: only a single input and a single output node are supported");
+  }
+
+  // Both algorithms share the same parameters.
+  _tensorflowPredict->Configurable::configure(_params);
+}
+
+
+void TensorflowPredictTensor::reset() {
+  Algorithm::reset();
+  _tensorflowPredict->reset();
+}
+
+
+AlgorithmStatus TensorflowPredictTensor::process() {
+  EXEC_DEBUG("process()");
+  AlgorithmStatus status = acquireData();
+  EXEC_DEBUG("data acquired (in: " << _tensorIn.acquireSize()
+             << " - out: " << _tensorOut.acquireSize() << ")");
+
+  if (status != OK) {
+    return status;
+  }
+
+  const vector<Tensor<Real> >& tensorIn = _tensorIn.tokens();
+  vector<Tensor<Real> >& tensorOut = _tensorOut.tokens();
+
+  for (size_t i = 0; i < tensorIn.size(); i++) {
+    _inputData[0] = &tensorIn[i];
+
+    // Predict directly into the output token, whose memory is reused when the
+    // shape of the predictions does not change.
+    swap(_outputData[0], tensorOut[i]);
+    _tensorflowPredict->predict(_inputData, _outputData);
+    swap(_outputData[0], tensorOut[i]);
+  }
+
+  EXEC_DEBUG("releasing");
+  releaseData();
+  EXEC_DEBUG("released");
+
+  return OK;
+}
+
+} // namespace streaming
+} // namespace essentia
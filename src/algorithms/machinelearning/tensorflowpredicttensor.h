@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_TENSORFLOWPREDICTTENSOR_H
+#define ESSENTIA_TENSORFLOWPREDICTTENSOR_H
+
+#include "streamingalgorithm.h"
+#include "tensorflowpredict.h"
+
+namespace essentia {
+namespace streaming {
+
+class TensorflowPredictTensor : public Algorithm {
+ protected:
+  Sink<Tensor<Real> > _tensorIn;
+  Source<Tensor<Real> > _tensorOut;
+
+  standard::TensorflowPredict* _tensorflowPredict;
+  std::vector<const Tensor<Real>*> _inputData;
+  std::vector<Tensor<Real> > _outputData;
+
+ public:
+  TensorflowPredictTensor();
+  ~TensorflowPredictTensor();
+
+  void declareParameters() {
+    const char* defaultTagsC[] = { "serve" };
+    std::vector<std::string> defaultTags = arrayToVector<std::string>(defaultTagsC);
+
+    declareParameter("graphFilename", "the name of the file from which to load the TensorFlow graph", "", "");
+    declareParameter("savedModel", "the name of the TensorFlow SavedModel. Overrides parameter `graphFilename`", "", "");
+    declareParameter("tags", "the tags of the savedModel", "", defaultTags);
+    declareParameter("inputs", "a list with the name of the input node of the Tensorflow graph", "", Parameter::VECTOR_STRING);
+    declareParameter("outputs", "a list with the name of the node from which to retrieve the output tensors", "", Parameter::VECTOR_STRING);
+    declareParameter("isTraining", "run the model in training mode (normalized with statistics of the current batch) instead of inference mode (normalized with moving statistics). This only applies to some models", "{true,false}", false);
+    declareParameter("isTrainingName", "the name of an additional input node indicating whether the model is to be run in a training mode (for models with a training mode, leave it empty otherwise)", "", "");
+    declareParameter("squeeze", "remove singleton dimensions of the inputs tensors. Does not apply to the batch dimension", "{true,false}", true);
+    declareParameter("shareModel", "share the loaded model and its session with the other instances configured with the same model and number of threads", "{true,false}", true);
+    declareParameter("intraOpThreads", "the number of threads used to run each TensorFlow operation (0 to let TensorFlow decide)", "[0,inf)", 0);
+    declareParameter("interOpThreads", "the number of TensorFlow operations that can run in parallel (0 to let TensorFlow decide)", "[0,inf)", 0);
+    declareParameter("dynamicBatchSize", "the maximum number of patches of the instances sharing the model (see `shareModel`) that are gathered into a single batch. Only applies to graphs with a single input and output. Set it to 0 to run the batches as they come", "[0,inf)", 0);
+    declareParameter("dynamicBatchTimeout", "the maximum time to wait for other instances to fill a dynamic batch [s]", "[0,inf)", 0.01);
+  }
+
+  void configure();
+  void reset();
+  AlgorithmStatus process();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_TENSORFLOWPREDICTTENSOR_H
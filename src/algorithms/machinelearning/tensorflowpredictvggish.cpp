@@ -29,8 +29,8 @@ const char* TensorflowPredictVGGish::category = essentia::standard::TensorflowPr
 const char* TensorflowPredictVGGish::description = essentia::standard::TensorflowPredictVGGish::description;
 
 TensorflowPredictVGGish::TensorflowPredictVGGish() : AlgorithmComposite(),
-    _frameCutter(0), _tensorflowInputVGGish(0), _vectorRealToTensor(0), _tensorToPool(0),
-    _tensorflowPredict(0), _poolToTensor(0), _tensorToVectorReal(0), _configured(false) {
+    _frameCutter(0), _tensorflowInputVGGish(0), _vectorRealToTensor(0),
+    _predictor(0), _tensorToVectorReal(0), _configured(false) {
 
   declareInput(_signal, 4096, "signal", "the input audio signal sampled at 16 kHz");
   declareOutput(_predictions, 0, "predictions", "the output values from the model node named after `output`");
@@ -43,9 +43,7 @@ void TensorflowPredictVGGish::createInnerNetwork() {
   _frameCutter            = factory.create("FrameCutter");
   _tensorflowInputVGGish  = factory.create("TensorflowInputVGGish");
   _vectorRealToTensor     = factory.create("VectorRealToTensor");
-  _tensorToPool           = factory.create("TensorToPool");
-  _tensorflowPredict      = factory.create("TensorflowPredict");
-  _poolToTensor           = factory.create("PoolToTensor");
+  _predictor              = createPredictor();
   _tensorToVectorReal     = factory.create("TensorToVectorReal");
 
   _tensorflowInputVGGish->output("bands").setBufferType(BufferUsage::forMultipleFrames);
@@ -53,10 +51,8 @@ void TensorflowPredictVGGish::createInnerNetwork() {
   _signal                                  >> _frameCutter->input("signal");
   _frameCutter->output("frame")            >> _tensorflowInputVGGish->input("frame");
   _tensorflowInputVGGish->output("bands")  >> _vectorRealToTensor->input("frame");
-  _vectorRealToTensor->output("tensor")    >>  _tensorToPool->input("tensor");
-  _tensorToPool->output("pool")            >>  _tensorflowPredict->input("poolIn");
-  _tensorflowPredict->output("poolOut")    >>  _poolToTensor->input("pool");
-  _poolToTensor->output("tensor")          >>  _tensorToVectorReal->input("tensor");
+  _vectorRealToTensor->output("tensor")    >>  _predictor->input("tensor");
+  _predictor->output("tensor")             >>  _tensorToVectorReal->input("tensor");
 
   attach(_tensorToVectorReal->output("frame"), _predictions);
 
@@ -110,22 +106,28 @@ void TensorflowPredictVGGish::configure() {
   
   _configured = true;
 
+  configurePredictor();
+}
+
+
+Algorithm* TensorflowPredictVGGish::createPredictor() {
+  return AlgorithmFactory::create("TensorflowPredictTensor");
+}
+
+
+void TensorflowPredictVGGish::configurePredictor() {
   string input = parameter("input").toString();
   string output = parameter("output").toString();
   string isTrainingName = parameter("isTrainingName").toString();
 
-  _tensorToPool->configure("namespace", input);
-
-  _poolToTensor->configure("namespace", output);
-
   string graphFilename = parameter("graphFilename").toString();
   string savedModel = parameter("savedModel").toString();
 
-  _tensorflowPredict->configure("graphFilename", graphFilename,
-                                "savedModel", savedModel,
-                                "inputs", vector<string>({input}),
-                                "outputs", vector<string>({output}),
-                                "isTrainingName", isTrainingName);
+  _predictor->configure("graphFilename", graphFilename,
+                        "savedModel", savedModel,
+                        "inputs", vector<string>({input}),
+                        "outputs", vector<string>({output}),
+                        "isTrainingName", isTrainingName);
 }
 
 } // namespace streaming
@@ -165,11 +167,15 @@ const char* TensorflowPredictVGGish::description = DOC(
   "3. Supported models at https://essentia.upf.edu/models/\n\n");
 
 
-TensorflowPredictVGGish::TensorflowPredictVGGish() {
+TensorflowPredictVGGish::TensorflowPredictVGGish()
+    : TensorflowPredictVGGish("TensorflowPredictVGGish") {}
+
+
+TensorflowPredictVGGish::TensorflowPredictVGGish(const char* streamingName) {
     declareInput(_signal, "signal", "the input audio signal sampled at 16 kHz");
     declareOutput(_predictions, "predictions", "the output values from the model node named after `output`");
 
-    createInnerNetwork();
+    createInnerNetwork(streamingName);
   }
 
 
@@ -178,28 +184,20 @@ TensorflowPredictVGGish::~TensorflowPredictVGGish() {
 }
 
 
-void TensorflowPredictVGGish::createInnerNetwork() {
-  _tensorflowPredictVGGish = streaming::AlgorithmFactory::create("TensorflowPredictVGGish");
+void TensorflowPredictVGGish::createInnerNetwork(const char* streamingName) {
+  _predictVGGish = streaming::AlgorithmFactory::create(streamingName);
   _vectorInput = new streaming::VectorInput<Real>();
 
-  *_vectorInput  >> _tensorflowPredictVGGish->input("signal");
-  _tensorflowPredictVGGish->output("predictions") >>  PC(_pool, "predictions");
+  *_vectorInput  >> _predictVGGish->input("signal");
+  _predictVGGish->output("predictions") >>  PC(_pool, "predictions");
 
   _network = new scheduler::Network(_vectorInput);
 }
 
 
 void TensorflowPredictVGGish::configure() {
-  _tensorflowPredictVGGish->configure(INHERIT("graphFilename"),
-                                      INHERIT("savedModel"),
-                                      INHERIT("input"),
-                                      INHERIT("output"),
-                                      INHERIT("isTrainingName"),
-                                      INHERIT("patchHopSize"),
-                                      INHERIT("accumulate"),
-                                      INHERIT("lastPatchMode"),
-                                      INHERIT("patchSize"),
-                                      INHERIT("batchSize"));
+  // The streaming algorithm takes the same parameters.
+  _predictVGGish->configure(_params);
 }
 
 
@@ -208,7 +206,7 @@ void TensorflowPredictVGGish::compute() {
   vector<vector<Real> >& predictions = _predictions.get();
 
   if (!signal.size()) {
-    throw EssentiaException("TensorflowPredictVGGish: empty input signal");
+    throw EssentiaException(Configurable::name(), ": empty input signal");
   }
 
   _vectorInput->setVector(&signal);
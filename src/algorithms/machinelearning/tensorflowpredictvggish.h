@@ -34,9 +34,7 @@ class TensorflowPredictVGGish : public AlgorithmComposite {
   Algorithm* _frameCutter;
   Algorithm* _tensorflowInputVGGish;
   Algorithm* _vectorRealToTensor;
-  Algorithm* _tensorToPool;
-  Algorithm* _tensorflowPredict;
-  Algorithm* _poolToTensor;
+  Algorithm* _predictor;
   Algorithm* _tensorToVectorReal;
 
   SinkProxy<Real> _signal;
@@ -48,6 +46,11 @@ class TensorflowPredictVGGish : public AlgorithmComposite {
   void createInnerNetwork();
   void clearAlgos();
 
+  // The model is run by TensorflowPredictTensor. The wrappers of the same
+  // models for other backends override these (see OnnxPredictVGGish).
+  virtual Algorithm* createPredictor();
+  virtual void configurePredictor();
+
  public:
   TensorflowPredictVGGish();
   ~TensorflowPredictVGGish();
@@ -95,12 +98,15 @@ class TensorflowPredictVGGish : public Algorithm {
   Input<std::vector<Real> > _signal;
   Output<std::vector<std::vector<Real> > > _predictions;
 
-  streaming::Algorithm* _tensorflowPredictVGGish;
+  streaming::Algorithm* _predictVGGish;
   streaming::VectorInput<Real>* _vectorInput;
   scheduler::Network* _network;
   Pool _pool;
 
-  void createInnerNetwork();
+  // Wraps the streaming algorithm named @c streamingName, which is the one
+  // with the same name unless for the wrappers of other backends.
+  TensorflowPredictVGGish(const char* streamingName);
+  void createInnerNetwork(const char* streamingName);
 
  public:
   TensorflowPredictVGGish();
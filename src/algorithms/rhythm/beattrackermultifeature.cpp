@@ -35,9 +35,11 @@ BeatTrackerMultiFeature::BeatTrackerMultiFeature() : AlgorithmComposite(),
     _frameCutter1(0), _windowing1(0), _fft1(0), _cart2polar1(0), _onsetRms1(0),
     _onsetComplex1(0), _ticksRms1(0), _ticksComplex1(0), _onsetMelFlux1(0),
     _ticksMelFlux1(0), _onsetBeatEmphasis3(0), _ticksBeatEmphasis3(0),
-    _onsetInfogain4(0), _ticksInfogain4(0), _scale(0), _configured(false) {
+    _onsetInfogain4(0), _ticksInfogain4(0), _scale(0), _fftNetwork(0),
+    _configured(false), _computeFFT(true) {
 
   declareInput(_signal, 1024, "signal", "input signal");
+  declareInput(_fft, "fft", "the FFT of the input signal, only used if computeFFT is false. It must be computed on frames of 2048 samples with a hop size of 1024 (FrameCutter with startFromZero=true and silentFrames='keep') and a Hann window (Windowing with type='hann')");
   declareOutput(_ticks, 0, "ticks", "the estimated tick locations [s]");
   declareOutput(_confidence, "confidence", "confidence of the beat tracker [0, 5.32]");
 
@@ -50,9 +52,14 @@ void BeatTrackerMultiFeature::createInnerNetwork() {
   // internal algorithms
   AlgorithmFactory& factory = AlgorithmFactory::instance();
 
-  _frameCutter1         = factory.create("FrameCutter");
-  _windowing1           = factory.create("Windowing");
-  _fft1                 = factory.create("FFT");
+  if (_computeFFT) {
+    _frameCutter1       = factory.create("FrameCutter");
+    _windowing1         = factory.create("Windowing");
+    _fft1               = factory.create("FFT");
+  }
+  else {
+    _frameCutter1 = _windowing1 = _fft1 = 0;
+  }
   _cart2polar1          = factory.create("CartesianToPolar");
   _onsetRms1            = factory.create("OnsetDetection");
   _onsetComplex1        = factory.create("OnsetDetection");
@@ -77,10 +84,17 @@ void BeatTrackerMultiFeature::createInnerNetwork() {
   // Connect internal algorithms
   //_signal                                    >>   _frameCutter1->input("signal");
   _signal                                    >>   _scale->input("signal");
-  _scale->output("signal")                   >>   _frameCutter1->input("signal");
-  _frameCutter1->output("frame")             >>   _windowing1->input("frame");
-  _windowing1->output("frame")               >>   _fft1->input("frame");
-  _fft1->output("fft")                       >>   _cart2polar1->input("complex");
+  if (_computeFFT) {
+    _scale->output("signal")                 >>   _frameCutter1->input("signal");
+    _frameCutter1->output("frame")           >>   _windowing1->input("frame");
+    _windowing1->output("frame")             >>   _fft1->input("frame");
+    _fft1->output("fft")                     >>   _cart2polar1->input("complex");
+  }
+  else {
+    // the FFT is shared with the outside, this chain is scheduled on its own
+    // (see declareProcessOrder)
+    _fft                                     >>   _cart2polar1->input("complex");
+  }
   _cart2polar1->output("magnitude")          >>   _onsetComplex1->input("spectrum");
   _cart2polar1->output("phase")              >>   _onsetComplex1->input("phase");
   _cart2polar1->output("magnitude")          >>   _onsetRms1->input("spectrum");
@@ -106,12 +120,26 @@ void BeatTrackerMultiFeature::createInnerNetwork() {
   _ticksInfogain4->output("ticks")                  >> PC(_pool, "internal.ticksInfogain");
 
   _network = new scheduler::Network(_scale);
+  if (!_computeFFT) {
+    // not reachable from _scale, so it needs its own network to be deleted
+    _fftNetwork = new scheduler::Network(_cart2polar1);
+  }
+}
+
+// the 'fft' input is not attached to anything when the FFT is computed
+// internally, so a connected source would never be read
+void BeatTrackerMultiFeature::checkFFTInput(bool computeFFT) {
+  if (computeFFT && _fft.source()) {
+    throw EssentiaException("BeatTrackerMultiFeature: the 'fft' input is connected, but it is only used if computeFFT is false");
+  }
 }
 
 void BeatTrackerMultiFeature::clearAlgos() {
   if (!_configured) return;
 
   delete _network;
+  delete _fftNetwork;
+  _fftNetwork = 0;
   delete _tempoTapMaxAgreement;
 }
 
@@ -122,6 +150,8 @@ BeatTrackerMultiFeature::~BeatTrackerMultiFeature() {
 
 
 void BeatTrackerMultiFeature::configure() {
+  checkFFTInput(parameter("computeFFT").toBool());
+
   if (_configured) {
     clearAlgos();
   }
@@ -130,6 +160,7 @@ void BeatTrackerMultiFeature::configure() {
   // RhythmExtractor does with sampleRate parameter
 
   //_sampleRate   = parameter("sampleRate").toReal();
+  _computeFFT = parameter("computeFFT").toBool();
   createInnerNetwork();
 
   // Configure internal algorithms
@@ -147,13 +178,15 @@ void BeatTrackerMultiFeature::configure() {
   _scale->configure("factor", 1., 
                     "clipping", false);
 
-  _frameCutter1->configure("frameSize", frameSize1,
-                          "hopSize", hopSize1,
-                          "silentFrames", "keep",
-                          "startFromZero", true);
+  if (_computeFFT) {
+    _frameCutter1->configure("frameSize", frameSize1,
+                             "hopSize", hopSize1,
+                             "silentFrames", "keep",
+                             "startFromZero", true);
 
-  _windowing1->configure("size", frameSize1, "type", "hann");
-  _fft1->configure("size", frameSize1);
+    _windowing1->configure("size", frameSize1, "type", "hann");
+    _fft1->configure("size", frameSize1);
+  }
   _onsetComplex1->configure("method", "complex");
   _onsetRms1->configure("method", "rms");
   _onsetMelFlux1->configure("method", "melflux");
@@ -268,6 +301,8 @@ const char* BeatTrackerMultiFeature::description = DOC("This algorithm estimates
 "  - (1.5, 3.5]  good confidence, accuracy around 80% in AMLt measure\n"
 "  - (3.5, 5.32] excellent confidence\n"
 "\n"
+"In streaming mode, the FFT used by the first three detection functions can be computed outside of the algorithm and given through the 'fft' input (set the 'computeFFT' parameter to false), so that it can be shared with other algorithms instead of being computed twice. It must be computed with the same settings as the internal one: frames of 2048 samples with a hop size of 1024 samples (FrameCutter with startFromZero=true and silentFrames='keep'), a Hann window (Windowing with type='hann') and the FFT algorithm. The 'signal' input is still needed by the other detection functions.\n"
+"\n"
 "Note that the algorithm requires the audio input with the 44100 Hz sampling rate in order to function correctly.\n"
 "\n"
 "References:\n"
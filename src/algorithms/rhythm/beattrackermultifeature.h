@@ -24,6 +24,7 @@
 #include "pool.h"
 #include "algorithm.h"
 #include "network.h"
+#include <complex>
 
 namespace essentia {
 namespace streaming {
@@ -32,6 +33,7 @@ class BeatTrackerMultiFeature : public AlgorithmComposite {
 
  protected:
   SinkProxy<Real>_signal;
+  SinkProxy<std::vector<std::complex<Real> > > _fft;
   Source<Real> _ticks;
   Source<Real> _confidence;
 
@@ -60,9 +62,12 @@ class BeatTrackerMultiFeature : public AlgorithmComposite {
   Algorithm* _scale;
 
   scheduler::Network* _network;
+  scheduler::Network* _fftNetwork;
   bool _configured;
+  bool _computeFFT;
 
   void createInnerNetwork();
+  void checkFFTInput(bool computeFFT);
   void clearAlgos();
   Real _sampleRate;
 
@@ -75,10 +80,14 @@ class BeatTrackerMultiFeature : public AlgorithmComposite {
     //declareParameter("sampleRate", "the sampling rate of the audio signal [Hz]", "(0,inf)", 44100.);
     declareParameter("maxTempo", "the fastest tempo to detect [bpm]", "[60,250]", 208);
     declareParameter("minTempo", "the slowest tempo to detect [bpm]", "[40,180]", 40);
+    declareParameter("computeFFT", "whether to compute the FFT used by the 'complex', 'rms' and 'melflux' detection functions internally, or to take it from the 'fft' input instead (set to false to share the FFT with other algorithms)", "{true,false}", true);
   }
 
   void declareProcessOrder() {
+    // the 'fft' input may have been connected after configure()
+    checkFFTInput(_computeFFT);
     declareProcessStep(ChainFrom(_scale));
+    if (!_computeFFT) declareProcessStep(ChainFrom(_cart2polar1));
     declareProcessStep(SingleShot(this));
   }
 
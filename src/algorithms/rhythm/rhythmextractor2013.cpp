@@ -38,6 +38,7 @@ RhythmExtractor2013::RhythmExtractor2013() : AlgorithmComposite() {
   _configured = false;
 
   declareInput(_signal, "signal", "input signal");
+  declareInput(_fft, "fft", "the FFT of the input signal, only used if computeFFT is false (see the 'fft' input of BeatTrackerMultiFeature)");
 
   declareOutput(_ticks, "ticks", "the estimated tick locations [s]");
   declareOutput(_confidence, "confidence", "confidence with which the ticks are detected (ignore this value if using 'degara' method)");
@@ -66,6 +67,9 @@ void RhythmExtractor2013::createInnerNetwork() {
 
   // Connect internal algorithms
   _signal                           >>  _beatTracker->input("signal");
+  if (!_computeFFT) {
+    _fft                            >>  _beatTracker->input("fft");
+  }
   //_beatTracker->output("ticks")     >>  _ticks;
   _beatTracker->output("ticks")     >>  PC(_pool, "internal.ticks");
 
@@ -83,6 +87,14 @@ RhythmExtractor2013::~RhythmExtractor2013() {
   clearAlgos();
 }
 
+// the 'fft' input is not attached to anything when the beat tracker computes
+// its FFT, so a connected source would never be read
+void RhythmExtractor2013::checkFFTInput(bool computeFFT) {
+  if (computeFFT && _fft.source()) {
+    throw EssentiaException("RhythmExtractor2013: the 'fft' input is connected, but it is only used if computeFFT is false");
+  }
+}
+
 void RhythmExtractor2013::clearAlgos() {
   if (!_configured) return;
   delete _network;
@@ -90,16 +102,32 @@ void RhythmExtractor2013::clearAlgos() {
 }
 
 void RhythmExtractor2013::configure() {
+  // check the parameters before deleting the inner algorithms, so that they
+  // are still valid if configure() fails
+  bool computeFFT = parameter("computeFFT").toBool();
+  if (!computeFFT && parameter("method").toLower() != "multifeature") {
+    throw EssentiaException("RhythmExtractor2013: the FFT can only be given through the 'fft' input with the 'multifeature' method");
+  }
+  checkFFTInput(computeFFT);
+
    if (_configured) {
     clearAlgos();
   }
 
   _periodTolerance = 5.;
 
+  _computeFFT = computeFFT;
+
   createInnerNetwork();
 
   // Configure internal algorithms
-  _beatTracker->configure(INHERIT("minTempo"), INHERIT("maxTempo"));
+  if (_method == "multifeature") {
+    _beatTracker->configure(INHERIT("minTempo"), INHERIT("maxTempo"),
+                            INHERIT("computeFFT"));
+  }
+  else {
+    _beatTracker->configure(INHERIT("minTempo"), INHERIT("maxTempo"));
+  }
   _configured = true;
 
 }
@@ -207,6 +235,8 @@ const char* RhythmExtractor2013::description = DOC("This algorithm extracts the
 "\n"
 "See BeatTrackerMultiFeature and BeatTrackerDegara algorithms for more details.\n"
 "\n"
+"In streaming mode with the 'multifeature' method, the FFT used by the beat tracker can be given through the 'fft' input (set the 'computeFFT' parameter to false) to share it with other algorithms. See BeatTrackerMultiFeature for the settings it must be computed with.\n"
+"\n"
 "Note that the algorithm requires the sample rate of the input signal to be 44100 Hz in order to work correctly.\n");
 
 
@@ -24,6 +24,7 @@
 #include "pool.h"
 #include "algorithm.h"
 #include "network.h"
+#include <complex>
 
 namespace essentia {
 namespace streaming {
@@ -32,6 +33,7 @@ class RhythmExtractor2013 : public AlgorithmComposite {
 
  protected:
   SinkProxy<Real> _signal;
+  SinkProxy<std::vector<std::complex<Real> > > _fft;
 
   Source<std::vector<Real> > _ticks;
   Source<Real> _confidence;
@@ -53,8 +55,10 @@ class RhythmExtractor2013 : public AlgorithmComposite {
   scheduler::Network* _network;
 
   std::string _method;
+  bool _computeFFT;
   bool _configured;
   void createInnerNetwork();
+  void checkFFTInput(bool computeFFT);
   void clearAlgos();
 
  public:
@@ -67,9 +71,12 @@ class RhythmExtractor2013 : public AlgorithmComposite {
     declareParameter("method", "the method used for beat tracking", "{multifeature,degara}", "multifeature");
     declareParameter("maxTempo", "the fastest tempo to detect [bpm]", "[60,250]", 208);
     declareParameter("minTempo", "the slowest tempo to detect [bpm]", "[40,180]", 40);
+    declareParameter("computeFFT", "whether to let the beat tracker compute its FFT, or to take it from the 'fft' input instead (only for the 'multifeature' method, see BeatTrackerMultiFeature)", "{true,false}", true);
   }
 
   void declareProcessOrder() {
+    // the 'fft' input may have been connected after configure()
+    checkFFTInput(_computeFFT);
     declareProcessStep(ChainFrom(_beatTracker));
     declareProcessStep(SingleShot(this));
   }
@@ -18,6 +18,7 @@
  */
 
 #include "erbbands.h"
+#include <sstream>
 
 using namespace std;
 using namespace essentia;
@@ -77,12 +78,26 @@ void ERBBands::createFilters(int spectrumSize) {
     throw EssentiaException("ERBBands: Filter bank cannot be computed from a spectrum with less than 2 bins");
   }
 
+  // share the filterbank with all the instances configured the same way
+  ostringstream key;
+  key.precision(10);
+  key << "ERBBands " << spectrumSize << " " << _sampleRate << " " << _numberBands
+      << " " << _minFrequency << " " << _maxFrequency << " " << _width;
+
+  _filterbank = SparseFilterbank::cached(key.str(), [this, spectrumSize]() {
+    vector<vector<Real> > filterCoefficients;
+    computeFilters(spectrumSize, filterCoefficients);
+    return SparseFilterbank::fromDense(filterCoefficients);
+  });
+}
+
+void ERBBands::computeFilters(int spectrumSize, vector<vector<Real> >& filterCoefficients) {
   int filterSize = _numberBands;
   vector<complex<Real> > ucirc = vector<complex<Real> >(spectrumSize);
   complex<Real> oneJ(0,1);
   Real order = 1;
   Real pi = Real(M_PI);
-  _filterCoefficients = vector<vector<Real> >(filterSize, vector<Real>(spectrumSize, 0.0));
+  filterCoefficients = vector<vector<Real> >(filterSize, vector<Real>(spectrumSize, 0.0));
   Real fftSize = (spectrumSize-1)*2;
   for (int i=0; i<spectrumSize; i++) {
  	  ucirc[i] = exp((oneJ*Real(2.0)*pi*Real(i))/fftSize);
@@ -132,7 +147,7 @@ void ERBBands::createFilters(int spectrumSize) {
                 Real(2)* cxExp + Real(2)*(Real(1) + cxExp)/exp(B*T)),Real(4)));
 
     for (int j=0; j<spectrumSize; j++) {
-      _filterCoefficients[i][j] = (pow(T,4)/filterGain) *
+      filterCoefficients[i][j] = (pow(T,4)/filterGain) *
             abs(ucirc[j]-zeros[0]) * abs(ucirc[j]-zeros[1]) *
             abs(ucirc[j]-zeros[2]) * abs(ucirc[j]-zeros[3]) *
             pow(abs((pole-ucirc[j])*(pole-ucirc[j])),(-GTord));
@@ -145,37 +160,17 @@ void ERBBands::compute() {
   const std::vector<Real>& spectrum = _spectrumInput.get();
   std::vector<Real>& bands = _bandsOutput.get();
 
-  int filterSize = _numberBands;
   int spectrumSize = spectrum.size();
 
-  if (_filterCoefficients.empty() ||
-      int(_filterCoefficients[0].size()) != spectrumSize) {
-    E_INFO("ERBBands: input spectrum size (" << spectrumSize << ") does not correspond to the \"inputSize\" parameter (" << _filterCoefficients[0].size() << "). Recomputing the filter bank.");
+  if (!_filterbank || _filterbank->spectrumSize() != spectrumSize) {
+    E_INFO("ERBBands: input spectrum size (" << spectrumSize << ") does not correspond to the \"inputSize\" parameter (" << (_filterbank ? _filterbank->spectrumSize() : 0) << "). Recomputing the filter bank.");
     createFilters(spectrumSize);
   }
 
-  bands.resize(filterSize);
-
-
   // NB: Band magnitudes are returned, while BarkBands and MelBands algorithms
   // return energy. Gerard Roma have found magnitudes work better when
   // working with sound effects.  Band magnitudes option is required for 
   // OnsetDetectionGlobal algorithm.
 
-  if (_type=="magnitude") {
-    for (int i=0; i<filterSize; ++i) {
-      bands[i] = 0;
-      for (int j=0; j<spectrumSize; ++j) {
-        bands[i] += (spectrum[j]) * _filterCoefficients[i][j];
-      }
-    }
-  }
-  else if (_type=="power") {
-    for (int i=0; i<filterSize; ++i) {
-      bands[i] = 0;
-      for (int j=0; j<spectrumSize; ++j) {
-        bands[i] += (spectrum[j] * spectrum[j]) * _filterCoefficients[i][j];
-      }
-    }
-  }
+  _filterbank->apply(spectrum, bands, _type=="power");
 }
@@ -22,6 +22,7 @@
 
 #include "essentiamath.h"
 #include "algorithm.h"
+#include "sparsefilterbank.h"
 #include <complex>
 
 namespace essentia {
@@ -59,9 +60,10 @@ class ERBBands : public Algorithm {
  protected:
 
   void createFilters(int spectrumSize);
+  void computeFilters(int spectrumSize, std::vector<std::vector<Real> >& filterCoefficients);
   void calculateFilterFrequencies();
 
-  std::vector<std::vector<Real> > _filterCoefficients;
+  std::shared_ptr<const SparseFilterbank> _filterbank;
   std::vector<Real> _filterFrequencies;
   int _numberBands;
 
@@ -19,6 +19,7 @@
 
 #include "frequencybands.h"
 #include "essentiamath.h"
+#include <sstream>
 
 using namespace essentia;
 using namespace standard;
@@ -49,6 +50,10 @@ void FrequencyBands::configure() {
       throw EssentiaException("FrequencyBands: the values in the 'frequencyBands' parameter are not in ascending order or there exists a duplicate value");
     }
   }
+
+  // the filterbank depends on the size of the spectrum, so it is only created
+  // once the first spectrum arrives
+  _filterbank.reset();
 }
 
 void FrequencyBands::compute() {
@@ -59,31 +64,46 @@ void FrequencyBands::compute() {
     throw EssentiaException("FrequencyBands: the size of the input spectrum is not greater than one");
   }
 
-  Real frequencyscale = (_sampleRate / 2.0) / (spectrum.size() - 1);
-  int nBands = int(_bandFrequencies.size() - 1);
+  if (!_filterbank || _filterbank->spectrumSize() != int(spectrum.size())) {
+    createFilters(spectrum.size());
+  }
 
-  bands.resize(nBands);
-  std::fill(bands.begin(), bands.end(), (Real) 0.0);
+  _filterbank->apply(spectrum, bands, true);
 
-  for (int i=0; i<nBands; i++) {
-    int startBin = int(_bandFrequencies[i] / frequencyscale + 0.5);
-    int endBin = int(_bandFrequencies[i + 1] / frequencyscale + 0.5);
+  // decision: don't scale the bands in any way...
+  // this way, when summing the energy, we will get consistent *summed* results
+  // for different FFT-sizes, (with zero-overlap)
+}
 
-    if (startBin >= int(spectrum.size())) {
-      break;
-    }
+void FrequencyBands::createFilters(int spectrumSize) {
+  std::ostringstream key;
+  key.precision(10);
+  key << "FrequencyBands " << spectrumSize << " " << _sampleRate;
+  for (int i=0; i<(int)_bandFrequencies.size(); ++i) key << " " << _bandFrequencies[i];
 
-    if (endBin > int(spectrum.size())) {
-      endBin = spectrum.size();
-    }
+  _filterbank = SparseFilterbank::cached(key.str(), [this, spectrumSize]() {
+    std::shared_ptr<SparseFilterbank> filterbank = std::make_shared<SparseFilterbank>(spectrumSize);
 
-    for (int j=startBin; j<endBin; j++) {
-      Real magSquared = spectrum[j] * spectrum[j];
-      bands[i] += magSquared;
+    Real frequencyscale = (_sampleRate / 2.0) / (spectrumSize - 1);
+    int nBands = int(_bandFrequencies.size() - 1);
+
+    for (int i=0; i<nBands; i++) {
+      int startBin = int(_bandFrequencies[i] / frequencyscale + 0.5);
+      int endBin = int(_bandFrequencies[i + 1] / frequencyscale + 0.5);
+
+      // the bands above the spectrum are empty
+      if (startBin > spectrumSize) {
+        startBin = spectrumSize;
+      }
+
+      if (endBin > spectrumSize) {
+        endBin = spectrumSize;
+      }
+
+      // every bin in the band has a unit weight
+      filterbank->addBand(startBin, std::vector<Real>(std::max(endBin - startBin, 0), 1.0));
     }
-  }
 
-  // decision: don't scale the bands in any way...
-  // this way, when summing the energy, we will get consistent *summed* results
-  // for different FFT-sizes, (with zero-overlap)
+    return filterbank;
+  });
 }
@@ -22,6 +22,7 @@
 
 #include "algorithm.h"
 #include "essentiautil.h"
+#include "sparsefilterbank.h"
 
 namespace essentia {
 namespace standard {
@@ -58,6 +59,9 @@ class FrequencyBands : public Algorithm {
  protected:
   std::vector<Real> _bandFrequencies;
   Real _sampleRate;
+  std::shared_ptr<const SparseFilterbank> _filterbank;
+
+  void createFilters(int spectrumSize);
 };
 
 } // namespace standard
@@ -19,6 +19,7 @@
 
 #include "triangularbands.h"
 #include "essentiamath.h"
+#include <sstream>
 
 namespace essentia {
 namespace standard {
@@ -51,7 +52,8 @@ void TriangularBands::configure() {
   }
 
   _isLog = parameter("log").toBool();
-  setWeightingFunctions(parameter("weighting").toString());
+  _weighting = parameter("weighting").toString();
+  setWeightingFunctions(_weighting);
   createFilters(_inputSize);
 }
 
@@ -64,40 +66,34 @@ void TriangularBands::compute() {
     throw EssentiaException("TriangularBands: the size of the input spectrum is not greater than one");
   }
 
-  if (_filterCoefficients.empty() || _filterCoefficients[0].size() != spectrum.size()) {
-      E_INFO("TriangularBands: input spectrum size (" << spectrum.size() << ") does not correspond to the \"inputSize\" parameter (" << _filterCoefficients[0].size() << "). Recomputing the filter bank.");
+  if (!_filterbank || _filterbank->spectrumSize() != int(spectrum.size())) {
+      E_INFO("TriangularBands: input spectrum size (" << spectrum.size() << ") does not correspond to the \"inputSize\" parameter (" << (_filterbank ? _filterbank->spectrumSize() : 0) << "). Recomputing the filter bank.");
     createFilters(spectrum.size());
   }
 
-  Real frequencyScale = (_sampleRate / 2.0) / (spectrum.size() - 1);
+  // only the bins inside each triangle are stored in the filterbank
+  _filterbank->apply(spectrum, bands, _type == "power");
 
-  bands.resize(_nBands);
-  fill(bands.begin(), bands.end(), (Real) 0.0);
-
-  for (int i=0; i<_nBands; ++i) {
-
-    // Find margins for FFT bins to iterate through
-    // (all bins fall inside the triangle and therefore have non-zero weights).
-    int jbegin = ceil(_bandFrequencies[i] / frequencyScale);
-    int jend = floor(_bandFrequencies[i+2] / frequencyScale);
-
-    for (int j=jbegin; j<=jend; ++j) {
-
-      if (_type == "power") {
-        bands[i] += (spectrum[j] * spectrum[j]) * _filterCoefficients[i][j];
-      }
-
-      if (_type == "magnitude") {
-        bands[i] += (spectrum[j]) * _filterCoefficients[i][j];
-      }
-
-    }
-    if (_isLog) bands[i] = log2(1 + bands[i]);
+  if (_isLog) {
+    for (int i=0; i<_nBands; ++i) bands[i] = log2(1 + bands[i]);
   }
-  
 }
 
 void TriangularBands::createFilters(int spectrumSize) {
+  // the filterbank only depends on these parameters, so it can be shared with
+  // all the instances configured with the same ones
+  std::ostringstream key;
+  key.precision(10);
+  key << "TriangularBands " << spectrumSize << " " << _sampleRate << " "
+      << _weighting << " " << _normalize;
+  for (int i=0; i<(int)_bandFrequencies.size(); ++i) key << " " << _bandFrequencies[i];
+
+  _filterbank = SparseFilterbank::cached(key.str(), [this, spectrumSize]() {
+    return computeFilters(spectrumSize);
+  });
+}
+
+std::shared_ptr<SparseFilterbank> TriangularBands::computeFilters(int spectrumSize) {
   /*
   Calculate the filter coefficients...
   Basically what we're doing here is the following. Every filter is
@@ -120,7 +116,7 @@ void TriangularBands::createFilters(int spectrumSize) {
     throw EssentiaException("TriangularBands: Filter bank cannot be computed from a spectrum with less than 2 bins");
   }
 
-  _filterCoefficients = std::vector<std::vector<Real> >(_nBands, std::vector<Real>(spectrumSize, 0.0));
+  std::shared_ptr<SparseFilterbank> filterbank = std::make_shared<SparseFilterbank>(spectrumSize);
 
   Real frequencyScale = (_sampleRate / 2.0) / (spectrumSize - 1);
 
@@ -137,18 +133,22 @@ void TriangularBands::createFilters(int spectrumSize) {
       throw EssentiaException("TriangularBands: the 'frequencyBands' parameter contains a value above the Nyquist frequency (", _sampleRate/2, " Hz): ", _bandFrequencies.back());
     }
 
+    // only the weights of the bins inside the triangle are stored
+    std::vector<Real> coefficients(std::max(jend - jbegin + 1, 0), 0.0);
+
     Real weight = 0.;
     for (int j=jbegin; j<=jend; ++j) {
       Real binfreq = j*frequencyScale;
+      Real& coefficient = coefficients[j - jbegin];
       // in the ascending part of the triangle...
       if (binfreq < _bandFrequencies[i+1]) {
-        _filterCoefficients[i][j] = ((*_weighter)(binfreq) - (*_weighter)(_bandFrequencies[i])) / fstep1;
+        coefficient = ((*_weighter)(binfreq) - (*_weighter)(_bandFrequencies[i])) / fstep1;
       }
       // in the descending part of the triangle...
       else if (binfreq >= _bandFrequencies[i+1]) {
-        _filterCoefficients[i][j] = ((*_weighter)(_bandFrequencies[i+2]) - (*_weighter)(binfreq)) / fstep2;
+        coefficient = ((*_weighter)(_bandFrequencies[i+2]) - (*_weighter)(binfreq)) / fstep2;
       }
-      weight += _filterCoefficients[i][j];
+      weight += coefficient;
     }
 
     if (!weight) {
@@ -163,11 +163,15 @@ void TriangularBands::createFilters(int spectrumSize) {
     }
 
     if (_normalize == "unit_sum" || _normalize == "unit_tri") {
-      for (int j=jbegin; j<=jend; ++j) {
-        _filterCoefficients[i][j] = _filterCoefficients[i][j] / weight;
+      for (int j=0; j<(int)coefficients.size(); ++j) {
+        coefficients[j] = coefficients[j] / weight;
       }
     }
+
+    filterbank->addBand(jbegin, coefficients);
   }
+
+  return filterbank;
 }
 
 void TriangularBands::setWeightingFunctions(std::string weighting) {
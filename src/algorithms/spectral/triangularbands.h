@@ -22,6 +22,7 @@
 
 #include "algorithm.h"
 #include "essentiautil.h"
+#include "sparsefilterbank.h"
 
 namespace essentia {
 namespace standard {
@@ -37,11 +38,13 @@ class TriangularBands : public Algorithm {
   int _nBands;
   Real _sampleRate;
   bool _isLog;
-  std::vector<std::vector<Real> > _filterCoefficients;
+  std::shared_ptr<const SparseFilterbank> _filterbank;
   Real _inputSize;
   std::string _normalize;
   std::string _type;
+  std::string _weighting;
   void createFilters(int spectrumSize);
+  std::shared_ptr<SparseFilterbank> computeFilters(int spectrumSize);
   void setWeightingFunctions(std::string weighting);
 
   typedef  Real (*funcPointer)(Real);
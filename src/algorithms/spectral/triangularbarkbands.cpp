@@ -18,6 +18,7 @@
  */
 
 #include "triangularbarkbands.h"
+#include <sstream>
 
 using namespace std;
 using namespace essentia;
@@ -44,11 +45,26 @@ void TriangularBarkBands::configure() {
   _type = parameter("type").toString();
     
     _isLog = parameter("log").toBool();
-    calculateFilterCoefficients();
+    createFilters(parameter("inputSize").toInt());
 }
 
-void TriangularBarkBands::calculateFilterCoefficients() {
-    int nfft = (parameter("inputSize").toInt()-1)*2;
+void TriangularBarkBands::createFilters(int spectrumSize) {
+    // share the filterbank with all the instances configured the same way
+    ostringstream key;
+    key.precision(10);
+    key << "TriangularBarkBands " << spectrumSize << " " << _sampleRate << " " << _numBands
+        << " " << _normalization << " " << parameter("lowFrequencyBound").toReal()
+        << " " << parameter("highFrequencyBound").toReal();
+
+    _filterbank = SparseFilterbank::cached(key.str(), [this, spectrumSize]() {
+        vector<vector<Real> > filterCoefficients;
+        calculateFilterCoefficients(spectrumSize, filterCoefficients);
+        return SparseFilterbank::fromDense(filterCoefficients);
+    });
+}
+
+void TriangularBarkBands::calculateFilterCoefficients(int spectrumSize, vector<vector<Real> >& filterCoefficients) {
+    int nfft = (spectrumSize-1)*2;
     int nfilts = _numBands;
     int sr = _sampleRate;
     float width = 1.0;
@@ -62,7 +78,7 @@ void TriangularBarkBands::calculateFilterCoefficients() {
     if(nfilts == 0)
         nfilts = ceil(nyqbark)+1;
     
-    _filterCoefficients.resize(nfilts);
+    filterCoefficients.resize(nfilts);
     
     float step_barks = nyqbark/(nfilts-1);
     
@@ -74,7 +90,7 @@ void TriangularBarkBands::calculateFilterCoefficients() {
         binbarks.push_back(_hz2bark((float)i*srOverNFFT));
     
     for(int i=0; i<nfilts; i++)
-        _filterCoefficients[i].resize(binbarks.size());
+        filterCoefficients[i].resize(binbarks.size());
     
     for(int i = 0; i < nfilts; i++)
     {
@@ -87,7 +103,7 @@ void TriangularBarkBands::calculateFilterCoefficients() {
             
             double coeff = std::min((float)0, min((float)hif, (float)-2.5*lof)/width);
             
-            _filterCoefficients[i][j] = pow(10, coeff);
+            filterCoefficients[i][j] = pow(10, coeff);
         }
     }
     
@@ -97,13 +113,13 @@ void TriangularBarkBands::calculateFilterCoefficients() {
             Real weight = 0.0;
             
             for (int j=0; j<(int)binbarks.size(); ++j) {
-                weight += _filterCoefficients[i][j];
+                weight += filterCoefficients[i][j];
             }
             
             if (weight == 0) continue;
             
             for (int j=0; j<(int)binbarks.size(); ++j) {
-                _filterCoefficients[i][j] = _filterCoefficients[i][j] / weight;
+                filterCoefficients[i][j] = filterCoefficients[i][j] / weight;
             }
         }
     }    
@@ -118,30 +134,45 @@ void TriangularBarkBands::compute() {
         throw EssentiaException("TriangularBands: the size of the input spectrum is not greater than one");
     }
     
-    int filterSize = _numBands;
     int spectrumSize = spectrum.size();
     
-    if (_filterCoefficients.empty() || int(_filterCoefficients[0].size()) != spectrumSize) {
-        E_INFO("TriangularBarkBands: input spectrum size (" << spectrumSize << ") does not correspond to the \"inputSize\" parameter (" << _filterCoefficients[0].size() << "). Recomputing the filter bank.");
-        calculateFilterCoefficients();
+    if (!_filterbank || _filterbank->spectrumSize() != spectrumSize) {
+        E_INFO("TriangularBarkBands: input spectrum size (" << spectrumSize << ") does not correspond to the \"inputSize\" parameter (" << (_filterbank ? _filterbank->spectrumSize() : 0) << "). Recomputing the filter bank.");
+        createFilters(spectrumSize);
     }
 
-    bands.resize(_numBands);
-    fill(bands.begin(), bands.end(), (Real) 0.0);
-    
-    for (int i=0; i<filterSize; ++i) {
-        for (int j=0; j<(int)spectrum.size(); ++j) {
-            if (_type == "power"){
-                bands[i] += (spectrum[j] * spectrum[j]) * _filterCoefficients[i][j];
-            }
-            
-            if (_type == "magnitude"){
-                bands[i] += (spectrum[j]) * _filterCoefficients[i][j];
-            }
-            
-            if (_isLog)
-                bands[i] = log2(1 + bands[i]);
+    if (_isLog) {
+        computeLogBands(spectrum, bands);
+        return;
+    }
+
+    _filterbank->apply(spectrum, bands, _type == "power");
+}
+
+void TriangularBarkBands::computeLogBands(const vector<Real>& spectrum, vector<Real>& bands) {
+    // the log is applied to the energy of the band after adding each bin, as
+    // it has always been done. The bins before the band leave the energy at
+    // zero, but the log is still applied once per bin after it
+    int nBands = _filterbank->numberBands();
+    int spectrumSize = _filterbank->spectrumSize();
+    bool power = _type == "power";
+
+    bands.resize(nBands);
+    for (int i=0; i<nBands; ++i) {
+        int start = _filterbank->bandStart(i);
+        int size = _filterbank->bandSize(i);
+        const Real* weights = _filterbank->bandWeights(i);
+
+        Real band = 0;
+        for (int k=0; k<size; ++k) {
+            Real bin = spectrum[start + k];
+            band += (power ? bin * bin : bin) * weights[k];
+            band = log2(1 + band);
+        }
+        for (int j=start+size; j<spectrumSize; ++j) {
+            band = log2(1 + band);
         }
+        bands[i] = band;
     }
 }
 
@@ -23,6 +23,7 @@
 #include "essentiamath.h"
 #include "algorithm.h"
 #include "algorithmfactory.h"
+#include "sparsefilterbank.h"
 #include <cmath>
 
 
@@ -74,10 +75,12 @@ class TriangularBarkBands : public Algorithm {
 
  protected:
   
-  void calculateFilterCoefficients();
+  void createFilters(int spectrumSize);
+  void computeLogBands(const std::vector<Real>& spectrum, std::vector<Real>& bands);
+  void calculateFilterCoefficients(int spectrumSize, std::vector<std::vector<Real> >& filterCoefficients);
   void setWarpingFunctions(std::string warping, std::string weighting);
 
-  std::vector<std::vector<Real> > _filterCoefficients;
+  std::shared_ptr<const SparseFilterbank> _filterbank;
   int _numBands;
   Real _sampleRate;
 
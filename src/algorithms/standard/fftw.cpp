@@ -36,6 +36,113 @@ const char* FFTW::description = DOC("This algorithm computes the positive comple
 "  http://mathworld.wolfram.com/FastFourierTransform.html");
 
 ForcedMutex FFTW::globalFFTWMutex;
+map<pair<int, int>, fftwf_plan> FFTW::_planCache;
+unsigned int FFTW::_plannerFlags = FFTW_ESTIMATE;
+
+
+fftwf_plan FFTW::plan(int size, PlanType type) {
+  ForcedMutexLocker lock(globalFFTWMutex);
+
+  pair<int, int> key(size, (int)type);
+  map<pair<int, int>, fftwf_plan>::const_iterator it = _planCache.find(key);
+  if (it != _planCache.end()) return it->second;
+
+  // plan on scratch arrays, as some planner flags overwrite them. They are
+  // allocated with fftwf_malloc, so they have the same alignment as the arrays
+  // the plan will be executed on
+  fftwf_complex* in = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex)*size);
+  fftwf_complex* out = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex)*size);
+
+  fftwf_plan p = 0;
+  switch (type) {
+    case REAL_FORWARD:
+      p = fftwf_plan_dft_r2c_1d(size, (float*)in, out, _plannerFlags);
+      break;
+    case REAL_BACKWARD:
+      p = fftwf_plan_dft_c2r_1d(size, in, (float*)out, _plannerFlags);
+      break;
+    case COMPLEX_FORWARD:
+      p = fftwf_plan_dft_1d(size, in, out, FFTW_FORWARD, _plannerFlags);
+      break;
+    case COMPLEX_BACKWARD:
+      p = fftwf_plan_dft_1d(size, in, out, FFTW_BACKWARD, _plannerFlags);
+      break;
+  }
+
+  fftwf_free(in);
+  fftwf_free(out);
+
+  if (!p) {
+    throw EssentiaException("FFT: could not create FFTW plan of size ", size);
+  }
+
+  _planCache[key] = p;
+  return p;
+}
+
+void FFTW::clearPlanCache() {
+  ForcedMutexLocker lock(globalFFTWMutex);
+
+  for (map<pair<int, int>, fftwf_plan>::iterator it = _planCache.begin(); it != _planCache.end(); ++it) {
+    fftwf_destroy_plan(it->second);
+  }
+  _planCache.clear();
+}
+
+void FFTW::setPlannerFlags(unsigned int flags) {
+  ForcedMutexLocker lock(globalFFTWMutex);
+  _plannerFlags = flags;
+}
+
+unsigned int FFTW::plannerFlags() {
+  ForcedMutexLocker lock(globalFFTWMutex);
+  return _plannerFlags;
+}
+
+void FFTW::setPlannerRigor(const string& rigor) {
+  unsigned int flags;
+  if      (rigor == "estimate")   flags = FFTW_ESTIMATE;
+  else if (rigor == "measure")    flags = FFTW_MEASURE;
+  else if (rigor == "patient")    flags = FFTW_PATIENT;
+  else if (rigor == "exhaustive") flags = FFTW_EXHAUSTIVE;
+  else {
+    throw EssentiaException("FFT: unknown planner rigor '", rigor, "', should be one of: estimate, measure, patient, exhaustive");
+  }
+
+  setPlannerFlags(flags);
+}
+
+string FFTW::plannerRigor() {
+  unsigned int flags = plannerFlags();
+  // FFTW_MEASURE is 0, so look for the other rigor flags first
+  if (flags & FFTW_ESTIMATE)   return "estimate";
+  if (flags & FFTW_EXHAUSTIVE) return "exhaustive";
+  if (flags & FFTW_PATIENT)    return "patient";
+  return "measure";
+}
+
+void FFTW::importWisdom(const string& filename) {
+  // the planner and the wisdom are not thread-safe in FFTW
+  ForcedMutexLocker lock(globalFFTWMutex);
+
+  if (!fftwf_import_wisdom_from_filename(filename.c_str())) {
+    throw EssentiaException("FFT: could not import FFTW wisdom from '", filename, "'");
+  }
+}
+
+void FFTW::exportWisdom(const string& filename) {
+  ForcedMutexLocker lock(globalFFTWMutex);
+
+  if (!fftwf_export_wisdom_to_filename(filename.c_str())) {
+    throw EssentiaException("FFT: could not export FFTW wisdom to '", filename, "'");
+  }
+}
+
+void FFTW::forgetWisdom() {
+  ForcedMutexLocker lock(globalFFTWMutex);
+  fftwf_forget_wisdom();
+}
+
 
 FFTW::~FFTW() {
   ForcedMutexLocker lock(globalFFTWMutex);
@@ -44,8 +151,8 @@ FFTW::~FFTW() {
   // of scope, so make sure we're not doing stupid things here
   // This will cause a memory leak then, but it is definitely a better choice
   // than a crash (right, right??? :-) )
+  // The plan belongs to the plan cache and is not destroyed here.
   if (essentia::isInitialized()) {
-    fftwf_destroy_plan(_fftPlan);
     fftwf_free(_input);
     fftwf_free(_output);
   }
@@ -71,7 +178,7 @@ void FFTW::compute() {
   memcpy(_input, &signal[0], size*sizeof(Real));
 
   // calculate the fft
-  fftwf_execute(_fftPlan);
+  fftwf_execute_dft_r2c(_fftPlan, _input, (fftwf_complex*)_output);
 
   // copy result from plan to output vector
   fft.resize(size/2+1);
@@ -84,8 +191,6 @@ void FFTW::configure() {
 }
 
 void FFTW::createFFTObject(int size) {
-  ForcedMutexLocker lock(globalFFTWMutex);
-
   // This is only needed because at the moment we return half of the spectrum,
   // which means that there are 2 different input signals that could yield the
   // same FFT...
@@ -93,16 +198,14 @@ void FFTW::createFFTObject(int size) {
     throw EssentiaException("FFT: can only compute FFT of arrays which have an even size");
   }
 
+  _fftPlan = plan(size, REAL_FORWARD);
+  _fftPlanSize = size;
+
+  ForcedMutexLocker lock(globalFFTWMutex);
+
   // create the temporary storage array
   fftwf_free(_input);
   fftwf_free(_output);
   _input = (Real*)fftwf_malloc(sizeof(Real)*size);
   _output = (complex<Real>*)fftwf_malloc(sizeof(complex<Real>)*size);
-
-  if (_fftPlan != 0) {
-    fftwf_destroy_plan(_fftPlan);
-  }
-
-  _fftPlan = fftwf_plan_dft_r2c_1d(size, _input, (fftwf_complex*)_output, FFTW_ESTIMATE);
-  _fftPlanSize = size;
 }
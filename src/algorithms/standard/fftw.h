@@ -23,6 +23,7 @@
 #include "algorithm.h"
 #include "threading.h"
 #include <complex>
+#include <map>
 #include <fftw3.h>
 
 namespace essentia {
@@ -53,12 +54,80 @@ class FFTW : public Algorithm {
   static const char* category;
   static const char* description;
 
+  /**
+   * The kinds of transforms for which plans can be cached.
+   */
+  enum PlanType {
+    REAL_FORWARD,     // FFT
+    REAL_BACKWARD,    // IFFT
+    COMPLEX_FORWARD,  // FFTC
+    COMPLEX_BACKWARD  // IFFTC
+  };
+
+  /**
+   * Returns the plan for a transform of the given size and type, creating it
+   * if it's the first time it is requested. Plans are shared by all the
+   * FFT/IFFT instances of the process and are never destroyed (unless
+   * clearPlanCache() is called), so that planning is only paid once per
+   * size and type, which makes it affordable to use more rigorous planner
+   * flags. A plan should only be executed using the new-array execute
+   * functions (fftwf_execute_dft_r2c, ...) on arrays allocated by fftwf_malloc.
+   */
+  static fftwf_plan plan(int size, PlanType type);
+
+  /**
+   * Destroys all the cached plans. No FFT/IFFT instance should be in use when
+   * calling this function, and they need to be reconfigured afterwards.
+   */
+  static void clearPlanCache();
+
+  /**
+   * Sets the planner flags (FFTW_ESTIMATE, FFTW_MEASURE, ...) used to create
+   * new plans. Default is FFTW_ESTIMATE. Plans already in the cache are not
+   * affected.
+   */
+  static void setPlannerFlags(unsigned int flags);
+  static unsigned int plannerFlags();
+
+  /**
+   * Sets the planner rigor by name: "estimate" (default), "measure", "patient"
+   * or "exhaustive". More rigorous planners take (much) longer to create a plan
+   * but may find faster ones. Plans already in the cache are not affected.
+   */
+  static void setPlannerRigor(const std::string& rigor);
+  static std::string plannerRigor();
+
+  /**
+   * Loads FFTW wisdom from the given file, so that plans measured in a
+   * previous run (see exportWisdom()) are created instantly instead of being
+   * measured again. Wisdom only applies to plans created with the same
+   * planner rigor or a lower one. Throws an exception if the file cannot be
+   * read or does not contain valid wisdom.
+   */
+  static void importWisdom(const std::string& filename);
+
+  /**
+   * Saves the wisdom accumulated so far (including the imported one) to the
+   * given file.
+   */
+  static void exportWisdom(const std::string& filename);
+
+  /**
+   * Forgets all the accumulated wisdom. Plans already in the cache are not
+   * affected.
+   */
+  static void forgetWisdom();
+
  protected:
   friend class IFFTW;
   friend class FFTWComplex;
   friend class IFFTWComplex;
   static ForcedMutex globalFFTWMutex;
 
+  // guarded by globalFFTWMutex
+  static std::map<std::pair<int, int>, fftwf_plan> _planCache;
+  static unsigned int _plannerFlags;
+
   fftwf_plan _fftPlan;
   int _fftPlanSize;
   Real* _input;
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "stft.h"
+#include <algorithm>
+
+using namespace std;
+using namespace essentia;
+using namespace standard;
+
+const char* STFT::name = "STFT";
+const char* STFT::category = "Spectral";
+const char* STFT::description = DOC("This algorithm computes the spectrum of a windowed audio frame. "
+"It yields the same results as the chain Windowing -> Spectrum (or PowerSpectrum, if spectrumType is 'power') with the same parameters, "
+"but without allocating or copying intermediate frames: the window is computed once and applied directly to the input of the FFT, "
+"and the magnitude (or power) and phase of the FFT are written directly to the outputs. "
+"Optionally, it also computes the phase spectrum, in radians, as CartesianToPolar does.\n"
+"\n"
+"The resulting spectrum has a size which is half the size of the windowed frame (the frame size plus the zero-padding) plus one. "
+"Frames of a size different from frameSize are accepted, but the window has to be recomputed every time the size of the frame changes.\n"
+"\n"
+"An exception is thrown if the size of the frame is less than 2, or if the size of the windowed frame is not supported by the FFT.\n"
+"\n"
+"References:\n"
+"  [1] Short-time Fourier transform - Wikipedia, the free encyclopedia,\n"
+"  https://en.wikipedia.org/wiki/Short-time_Fourier_transform");
+
+
+void STFT::configure() {
+  _zeroPadding = parameter("zeroPadding").toInt();
+  _zeroPhase = parameter("zeroPhase").toBool();
+  _splitPadding = parameter("splitPadding").toBool();
+  _power = parameter("spectrumType").toLower() == "power";
+  _computePhase = parameter("computePhase").toBool();
+
+  createKernel(parameter("frameSize").toInt());
+}
+
+void STFT::createKernel(int frameSize) {
+  _frameSize = frameSize;
+
+  // get the window from Windowing, by windowing a frame of ones without
+  // padding nor zero-phase
+  _windowing->configure("size", frameSize,
+                        "type", parameter("windowType"),
+                        "normalized", parameter("normalized"),
+                        "symmetric", parameter("symmetric"),
+                        "constantsDecimals", parameter("constantsDecimals"),
+                        "zeroPadding", 0,
+                        "zeroPhase", false,
+                        "splitPadding", false);
+
+  vector<Real> ones(frameSize, 1.0);
+  _windowing->input("frame").set(ones);
+  _windowing->output("frame").set(_window);
+  _windowing->compute();
+
+  // sample of the frame going to each position of the FFT input (-1 for the
+  // padding), laid out in the same way as Windowing does
+  int size = frameSize + _zeroPadding;
+  vector<int> source(size, -1);
+  int i = 0;
+
+  if (_zeroPhase) {
+    for (int j=frameSize/2; j<frameSize; j++) source[i++] = j;
+    i += _zeroPadding;
+    for (int j=0; j<frameSize/2; j++) source[i++] = j;
+  }
+  else {
+    for (int j=0; j<frameSize; j++) source[i++] = j;
+  }
+
+  if (_splitPadding) {
+    int shift = frameSize + int(ceil(_zeroPadding / 2.0));
+    rotate(source.begin(), source.begin() + shift, source.end());
+  }
+
+  _runs.clear();
+  for (int k=0; k<size; k++) {
+    if (source[k] < 0) continue;
+
+    if (!_runs.empty() &&
+        _runs.back().dst + _runs.back().size == k &&
+        _runs.back().src + _runs.back().size == source[k]) {
+      _runs.back().size++;
+    }
+    else {
+      Run run = { k, source[k], 1 };
+      _runs.push_back(run);
+    }
+  }
+
+  // the padding is written only once here, compute() only overwrites the runs
+  _fftInput.assign(size, 0.0);
+
+  _fft->configure("size", size);
+  _fft->input("frame").set(_fftInput);
+  _fft->output("fft").set(_fftBuffer);
+}
+
+void STFT::computeFrame(const Real* frame, Real* spectrum, Real* phase) {
+  for (int r=0; r<(int)_runs.size(); r++) {
+    const Real* x = frame + _runs[r].src;
+    const Real* w = &_window[0] + _runs[r].src;
+    Real* y = &_fftInput[0] + _runs[r].dst;
+    const int n = _runs[r].size;
+    for (int j=0; j<n; j++) y[j] = x[j] * w[j];
+  }
+
+  _fft->compute();
+
+  const int nBins = int(_fftBuffer.size());
+  const complex<Real>* c = &_fftBuffer[0];
+
+  if (_power) {
+    for (int i=0; i<nBins; i++) {
+      spectrum[i] = c[i].real()*c[i].real() + c[i].imag()*c[i].imag();
+    }
+  }
+  else {
+    for (int i=0; i<nBins; i++) {
+      spectrum[i] = sqrt(c[i].real()*c[i].real() + c[i].imag()*c[i].imag());
+    }
+  }
+
+  if (phase) {
+    for (int i=0; i<nBins; i++) {
+      phase[i] = atan2(c[i].imag(), c[i].real());
+    }
+  }
+}
+
+void STFT::compute() {
+  const vector<Real>& frame = _frame.get();
+  vector<Real>& spectrum = _spectrum.get();
+  vector<Real>& phase = _phase.get();
+
+  if (frame.size() <= 1) {
+    throw EssentiaException("STFT: frame size should be larger than 1");
+  }
+
+  if (int(frame.size()) != _frameSize) {
+    createKernel(int(frame.size()));
+  }
+
+  spectrum.resize(spectrumSize());
+
+  if (_computePhase) {
+    phase.resize(spectrumSize());
+    computeFrame(&frame[0], &spectrum[0], &phase[0]);
+  }
+  else {
+    phase.clear();
+    computeFrame(&frame[0], &spectrum[0], 0);
+  }
+}
+
+void STFT::computeFrames(const Real* frames, int nFrames, int stride,
+                         Real* spectrum, Real* phase) {
+  if (_computePhase && !phase) {
+    throw EssentiaException("STFT: computePhase is true but no storage was given for the phase");
+  }
+
+  const int nBins = spectrumSize();
+
+  for (int i=0; i<nFrames; i++) {
+    computeFrame(frames + ptrdiff_t(i)*stride,
+                 spectrum + ptrdiff_t(i)*nBins,
+                 _computePhase ? phase + ptrdiff_t(i)*nBins : 0);
+  }
+}
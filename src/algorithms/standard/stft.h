@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_STFT_H
+#define ESSENTIA_STFT_H
+
+#include "algorithmfactory.h"
+#include <complex>
+
+namespace essentia {
+namespace standard {
+
+class STFT : public Algorithm {
+
+ protected:
+  Input<std::vector<Real> > _frame;
+  Output<std::vector<Real> > _spectrum;
+  Output<std::vector<Real> > _phase;
+
+  Algorithm* _windowing;
+  Algorithm* _fft;
+
+  // input and output of the FFT, allocated once per frame size
+  std::vector<Real> _fftInput;
+  std::vector<std::complex<Real> > _fftBuffer;
+
+  // a run of consecutive samples of the frame which are windowed into
+  // consecutive positions of the FFT input (the other positions are the
+  // zero-padding, which never changes)
+  struct Run {
+    int dst;
+    int src;
+    int size;
+  };
+
+  std::vector<Real> _window;
+  std::vector<Run> _runs;
+  int _frameSize;
+  int _zeroPadding;
+  bool _zeroPhase;
+  bool _splitPadding;
+  bool _power;
+  bool _computePhase;
+
+  void createKernel(int frameSize);
+  void computeFrame(const Real* frame, Real* spectrum, Real* phase);
+
+ public:
+  STFT() : _frameSize(0) {
+    declareInput(_frame, "frame", "the input audio frame");
+    declareOutput(_spectrum, "spectrum", "the magnitude (or power) spectrum of the windowed frame");
+    declareOutput(_phase, "phase", "the phase spectrum of the windowed frame (empty if computePhase is false)");
+
+    _windowing = AlgorithmFactory::create("Windowing");
+    _fft = AlgorithmFactory::create("FFT");
+  }
+
+  ~STFT() {
+    delete _windowing;
+    delete _fft;
+  }
+
+  void declareParameters() {
+    declareParameter("frameSize", "the expected size of the input frame. Frames of a different size are accepted but require recomputing the window", "[2,inf)", 1024);
+    declareParameter("zeroPadding", "the size of the zero-padding", "[0,inf)", 0);
+    declareParameter("windowType", "the window type", "{hamming,hann,hannnsgcq,triangular,square,blackmanharris62,blackmanharris70,blackmanharris74,blackmanharris92}", "hann");
+    declareParameter("zeroPhase", "a boolean value that enables zero-phase windowing", "{true,false}", true);
+    declareParameter("normalized", "a boolean value to specify whether to normalize windows (to have an area of 1) and then scale by a factor of 2", "{true,false}", true);
+    declareParameter("splitPadding", "whether to split the padding to the edges of the signal (_/\\_) or to add it to the right (/\\__). See Windowing", "{true,false}", false);
+    declareParameter("symmetric", "whether to create a symmetric or asymmetric window as implemented in SciPy", "{true,false}", true);
+    declareParameter("constantsDecimals", "number of decimals considered in the constants for the formulation of the hamming and blackmanharris* windows ", "[1,5]", 5);
+    declareParameter("spectrumType", "whether to output the magnitude spectrum or the power spectrum", "{magnitude,power}", "magnitude");
+    declareParameter("computePhase", "whether to compute the phase spectrum", "{true,false}", false);
+  }
+
+  void configure();
+  void compute();
+
+  /**
+   * Computes the spectrum of @c nFrames frames of frameSize samples, the i-th
+   * one starting at @c frames + i*stride, and writes them to the rows of
+   * @c spectrum (and of @c phase, if computePhase is true), which must have
+   * room for nFrames rows of frameSize/2 + zeroPadding/2 + 1 bins. Passing the
+   * hop size as the stride computes the STFT of a whole signal without
+   * cutting it into frames first.
+   */
+  void computeFrames(const Real* frames, int nFrames, int stride,
+                     Real* spectrum, Real* phase=0);
+
+  /**
+   * Returns the number of bins of the spectrum of a frame of the configured
+   * frame size.
+   */
+  int spectrumSize() const { return (_frameSize + _zeroPadding) / 2 + 1; }
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+
+};
+
+} // namespace standard
+} // namespace essentia
+
+#include "streamingalgorithmwrapper.h"
+
+namespace essentia {
+namespace streaming {
+
+class STFT : public StreamingAlgorithmWrapper {
+
+ protected:
+  Sink<std::vector<Real> > _frame;
+  Source<std::vector<Real> > _spectrum;
+  Source<std::vector<Real> > _phase;
+
+ public:
+  STFT() {
+    declareAlgorithm("STFT");
+    declareInput(_frame, TOKEN, "frame");
+    declareOutput(_spectrum, TOKEN, "spectrum");
+    declareOutput(_phase, TOKEN, "phase");
+  }
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_STFT_H
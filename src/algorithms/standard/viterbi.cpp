@@ -21,8 +21,226 @@
 #include "essentiamath.h"
 
 using namespace std;
-using namespace essentia;
-using namespace standard;
+
+namespace essentia {
+
+void ViterbiDecoder::setModel(const vector<Real>& initialization,
+                              const vector<int>& from,
+                              const vector<int>& to,
+                              const vector<Real>& transProb) {
+  int nState = initialization.size();
+  int nTrans = transProb.size();
+  if ((int)from.size() != nTrans || (int)to.size() != nTrans) {
+    throw EssentiaException("Viterbi: fromIndex, toIndex and transitionProbabilities must have the same size");
+  }
+
+  // counting sort of the transitions by destination, stable so that ties are
+  // resolved in favour of the first transition given, as in a plain loop over
+  // the transitions
+  _incomingStart.assign(nState + 1, 0);
+  for (int iTrans = 0; iTrans < nTrans; ++iTrans) {
+    if (from[iTrans] < 0 || from[iTrans] >= nState || to[iTrans] < 0 || to[iTrans] >= nState) {
+      throw EssentiaException("Viterbi: transition index out of range at transition ", iTrans);
+    }
+    _incomingStart[to[iTrans] + 1]++;
+  }
+  for (int iState = 0; iState < nState; ++iState) {
+    _incomingStart[iState + 1] += _incomingStart[iState];
+  }
+
+  _incomingFrom.resize(nTrans);
+  _incomingProb.resize(nTrans);
+  vector<int> next(_incomingStart.begin(), _incomingStart.end() - 1);
+  for (int iTrans = 0; iTrans < nTrans; ++iTrans) {
+    int k = next[to[iTrans]]++;
+    _incomingFrom[k] = from[iTrans];
+    _incomingProb[k] = transProb[iTrans];
+  }
+
+  _nState = nState;
+  _initialization = initialization;
+  _delta.assign(nState, 0.);
+  _oldDelta.assign(nState, 0.);
+  _visited.assign(nState, 0);
+  _visitStamp = 0;
+
+  reset();
+}
+
+void ViterbiDecoder::reset() {
+  _psi.clear();
+  _psiFirstFrame = 0;
+  _nFrame = 0;
+  _nDecided = 0;
+}
+
+void ViterbiDecoder::forwardStep(const vector<Real>& obs, bool skipImpossibleStates, int* psi) {
+  const int* incomingFrom = &_incomingFrom[0];
+  const double* incomingProb = &_incomingProb[0];
+
+  for (int toState = 0; toState < _nState; ++toState) {
+    // a state with a zero observation probability cannot be on the best path
+    // (unless all of them are, see addFrame()), except state 0 which is where
+    // the backward step goes when no transition has a non-zero probability
+    if (skipImpossibleStates && obs[toState] == 0 && toState > 0) {
+      _delta[toState] = 0;
+      psi[toState] = 0;
+      continue;
+    }
+
+    // calculate best previous state, reading the transitions to this state
+    // from contiguous memory
+    double bestValue = 0;
+    int bestFrom = 0;
+    for (int k = _incomingStart[toState]; k < _incomingStart[toState + 1]; ++k) {
+      double currentValue = _oldDelta[incomingFrom[k]] * incomingProb[k];
+      if (currentValue > bestValue) {
+        bestValue = currentValue;
+        bestFrom = incomingFrom[k];
+      }
+    }
+
+    _delta[toState] = bestValue * obs[toState];
+    psi[toState] = bestFrom;
+  }
+}
+
+void ViterbiDecoder::addFrame(const vector<Real>& obs) {
+  if (_nState == 0) {
+    throw EssentiaException("Viterbi: the model has not been set");
+  }
+  if ((int)obs.size() < _nState) {
+    throw EssentiaException("Viterbi: observation probabilities at frame ", _nFrame, " have less values than the number of states");
+  }
+
+  // the psi row of the first frame is never read, but it keeps the indexing simple
+  _psi.resize(_psi.size() + _nState, 0);
+  int* psi = psiRow(_nFrame);
+  _nFrame++;
+
+  double deltasum = 0;
+
+  if (_nFrame == 1) {
+    // initialise first frame
+    for (int iState = 0; iState < _nState; ++iState) {
+      _oldDelta[iState] = _initialization[iState] * obs[iState];
+      deltasum += _oldDelta[iState];
+    }
+
+    for (int iState = 0; iState < _nState; ++iState) {
+      _oldDelta[iState] /= deltasum; // normalise (scale)
+    }
+    return;
+  }
+
+  // states with a zero observation probability are skipped, as they can
+  // only be on the best path if all the states of this frame end up with
+  // a zero probability
+  forwardStep(obs, true, psi);
+
+  for (int jState = 0; jState < _nState; ++jState) {
+    deltasum += _delta[jState];
+  }
+
+  if (deltasum > 0) {
+    for (int iState = 0; iState < _nState; ++iState) {
+      _oldDelta[iState] = _delta[iState] / deltasum; // normalise (scale)
+    }
+  }
+  else {
+    E_WARNING("WARNING: Viterbi has been fed some zero probabilities, at least they become zero at frame " << _nFrame-1 << " in combination with the model.");
+
+    // the path can go through any state of this frame now, so we need
+    // the best transitions to all of them
+    forwardStep(obs, false, psi);
+    for (int iState = 0; iState < _nState; ++iState) {
+      _oldDelta[iState] = 1.0/_nState;
+    }
+  }
+}
+
+int ViterbiDecoder::bestState() const {
+  double bestValue = 0;
+  int best = 0;
+  for (int iState = 0; iState < _nState; ++iState) {
+    if (_oldDelta[iState] > bestValue) {
+      bestValue = _oldDelta[iState];
+      best = iState;
+    }
+  }
+  return best;
+}
+
+void ViterbiDecoder::backtrack(int frame, int state, vector<int>& path) {
+  // the states of the frames _nDecided..frame, given the one at frame
+  size_t offset = path.size();
+  path.resize(offset + frame - _nDecided + 1);
+  path.back() = state;
+  for (int iFrame = frame; iFrame > _nDecided; --iFrame) {
+    state = psiRow(iFrame)[state];
+    path[offset + iFrame-1 - _nDecided] = state;
+  }
+  _nDecided = frame + 1;
+
+  // forget the rows we won't need anymore, from time to time so that it
+  // takes amortized constant time per frame
+  int nDropped = _nDecided - _psiFirstFrame;
+  if (nDropped >= _nFrame - _nDecided) {
+    _psi.erase(_psi.begin(), _psi.begin() + (size_t)nDropped * _nState);
+    _psiFirstFrame = _nDecided;
+  }
+}
+
+void ViterbiDecoder::decide(vector<int>& path, int maxLag) {
+  if (numberUndecidedFrames() == 0) return;
+
+  // the states of the last frame that can still be on the best path, that is
+  // the ones with a non-zero probability, and state 0 (see forwardStep())
+  _states.clear();
+  for (int iState = 0; iState < _nState; ++iState) {
+    if (iState == 0 || _oldDelta[iState] > 0) _states.push_back(iState);
+  }
+
+  // follow all of them backwards until they merge into a single path
+  int frame = _nFrame - 1;
+  while (_states.size() > 1 && frame > _nDecided) {
+    const int* psi = psiRow(frame);
+    _visitStamp++;
+    _previousStates.clear();
+    for (int i = 0; i < (int)_states.size(); ++i) {
+      int previous = psi[_states[i]];
+      if (_visited[previous] != _visitStamp) {
+        _visited[previous] = _visitStamp;
+        _previousStates.push_back(previous);
+      }
+    }
+    _states.swap(_previousStates);
+    frame--;
+  }
+
+  if (_states.size() == 1) backtrack(frame, _states[0], path);
+
+  if (maxLag > 0 && numberUndecidedFrames() > maxLag) {
+    // decide the frames that are too old according to the current best path
+    int lastForced = _nFrame - 1 - maxLag;
+    int state = bestState();
+    for (int iFrame = _nFrame - 1; iFrame > lastForced; --iFrame) {
+      state = psiRow(iFrame)[state];
+    }
+    backtrack(lastForced, state, path);
+  }
+}
+
+void ViterbiDecoder::finish(vector<int>& path) {
+  if (numberUndecidedFrames() == 0) return;
+  backtrack(_nFrame - 1, bestState(), path);
+}
+
+} // namespace essentia
+
+
+namespace essentia {
+namespace standard {
 
 const char* Viterbi::name = "Viterbi";
 const char* Viterbi::category = "Statistics";
@@ -30,6 +248,8 @@ const char* Viterbi::description = DOC("This algorithm estimates the most-likely
 "\n"
 "This Viterbi algorithm returns the most likely path. The internal variable calculation uses double for a better precision.\n"
 "\n"
+"See ViterbiOnline for a streaming version that decodes the frames as they come with a bounded latency.\n"
+"\n"
 "References:\n"
 "  [1] M. Mauch and S. Dixon, \"pYIN: A Fundamental Frequency Estimator\n"
 "  Using Probabilistic Threshold Distributions,\" in Proceedings of the\n"
@@ -50,103 +270,15 @@ void Viterbi::compute() {
 
   vector<int>& path = _path.get();
 
-  int nState = init.size();
-  int nFrame = obs.size();
-  
-  // check for consistency    
-  int nTrans = transProb.size();
-  
-  // declaring variables, use double for a better precision
-  vector<double> delta = vector<double>(nState);
-  vector<double> oldDelta = vector<double>(nState);
-  vector<vector<int> > psi; //  "matrix" of remembered indices of the best transitions
-  
-  _tempPath.resize(nFrame);
-
-  double deltasum = 0;
-
-  // initialise first frame
-  for (int iState = 0; iState < nState; ++iState)
-  {
-      oldDelta[iState] = init[iState] * obs[0][iState];
-      deltasum += oldDelta[iState];
-  }
-
-  for (int iState = 0; iState < nState; ++iState)
-  {
-      oldDelta[iState] /= deltasum; // normalise (scale)
-  }
-
-  psi.push_back(vector<int>(nState,0));
-
-  // rest of forward step
-  for (int iFrame = 1; iFrame < nFrame; ++iFrame)
-  {
-      deltasum = 0;
-      psi.push_back(vector<int>(nState,0));
-
-      // calculate best previous state for every current state
-      int fromState;
-      int toState;
-      double currentTransProb;
-      double currentValue;
-      
-      // this is the "sparse" loop
-      for (int iTrans = 0; iTrans < nTrans; ++iTrans)
-      {
-          fromState = from[iTrans];
-          toState = to[iTrans];
-          currentTransProb = transProb[iTrans];
-          
-          currentValue = oldDelta[fromState] * currentTransProb;
-          if (currentValue > delta[toState])
-          {
-              delta[toState] = currentValue; // will be multiplied by the right obs later!
-              psi[iFrame][toState] = fromState;
-          }            
-      }
-      
-      for (int jState = 0; jState < nState; ++jState)
-      {
-          delta[jState] *= obs[iFrame][jState];
-          deltasum += delta[jState];
-      }
-
-      if (deltasum > 0)
-      {
-          for (int iState = 0; iState < nState; ++iState)
-          {
-              oldDelta[iState] = delta[iState] / deltasum; // normalise (scale)
-              delta[iState] = 0;
-          }
-      } else
-      {
-          E_WARNING("WARNING: Viterbi has been fed some zero probabilities, at least they become zero at frame " <<  iFrame << " in combination with the model.");
-          for (int iState = 0; iState < nState; ++iState)
-          {
-              oldDelta[iState] = 1.0/nState;
-              delta[iState] = 0;
-          }
-      }
+  _decoder.setModel(init, from, to, transProb);
+  for (int iFrame = 0; iFrame < (int)obs.size(); ++iFrame) {
+    _decoder.addFrame(obs[iFrame]);
   }
 
-  // initialise backward step, use double for a better precision
-  double bestValue = 0;
-  for (int iState = 0; iState < nState; ++iState)
-  {
-      double currentValue = oldDelta[iState];
-      if (currentValue > bestValue)
-      {
-          bestValue = currentValue;            
-          _tempPath[nFrame-1] = iState;
-      }
-  }
+  path.clear();
+  _decoder.finish(path);
+}
 
-  // rest of backward step
-  for (int iFrame = nFrame-2; iFrame != -1; --iFrame)
-  {
-      _tempPath[iFrame] = psi[iFrame+1][_tempPath[iFrame+1]];
-  }
+} // namespace standard
+} // namespace essentia
 
-  path = _tempPath;
-}
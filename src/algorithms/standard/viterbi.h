@@ -23,6 +23,96 @@
 #include "algorithmfactory.h"
 
 namespace essentia {
+
+/**
+ * Viterbi decoding of a hidden Markov model, one frame at a time.
+ *
+ * The transitions are kept grouped by destination state (compressed sparse
+ * rows), so that each state reduces over its incoming transitions from
+ * contiguous memory. The states with a zero observation probability are not
+ * reduced, as they cannot be on the best path.
+ *
+ * The whole sequence can be decoded with finish() once all the frames have
+ * been added, or online with decide(), which outputs the states of the oldest
+ * frames as soon as all the paths that can still become the best one agree on
+ * them. The memory used only depends on the number of frames not decided yet.
+ */
+class ViterbiDecoder {
+ public:
+  ViterbiDecoder() : _nState(0) { reset(); }
+
+  /**
+   * Sets the model (initial state probabilities and transitions given as lists
+   * of from/to indices and probabilities) and resets the decoding.
+   */
+  void setModel(const std::vector<Real>& initialization,
+                const std::vector<int>& fromIndex,
+                const std::vector<int>& toIndex,
+                const std::vector<Real>& transitionProbabilities);
+
+  /**
+   * Starts decoding a new sequence.
+   */
+  void reset();
+
+  /**
+   * Runs the forward step on the observation probabilities of the next frame.
+   */
+  void addFrame(const std::vector<Real>& observationProbabilities);
+
+  /**
+   * Appends to @c path the states of the oldest frames that are decided, that
+   * is, on which all the paths which can still become the best one converge.
+   * If @c maxLag > 0, the frames older than @c maxLag frames are decided
+   * anyway, following the path which is the best one at the moment.
+   */
+  void decide(std::vector<int>& path, int maxLag=0);
+
+  /**
+   * Appends to @c path the states of the frames not decided yet, following
+   * the best path ending at the last frame.
+   */
+  void finish(std::vector<int>& path);
+
+  int numberStates() const { return _nState; }
+  int numberFrames() const { return _nFrame; }
+  int numberUndecidedFrames() const { return _nFrame - _nDecided; }
+
+ protected:
+  int _nState;
+  std::vector<Real> _initialization;
+
+  // the transitions to state j are in [_incomingStart[j], _incomingStart[j+1]),
+  // in the order in which they were given
+  std::vector<int> _incomingStart;
+  std::vector<int> _incomingFrom;
+  std::vector<double> _incomingProb;
+
+  // use double for a better precision
+  std::vector<double> _delta;
+  std::vector<double> _oldDelta;
+
+  // indices of the best transitions, one row of nState values per frame,
+  // starting at frame _psiFirstFrame
+  std::vector<int> _psi;
+  int _psiFirstFrame;
+
+  int _nFrame;
+  int _nDecided;
+
+  // scratch space to follow all the surviving paths at once
+  std::vector<int> _states;
+  std::vector<int> _previousStates;
+  std::vector<unsigned int> _visited;
+  unsigned int _visitStamp;
+
+  int* psiRow(int frame) { return &_psi[(size_t)(frame - _psiFirstFrame) * _nState]; }
+  void forwardStep(const std::vector<Real>& obs, bool skipImpossibleStates, int* psi);
+  int bestState() const;
+  void backtrack(int frame, int state, std::vector<int>& path);
+};
+
+
 namespace standard {
 
 class Viterbi : public Algorithm {
@@ -35,7 +125,7 @@ class Viterbi : public Algorithm {
   Input<std::vector<Real> > _transitionProbabilities;
   Output<std::vector<int> > _path;
 
-  std::vector<int> _tempPath; 
+  ViterbiDecoder _decoder;
 
  public:
   Viterbi() {
@@ -93,4 +183,4 @@ class Viterbi : public StreamingAlgorithmWrapper {
 } // namespace streaming
 } // namespace essentia
 
-#endif // ESSENTIA_FLATNESS_H
+#endif // ESSENTIA_VITERBI_H
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "viterbionline.h"
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+const char* ViterbiOnline::name = "ViterbiOnline";
+const char* ViterbiOnline::category = "Statistics";
+const char* ViterbiOnline::description = DOC("This algorithm estimates the most-likely path of a hidden Markov model by Viterbi algorithm, one frame at a time. It is the online version of the Viterbi algorithm.\n"
+"\n"
+"The model is given as parameters, and the observation probabilities are input one frame at a time. The state of a frame is output as soon as all the paths that can still become the most likely one agree on it, or once it is maxLag frames old (if maxLag > 0), so that memory stays bounded. With maxLag = 0, the path is the same as the one of the Viterbi algorithm.\n"
+"\n"
+"An exception is thrown if the initialization or the transitions are empty.\n"
+"\n"
+"References:\n"
+"  [1] Viterbi algorithm - Wikipedia, the free encyclopedia,\n"
+"  https://en.wikipedia.org/wiki/Viterbi_algorithm");
+
+void ViterbiOnline::reset() {
+  Algorithm::reset();
+  _decoder.reset();
+  _decided.clear();
+  _nOutput = 0;
+  _finished = false;
+}
+
+void ViterbiOnline::configure() {
+  vector<Real> init = parameter("initialization").toVectorReal();
+  vector<int> from = parameter("fromIndex").toVectorInt();
+  vector<int> to = parameter("toIndex").toVectorInt();
+  vector<Real> transProb = parameter("transitionProbabilities").toVectorReal();
+
+  // the default (empty) model is accepted here so that the algorithm can be
+  // created by the factory, it is rejected in process()
+  _emptyModel = init.empty() || transProb.empty();
+  _decoder.setModel(init, from, to, transProb);
+  _maxLag = parameter("maxLag").toInt();
+
+  reset();
+}
+
+AlgorithmStatus ViterbiOnline::process() {
+  // output the states decided so far
+  while (_nOutput < (int)_decided.size()) {
+    if (!_path.acquire(1)) return NO_OUTPUT;
+    _path.firstToken() = _decided[_nOutput++];
+    _path.release(1);
+  }
+  _decided.clear();
+  _nOutput = 0;
+
+  if (_emptyModel) {
+    throw EssentiaException("ViterbiOnline: the initialization and the transitions can not be empty");
+  }
+
+  if (!_observationProbabilities.acquire(1)) {
+    if (!shouldStop() || _finished) return NO_INPUT;
+
+    // end of stream: follow the best path for the frames not decided yet
+    _decoder.finish(_decided);
+    _finished = true;
+    return _decided.empty() ? NO_INPUT : OK;
+  }
+
+  _decoder.addFrame(_observationProbabilities.firstToken());
+  _observationProbabilities.release(1);
+
+  _decoder.decide(_decided, _maxLag);
+
+  return OK;
+}
+
+} // namespace streaming
+} // namespace essentia
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_VITERBIONLINE_H
+#define ESSENTIA_VITERBIONLINE_H
+
+#include "streamingalgorithm.h"
+#include "viterbi.h"
+
+namespace essentia {
+namespace streaming {
+
+/**
+ * Online version of the Viterbi algorithm: it takes the observation
+ * probabilities one frame at a time and outputs the state of each frame as
+ * soon as it is decided (see ViterbiDecoder::decide()). The model is given as
+ * parameters instead of inputs.
+ */
+class ViterbiOnline : public Algorithm {
+
+ protected:
+  Sink<std::vector<Real> > _observationProbabilities;
+  Source<int> _path;
+
+  ViterbiDecoder _decoder;
+  int _maxLag;
+  bool _emptyModel;
+  std::vector<int> _decided; // decided states waiting to be output
+  int _nOutput;              // how many of them have been output already
+  bool _finished;
+
+ public:
+  ViterbiOnline() : _emptyModel(true) {
+    declareInput(_observationProbabilities, 1, "observationProbabilities", "the observation probabilities of a frame");
+    declareOutput(_path, 1, "path", "the decoded state of each frame, output as soon as it is decided");
+  }
+
+  void declareParameters() {
+    declareParameter("initialization", "the initialization", "", std::vector<Real>());
+    declareParameter("fromIndex", "the transition matrix from index", "", std::vector<int>());
+    declareParameter("toIndex", "the transition matrix to index", "", std::vector<int>());
+    declareParameter("transitionProbabilities", "the transition probabilities matrix", "", std::vector<Real>());
+    declareParameter("maxLag", "the maximum number of frames a state can stay undecided before the current best path is followed (0 = no limit)", "[0,inf)", 0);
+  }
+
+  void reset();
+  void configure();
+  AlgorithmStatus process();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_VITERBIONLINE_H
@@ -21,6 +21,7 @@
 #include "algorithmfactory.h"
 #include "essentiamath.h"
 #include "essentiautil.h"
+#include "utils/threadpool.h"
 #include "tnt/tnt2essentiautils.h"
 
 using namespace std;
@@ -92,74 +93,229 @@ void PoolAggregator::aggregateSingleRealPool(const Pool& input, Pool& output) {
   }
 }
 
-void PoolAggregator::aggregateRealPool(const Pool& input, Pool& output) {
-  PoolOf(Real) realPool = input.getRealPool();
+namespace {
+
+// running central moments up to the 4th order, updated in a single pass and
+// accumulated in double precision to avoid cancellation on long descriptors
+class Moments {
+ public:
+  Moments() : _n(0), _mean(0), _m2(0), _m3(0), _m4(0) {}
+
+  void add(double x, int order) {
+    double n1 = _n;
+    _n += 1;
+    double delta = x - _mean;
+    double deltaN = delta / _n;
+    double term1 = delta * deltaN * n1;
+    _mean += deltaN;
+    if (order > 2) {
+      double deltaN2 = deltaN * deltaN;
+      _m4 += term1 * deltaN2 * (_n*_n - 3*_n + 3) + 6 * deltaN2 * _m2 - 4 * deltaN * _m3;
+      _m3 += term1 * deltaN * (_n - 2) - 3 * deltaN * _m2;
+    }
+    _m2 += term1;
+  }
 
-  for (PoolOf(Real)::const_iterator it = realPool.begin();
-       it != realPool.end();
-       ++it) {
-    string key = it->first;
-    vector<Real> data = it->second;
-    int dsize = int(data.size());
+  // an empty accumulator has a mean and a variance of 0, which is what the
+  // derivatives of a descriptor with too few values to derive them return
+  Real mean() const { return Real(_mean); }
+  Real variance() const { return _n > 0 ? Real(_m2 / _n) : Real(0); }
 
-    // mean, variance, and standard deviation
-    Real meanVal = mean(data);
-    Real varianceVal = variance(data, meanVal);
-    Real stdevVal = sqrt(varianceVal);
+  Real skewness() const {
+    if (_m2 == 0) return Real(0);
+    return Real(sqrt(_n) * _m3 / pow(_m2, 1.5));
+  }
 
-    // median
-    Real medianVal = median(data);
+  Real kurtosis() const {
+    if (_m2 == 0) return Real(-3);
+    return Real(_n * _m4 / (_m2 * _m2) - 3);
+  }
 
-    // skewness and kurtosis
-    Real skewnessVal = skewness(data, meanVal);
-    Real kurtosisVal = kurtosis(data, meanVal);
+ protected:
+  double _n, _mean, _m2, _m3, _m4;
+};
+
+enum ColumnStat {
+  MEAN, VAR, STDEV, SKEW, KURT, MIN, MAX, MEDIAN, DMEAN, DVAR, DMEAN2, DVAR2,
+  OTHER_STAT // cov, icov, copy, value and last are not computed per column
+};
+
+ColumnStat columnStat(const string& stat) {
+  if (stat == "mean")   return MEAN;
+  if (stat == "var")    return VAR;
+  if (stat == "stdev")  return STDEV;
+  if (stat == "skew")   return SKEW;
+  if (stat == "kurt")   return KURT;
+  if (stat == "min")    return MIN;
+  if (stat == "max")    return MAX;
+  if (stat == "median") return MEDIAN;
+  if (stat == "dmean")  return DMEAN;
+  if (stat == "dvar")   return DVAR;
+  if (stat == "dmean2") return DMEAN2;
+  if (stat == "dvar2")  return DVAR2;
+  return OTHER_STAT;
+}
 
-    // min and max
-    Real minVal = data[0], maxVal = data[0];
-    for (int i=1; i<dsize; ++i) {
-      minVal = min(minVal, data[i]);
-      maxVal = max(maxVal, data[i]);
+struct ColumnAccumulator {
+  Moments values, derivative, derivative2;
+  Real minVal, maxVal;
+  Real previous, previousDerivative;
+};
+
+// median by selection instead of a full sort, the values get reordered
+Real selectMedian(vector<Real>& values) {
+  size_t half = values.size() / 2;
+  nth_element(values.begin(), values.begin() + half, values.end());
+  Real upper = values[half];
+  if (values.size() % 2 == 1) return upper;
+  Real lower = *max_element(values.begin(), values.begin() + half);
+  return (lower + upper) / 2;
+}
+
+} // namespace
+
+
+// Computes the requested statistics of each column of the nFrames x frameSize
+// row-major matrix pointed to by data. Only the accumulators needed by the
+// requested statistics are updated, all of them in the same pass over the data.
+void PoolAggregator::computeStats(const Real* data, size_t nFrames, size_t frameSize,
+                                  const vector<string>& stats, StatsValues& results) {
+  int order = 0;
+  bool minMax = false, derivative = false, derivative2 = false;
+  for (int i=0; i<(int)stats.size(); ++i) {
+    switch (columnStat(stats[i])) {
+      case MEAN:   order = max(order, 1); break;
+      case VAR:
+      case STDEV:  order = max(order, 2); break;
+      case SKEW:
+      case KURT:   order = 4; break;
+      case MIN:
+      case MAX:    minMax = true; break;
+      case DMEAN:
+      case DVAR:   derivative = true; break;
+      case DMEAN2:
+      case DVAR2:  derivative2 = true; break;
+      default: break;
     }
+  }
 
-    // derived mean & var
-    vector<Real> derived(dsize > 1 ? dsize-1 : 1, 0.0);
-    vector<Real> derived2(dsize > 2 ? dsize-2 : 1, 0.0);
+  vector<ColumnAccumulator> columns(frameSize);
+  for (size_t j=0; j<frameSize; ++j) {
+    columns[j].minVal = columns[j].maxVal = columns[j].previous = data[j];
+    columns[j].previousDerivative = 0;
+  }
 
-    for (int i=0; i<dsize-1; ++i) {
-      derived[i] = data[i+1] - data[i];
+  if (order > 0 || minMax || derivative || derivative2) {
+    for (size_t i=0; i<nFrames; ++i) {
+      const Real* frame = data + i*frameSize;
+      for (size_t j=0; j<frameSize; ++j) {
+        ColumnAccumulator& c = columns[j];
+        Real x = frame[j];
+        if (order > 0) c.values.add(x, order);
+        if (minMax) {
+          c.minVal = min(c.minVal, x);
+          c.maxVal = max(c.maxVal, x);
+        }
+        if (i > 0 && (derivative || derivative2)) {
+          // only the absolute values of the derivatives are considered
+          Real d = x - c.previous;
+          if (derivative) c.derivative.add(abs(d), 2);
+          if (derivative2 && i > 1) c.derivative2.add(abs(d - c.previousDerivative), 2);
+          c.previousDerivative = d;
+        }
+        c.previous = x;
+      }
     }
-    for (int i=0; i<dsize-2; ++i) {
-      derived2[i] = derived[i+1] - derived[i];
+  }
+
+  vector<Real> column;
+  for (int i=0; i<(int)stats.size(); ++i) {
+    ColumnStat stat = columnStat(stats[i]);
+    if (stat == OTHER_STAT) continue;
+
+    vector<Real>& values = results[stats[i]];
+    values.resize(frameSize);
+
+    if (stat == MEDIAN) {
+      column.resize(nFrames);
+      for (size_t j=0; j<frameSize; ++j) {
+        for (size_t k=0; k<nFrames; ++k) column[k] = data[k*frameSize + j];
+        values[j] = selectMedian(column);
+      }
+      continue;
     }
 
-    Real dmeanVal, d2meanVal, dvarianceVal, d2varianceVal;
+    for (size_t j=0; j<frameSize; ++j) {
+      const ColumnAccumulator& c = columns[j];
+      switch (stat) {
+        case MEAN:   values[j] = c.values.mean(); break;
+        case VAR:    values[j] = c.values.variance(); break;
+        case STDEV:  values[j] = sqrt(c.values.variance()); break;
+        case SKEW:   values[j] = c.values.skewness(); break;
+        case KURT:   values[j] = c.values.kurtosis(); break;
+        case MIN:    values[j] = c.minVal; break;
+        case MAX:    values[j] = c.maxVal; break;
+        case DMEAN:  values[j] = c.derivative.mean(); break;
+        case DVAR:   values[j] = c.derivative.variance(); break;
+        case DMEAN2: values[j] = c.derivative2.mean(); break;
+        case DVAR2:  values[j] = c.derivative2.variance(); break;
+        default: break;
+      }
+    }
+  }
+}
+
+// Computes the statistics of all the given descriptors, each of them as a
+// separate task when more than one thread is used.
+void PoolAggregator::computeStats(vector<AggregationTask>& tasks) {
+  if (_numberThreads > 1 && tasks.size() > 1) {
+    ThreadPool pool(min((size_t)_numberThreads, tasks.size()));
+    for (int i=0; i<(int)tasks.size(); ++i) {
+      AggregationTask* task = &tasks[i];
+      pool.submit([task]() {
+        computeStats(task->data, task->nFrames, task->frameSize, *task->stats, task->results);
+      });
+    }
+    pool.wait();
+  }
+  else {
+    for (int i=0; i<(int)tasks.size(); ++i) {
+      AggregationTask& task = tasks[i];
+      computeStats(task.data, task.nFrames, task.frameSize, *task.stats, task.results);
+    }
+  }
+}
 
-    // we need to perform the absolute value conversion before taking the
-    // variance so that the mean and variance caclulation both use the absolute
-    // value technique and thus consistent
-    for (int i=0; i<(int)derived.size(); i++) derived[i] = abs(derived[i]);
-    for (int i=0; i<(int)derived2.size(); i++) derived2[i] = abs(derived2[i]);
-    dmeanVal = mean(derived);
-    d2meanVal = mean(derived2);
-    dvarianceVal = variance(derived, mean(derived));
-    d2varianceVal = variance(derived2, mean(derived2));
+
+void PoolAggregator::aggregateRealPool(const Pool& input, Pool& output) {
+  const PoolOf(Real)& realPool = input.getRealPool();
+
+  vector<AggregationTask> tasks;
+  tasks.reserve(realPool.size());
+  for (PoolOf(Real)::const_iterator it = realPool.begin();
+       it != realPool.end();
+       ++it) {
+    if (it->second.empty()) continue;
+    AggregationTask task;
+    task.key = &it->first;
+    task.data = &it->second[0];
+    task.nFrames = it->second.size();
+    task.frameSize = 1;
+    task.stats = &getStats(it->first);
+    tasks.push_back(task);
+  }
+
+  computeStats(tasks);
+
+  for (int t=0; t<(int)tasks.size(); ++t) {
+    const string& key = *tasks[t].key;
+    const vector<Real>& data = realPool.find(key)->second;
+    const vector<string>& stats = *tasks[t].stats;
+    StatsValues& results = tasks[t].results;
 
     // figure out which computed stats to add to the output pool
-    const vector<string>& stats = getStats(key);
     for (int i=0; i<(int)stats.size(); ++i) {
-      if      (stats[i] == "mean")   output.set(key + ".mean", meanVal);
-      else if (stats[i] == "median") output.set(key + ".median", medianVal);
-      else if (stats[i] == "min")    output.set(key + ".min", minVal);
-      else if (stats[i] == "max")    output.set(key + ".max", maxVal);
-      else if (stats[i] == "var")    output.set(key + ".var", varianceVal);
-      else if (stats[i] == "stdev")  output.set(key + ".stdev", stdevVal);    
-      else if (stats[i] == "skew")   output.set(key + ".skew", skewnessVal);
-      else if (stats[i] == "kurt")   output.set(key + ".kurt", kurtosisVal);
-      else if (stats[i] == "dmean")  output.set(key + ".dmean", dmeanVal);
-      else if (stats[i] == "dvar")   output.set(key + ".dvar", dvarianceVal);
-      else if (stats[i] == "dmean2") output.set(key + ".dmean2", d2meanVal);
-      else if (stats[i] == "dvar2")  output.set(key + ".dvar2", d2varianceVal);
-      else if (stats[i] == "copy") {
+      if (stats[i] == "copy") {
         for (int i=0; i<int(data.size()); ++i) {
           output.add(key, data[i]);
         }
@@ -173,6 +329,9 @@ void PoolAggregator::aggregateRealPool(const Pool& input, Pool& output) {
       else if (stats[i] == "last") {
         output.set(key, data.back());
       }
+      else if (results.count(stats[i])) {
+        output.set(key + "." + stats[i], results[stats[i]][0]);
+      }
     }
   }
 }
@@ -189,18 +348,32 @@ void PoolAggregator::aggregateSingleVectorRealPool(const Pool& input, Pool& outp
   }
 }
 
+// adds the contiguous frames to the output under the given name, reading them
+// in place and going through a single buffer
+static void addFrames(const VectorRealFrames& frames, const string& name, Pool& output) {
+  DescriptorHandle handle = output.descriptorHandle<vector<Real> >(name);
+  const Real* data = frames.data();
+  const int vsize = frames.frameSize();
+  vector<Real> frame(vsize);
+  for (int j=0; j<(int)frames.size(); ++j) {
+    copy(data + j*vsize, data + (j+1)*vsize, frame.begin());
+    output.add(handle, frame);
+  }
+}
+
 void PoolAggregator::aggregateVectorRealPool(const Pool& input, Pool& output) {
-  PoolOf(vector<Real>) vectorRealPool = input.getVectorRealPool();
+  const map<string, VectorRealFrames>& vectorRealPool = input.getVectorRealFramesPool();
 
-  for (PoolOf(vector<Real>)::const_iterator it = vectorRealPool.begin();
+  vector<AggregationTask> tasks;
+  tasks.reserve(vectorRealPool.size());
+  for (map<string, VectorRealFrames>::const_iterator it = vectorRealPool.begin();
        it != vectorRealPool.end();
        ++it) {
 
-    string key = it->first;
-    vector<vector<Real> > data = it->second;
-    int dsize = data.size();
+    const string& key = it->first;
+    const VectorRealFrames& data = it->second;
 
-    if (dsize == 0) continue;
+    if (data.empty()) continue;
 
     // if pool value consists of only one vector, don't perform aggregation,
     // just add it to the output
@@ -209,93 +382,44 @@ void PoolAggregator::aggregateVectorRealPool(const Pool& input, Pool& output) {
     //  continue;
     //}
 
-    int vsize = data[0].size();
-
-    // check if all the vectors are the same size, otherwise skip the descriptor
-    bool skipDescriptor = false;
-    for (int i=1; i<dsize; ++i) {
-      if ((int)data[i].size() != vsize) {
-        E_WARNING("PoolAggregator: not aggregating \"" << key << "\" because it has frames of different sizes");
-        skipDescriptor = true;
-        break;
-      }
-    }
-    if (skipDescriptor) continue;
-
-
-    // mean & var
-    vector<Real> meanVals = meanFrames(data);
-    vector<Real> varVals = varianceFrames(data);
-
-    // stdev
-    vector<Real> stdevVals(varVals);
-    std::transform(stdevVals.begin(), stdevVals.end(), stdevVals.begin(), static_cast<Real (*)(Real)>(std::sqrt));
-
-    // median
-    vector<Real> medianVals = medianFrames(data);
-
-    // skewness & kurtosis
-    vector<Real> skewnessVals = skewnessFrames(data);
-    vector<Real> kurtosisVals = kurtosisFrames(data);
-
-    // min & max
-    vector<Real> minVals(vsize, 0.0), maxVals(vsize, 0.0);
-    for (int j=0; j<vsize; j++) minVals[j] = maxVals[j] = data[0][j]; // init values
-    for (int i=1; i<dsize; i++) {
-      for (int j=0; j<vsize; j++) {
-        minVals[j] = min(data[i][j], minVals[j]);
-        maxVals[j] = max(data[i][j], maxVals[j]);
-      }
-    }
-
-    // derived mean & var
-    vector<vector<Real> > derived(dsize > 1 ? dsize-1 : 1, vector<Real>(vsize, 0.0));
-    vector<vector<Real> > derived2(dsize > 2 ? dsize-2 : 1, vector<Real>(vsize, 0.0));
-
-    // first derivative
-    for (int i=0; i<dsize-1; i++) {
-      for (int j=0; j<vsize; j++) {
-        derived[i][j] += data[i+1][j] - data[i][j];
-      }
-    }
-
-    // second derivative
-    for (int i=0; i<dsize-2; i++) {
-      for (int j=0; j<vsize; j++) {
-        derived2[i][j] += derived[i+1][j] - derived[i][j];
-      }
+    // frames are stored contiguously only if they all have the same size,
+    // otherwise skip the descriptor
+    if (!data.isContiguous()) {
+      E_WARNING("PoolAggregator: not aggregating \"" << key << "\" because it has frames of different sizes");
+      continue;
     }
 
-    for (int i=0; i<int(derived.size()); i++) {
-      for (int j=0; j<int(derived[i].size()); j++) {
-        derived[i][j] = abs(derived[i][j]);
-      }
-    }
+    AggregationTask task;
+    task.key = &key;
+    task.data = data.data();
+    task.nFrames = data.size();
+    task.frameSize = data.frameSize();
+    task.stats = &getStats(key);
+    tasks.push_back(task);
+  }
 
-    for (int i=0; i<int(derived2.size()); i++) {
-      for (int j=0; j<int(derived2[i].size()); j++) {
-        derived2[i][j] = abs(derived2[i][j]);
-      }
-    }
+  computeStats(tasks);
 
-    vector<Real> dmeanVals = meanFrames(derived);
-    vector<Real> d2meanVals = meanFrames(derived2);
-    vector<Real> dvarVals = varianceFrames(derived);
-    vector<Real> d2varVals = varianceFrames(derived2);
+  for (int t=0; t<(int)tasks.size(); ++t) {
+    const string& key = *tasks[t].key;
+    const VectorRealFrames& frames = vectorRealPool.find(key)->second;
+    const vector<string>& stats = *tasks[t].stats;
+    StatsValues& results = tasks[t].results;
+    int dsize = frames.size();
+    int vsize = frames.frameSize();
 
     // only compute cov and icov matrix if asked, because it could throw an
     // exception if matrix is singular...
-    const vector<string>& stats = getStats(key);
-
     vector<vector<Real> > cov(vsize), icov(vsize);
 
     if (contains(stats, string("cov")) || contains(stats, string("icov"))) {
 
       // create an Array2D and copy all the data values into it
-      TNT::Array2D<Real> frames(dsize, vsize);
+      TNT::Array2D<Real> matrix(dsize, vsize);
+      const Real* data = frames.data();
       for (int i=0; i<dsize; i++) {
         for (int j=0; j<vsize; j++) {
-          frames[i][j] = data[i][j];
+          matrix[i][j] = data[i*vsize + j];
         }
       }
 
@@ -303,7 +427,7 @@ void PoolAggregator::aggregateVectorRealPool(const Pool& input, Pool& output) {
       TNT::Array2D<Real> covTnt, icovTnt;
 
       Algorithm* sg = AlgorithmFactory::create("SingleGaussian");
-      sg->input("matrix").set(frames);
+      sg->input("matrix").set(matrix);
       sg->output("mean").set(framesMean);
       sg->output("covariance").set(covTnt);
       sg->output("inverseCovariance").set(icovTnt);
@@ -329,43 +453,7 @@ void PoolAggregator::aggregateVectorRealPool(const Pool& input, Pool& output) {
     for (int i=0; i<(int)stats.size(); ++i) {
       string subkey = key + "." + stats[i];
 
-      if (stats[i] == "mean")
-        for (int j=0; j<int(meanVals.size()); ++j) output.add(subkey, meanVals[j]);
-
-      else if (stats[i] == "median")
-        for (int j=0; j<int(medianVals.size()); ++j) output.add(subkey, medianVals[j]);
-    
-      else if (stats[i] == "min")
-        for (int j=0; j<int(minVals.size()); ++j) output.add(subkey, minVals[j]);
-
-      else if (stats[i] == "max")
-        for (int j=0; j<int(maxVals.size()); ++j) output.add(subkey, maxVals[j]);
-
-      else if (stats[i] == "var")
-        for (int j=0; j<int(varVals.size()); ++j) output.add(subkey, varVals[j]);
-
-      else if (stats[i] == "stdev")
-        for (int j=0; j<int(stdevVals.size()); ++j) output.add(subkey, stdevVals[j]);
-
-      else if (stats[i] == "skew")
-        for (int j=0; j<int(skewnessVals.size()); ++j) output.add(subkey, skewnessVals[j]);
-
-      else if (stats[i] == "kurt")
-        for (int j=0; j<int(kurtosisVals.size()); ++j) output.add(subkey, kurtosisVals[j]);
-
-      else if (stats[i] == "dmean")
-        for (int j=0; j<int(dmeanVals.size()); ++j) output.add(subkey, dmeanVals[j]);
-
-      else if (stats[i] == "dvar")
-        for (int j=0; j<int(dvarVals.size()); ++j) output.add(subkey, dvarVals[j]);
-
-      else if (stats[i] == "dmean2")
-        for (int j=0; j<int(d2meanVals.size()); ++j) output.add(subkey, d2meanVals[j]);
-
-      else if (stats[i] == "dvar2")
-        for (int j=0; j<int(d2varVals.size()); ++j) output.add(subkey, d2varVals[j]);
-
-      else if (stats[i] == "cov")
+      if (stats[i] == "cov")
         for (int j=0; j<vsize; ++j) output.add(subkey, cov[j]);
 
       else if (stats[i] == "icov")
@@ -373,13 +461,19 @@ void PoolAggregator::aggregateVectorRealPool(const Pool& input, Pool& output) {
 
       else if (stats[i] == "copy")
         // don't use the subkey in this case, just key
-        for (int j=0; j<int(data.size()); ++j) output.add(key, data[j]);
+        addFrames(frames, key, output);
 
       else if (stats[i] == "value")
-        for (int j=0; j<int(data.size()); ++j) output.add(subkey, data[j]);
-      
+        addFrames(frames, subkey, output);
+
       else if (stats[i] == "last") {
-        output.set(key, data.back());
+        const Real* last = frames.data() + (dsize-1)*vsize;
+        output.set(key, vector<Real>(last, last + vsize));
+      }
+
+      else if (results.count(stats[i])) {
+        const vector<Real>& values = results[stats[i]];
+        for (int j=0; j<int(values.size()); ++j) output.add(subkey, values[j]);
       }
     }
   }
@@ -570,6 +664,7 @@ void PoolAggregator::aggregateArray2DRealPool(const Pool& input, Pool& output) {
 void PoolAggregator::configure() {
   _defaultStats = parameter("defaultStats").toVectorString();
   _exceptions = parameter("exceptions").toMapVectorString();
+  _numberThreads = parameter("numberThreads").toInt();
 
   // if the default stats includes the 'copy' statistical unit, make sure it
   // is the only one
@@ -43,9 +43,27 @@ class PoolAggregator : public Algorithm {
   void aggregateVectorStringPool(const Pool& input, Pool& output);
   const std::vector<std::string>& getStats(const std::string& key) const;
 
+  typedef std::map<std::string, std::vector<Real> > StatsValues;
+
+  // a descriptor stored as a row-major matrix of nFrames x frameSize values
+  // and the statistics computed for each of its columns
+  struct AggregationTask {
+    const std::string* key;
+    const Real* data;
+    size_t nFrames;
+    size_t frameSize;
+    const std::vector<std::string>* stats;
+    StatsValues results;
+  };
+
+  static void computeStats(const Real* data, size_t nFrames, size_t frameSize,
+                           const std::vector<std::string>& stats, StatsValues& results);
+  void computeStats(std::vector<AggregationTask>& tasks);
+
   std::vector<std::string> _defaultStats;
   std::map<std::string, std::vector<std::string> > _exceptions;
   static const std::set<std::string> _supportedStats;
+  int _numberThreads;
 
  public:
   PoolAggregator() {
@@ -59,6 +77,7 @@ class PoolAggregator : public Algorithm {
 
     declareParameter("defaultStats", "the default statistics to be computed for each descriptor in the input pool", "", defaultStats);
     declareParameter("exceptions", "a mapping between descriptor names (no duplicates) and the types of statistics to be computed for those descriptors (e.g. { lowlevel.bpm : [min, max], lowlevel.gain : [var, min, dmean] })", "", std::map<std::string, std::vector<std::string> >());
+    declareParameter("numberThreads", "number of threads used to aggregate the descriptors in parallel", "[1,inf)", 1);
   }
 
   void compute();
@@ -32,6 +32,8 @@ const char* PitchYinProbabilitiesHMM::description = DOC("This algorithm estimate
 "\n"
 "An exception is thrown if an empty signal is provided.\n"
 "\n"
+"See PitchYinProbabilitiesHMMOnline for a streaming version that outputs the pitch of each frame with a bounded latency.\n"
+"\n"
 "References:\n"
 "  [1] M. Mauch and S. Dixon, \"pYIN: A Fundamental Frequency Estimator\n"
 "  Using Probabilistic Threshold Distributions,\" in Proceedings of the\n"
@@ -163,27 +165,31 @@ void PitchYinProbabilitiesHMM::compute() {
 
   _tempPitch.resize(path.size());
 
-  // time(&start1);
   for (int iFrame = 0; iFrame < (int)path.size(); ++iFrame)
   {
-    Real hmmFreq = _freqs[path[iFrame]];
-    Real bestFreq = 0;
-    Real leastDist = 10000;
-    if (hmmFreq > 0)
+    _tempPitch[iFrame] = statePitch(path[iFrame], pitchCandidates[iFrame]);
+  }
+  pitch = _tempPitch;
+}
+
+Real PitchYinProbabilitiesHMM::statePitch(int state, const vector<Real>& pitchCandidates) const {
+  // the candidate which is the closest to the frequency of the state
+  Real hmmFreq = _freqs[state];
+  Real bestFreq = 0;
+  Real leastDist = 10000;
+  if (hmmFreq > 0)
+  {
+    for (int iPitch = 0; iPitch < (int)pitchCandidates.size(); ++iPitch)
     {
-      for (int iPitch = 0; iPitch < (int)pitchCandidates[iFrame].size(); ++iPitch)
-      {
-        Real freq = 440. * pow(2, (pitchCandidates[iFrame][iPitch] - 69) / 12);
-        Real dist = abs(hmmFreq - freq);
-        if (dist < leastDist) {
-          leastDist = dist;
-          bestFreq = freq;
-        }
+      Real freq = 440. * pow(2, (pitchCandidates[iPitch] - 69) / 12);
+      Real dist = abs(hmmFreq - freq);
+      if (dist < leastDist) {
+        leastDist = dist;
+        bestFreq = freq;
       }
-    } else {
-      bestFreq = hmmFreq;
     }
-    _tempPitch[iFrame] = bestFreq;
+  } else {
+    bestFreq = hmmFreq;
   }
-  pitch = _tempPitch;
+  return bestFreq;
 }
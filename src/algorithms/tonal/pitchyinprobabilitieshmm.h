@@ -21,6 +21,7 @@
 #define ESSENTIA_PITCHYINPROBABILITIESHMM_H
 
 #include "algorithmfactory.h"
+#include "algorithms/standard/viterbi.h"
 
 namespace essentia {
 namespace standard {
@@ -72,8 +73,14 @@ class PitchYinProbabilitiesHMM : public Algorithm {
   static const char* category;
   static const char* description;
 
- protected:
+  // used by PitchYinProbabilitiesHMMOnline, which shares the model and the
+  // observation probabilities
+  void setModel(ViterbiDecoder& decoder) const {
+    decoder.setModel(_init, _from, _to, _transProb);
+  }
+
   const std::vector<Real> calculateObsProb(const std::vector<Real> pitchCandidates, const std::vector<Real> probabilities);
+  Real statePitch(int state, const std::vector<Real>& pitchCandidates) const;
 }; // class PitchYin
 
 } // namespace standard
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "pitchyinprobabilitieshmmonline.h"
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+const char* PitchYinProbabilitiesHMMOnline::name = "PitchYinProbabilitiesHMMOnline";
+const char* PitchYinProbabilitiesHMMOnline::category = "Pitch";
+const char* PitchYinProbabilitiesHMMOnline::description = DOC("This algorithm estimates the smoothed fundamental frequency given the pitch candidates and probabilities using hidden Markov models, one frame at a time. It is the online version of the PitchYinProbabilitiesHMM algorithm [1].\n"
+"\n"
+"The pitch candidates and probabilities are input one frame at a time, and the pitch of a frame is output as soon as all the paths that can still become the most likely one agree on it, or once it is maxLag frames old (if maxLag > 0). With maxLag = 0, the pitch track is the same as the one of PitchYinProbabilitiesHMM.\n"
+"\n"
+"References:\n"
+"  [1] M. Mauch and S. Dixon, \"pYIN: A Fundamental Frequency Estimator\n"
+"  Using Probabilistic Threshold Distributions,\" in Proceedings of the\n"
+"  IEEE International Conference on Acoustics, Speech, and Signal Processing\n"
+"  (ICASSP 2014)Project Report, 2004");
+
+PitchYinProbabilitiesHMMOnline::PitchYinProbabilitiesHMMOnline() {
+  declareInput(_pitchCandidates, 1, "pitchCandidates", "the pitch candidates of a frame");
+  declareInput(_probabilities, 1, "probabilities", "the pitch probabilities of a frame");
+  declareOutput(_pitch, 1, "pitch", "pitch frequency in Hz, output as soon as it is decided");
+
+  _model = static_cast<standard::PitchYinProbabilitiesHMM*>(
+    standard::AlgorithmFactory::create("PitchYinProbabilitiesHMM"));
+}
+
+PitchYinProbabilitiesHMMOnline::~PitchYinProbabilitiesHMMOnline() {
+  delete _model;
+}
+
+void PitchYinProbabilitiesHMMOnline::reset() {
+  Algorithm::reset();
+  _decoder.reset();
+  _frameCandidates.clear();
+  _decided.clear();
+  _nOutput = 0;
+  _finished = false;
+}
+
+void PitchYinProbabilitiesHMMOnline::configure() {
+  standard::Algorithm* model = _model;
+  model->configure(INHERIT("minFrequency"), INHERIT("numberBinsPerSemitone"),
+                   INHERIT("selfTransition"), INHERIT("yinTrust"));
+  _model->setModel(_decoder);
+  _maxLag = parameter("maxLag").toInt();
+
+  reset();
+}
+
+AlgorithmStatus PitchYinProbabilitiesHMMOnline::process() {
+  // output the pitch of the frames decided so far
+  while (_nOutput < (int)_decided.size()) {
+    if (!_pitch.acquire(1)) return NO_OUTPUT;
+    _pitch.firstToken() = _model->statePitch(_decided[_nOutput++], _frameCandidates.front());
+    _pitch.release(1);
+    _frameCandidates.pop_front();
+  }
+  _decided.clear();
+  _nOutput = 0;
+
+  if (!_pitchCandidates.acquire(1) || !_probabilities.acquire(1)) {
+    if (!shouldStop() || _finished) return NO_INPUT;
+
+    // end of stream: follow the best path for the frames not decided yet
+    _decoder.finish(_decided);
+    _finished = true;
+    return _decided.empty() ? NO_INPUT : OK;
+  }
+
+  const vector<Real>& pitchCandidates = _pitchCandidates.firstToken();
+  _decoder.addFrame(_model->calculateObsProb(pitchCandidates, _probabilities.firstToken()));
+  _frameCandidates.push_back(pitchCandidates);
+
+  _pitchCandidates.release(1);
+  _probabilities.release(1);
+
+  _decoder.decide(_decided, _maxLag);
+
+  return OK;
+}
+
+} // namespace streaming
+} // namespace essentia
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_PITCHYINPROBABILITIESHMMONLINE_H
+#define ESSENTIA_PITCHYINPROBABILITIESHMMONLINE_H
+
+#include <deque>
+#include "streamingalgorithm.h"
+#include "pitchyinprobabilitieshmm.h"
+
+namespace essentia {
+namespace streaming {
+
+/**
+ * Online version of the PitchYinProbabilitiesHMM: it takes the pitch
+ * candidates and probabilities one frame at a time and outputs the pitch of
+ * each frame as soon as the HMM state of the frame is decided (see
+ * ViterbiDecoder::decide()).
+ */
+class PitchYinProbabilitiesHMMOnline : public Algorithm {
+
+ protected:
+  Sink<std::vector<Real> > _pitchCandidates;
+  Sink<std::vector<Real> > _probabilities;
+  Source<Real> _pitch;
+
+  standard::PitchYinProbabilitiesHMM* _model;
+  ViterbiDecoder _decoder;
+  int _maxLag;
+
+  // pitch candidates of the frames not output yet
+  std::deque<std::vector<Real> > _frameCandidates;
+  std::vector<int> _decided; // decided states waiting to be output
+  int _nOutput;              // how many of them have been output already
+  bool _finished;
+
+ public:
+  PitchYinProbabilitiesHMMOnline();
+  ~PitchYinProbabilitiesHMMOnline();
+
+  void declareParameters() {
+    declareParameter("minFrequency", "minimum detected frequency", "(0,inf)", 61.735);
+    declareParameter("numberBinsPerSemitone", "number of bins per semitone", "(1,inf)", 5);
+    declareParameter("selfTransition", "the self transition probabilities", "(0,1)", 0.99);
+    declareParameter("yinTrust", "the yin trust parameter", "(0,1)", 0.5);
+    declareParameter("maxLag", "the maximum number of frames the pitch of a frame can stay undecided before the current best path is followed (0 = no limit)", "[0,inf)", 0);
+  }
+
+  void reset();
+  void configure();
+  AlgorithmStatus process();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_PITCHYINPROBABILITIESHMMONLINE_H
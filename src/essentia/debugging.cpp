@@ -18,6 +18,7 @@
  */
 
 #include "debugging.h"
+#include "threading.h"
 #include <iostream>
 
 using namespace std;
@@ -58,11 +59,21 @@ const char* debugModuleDescription(DebuggingModule module) {
 }
 
 
+// the debug levels can be changed by networks running in different threads.
+// The locks are created on first use, as messages can be logged by static
+// initializers of other files
+static ForcedMutex& debugLevelsMutex() {
+  static ForcedMutex mutex;
+  return mutex;
+}
+
 void setDebugLevel(int levels) {
+  ForcedMutexLocker lock(debugLevelsMutex());
   activatedDebugLevels |= levels;
 }
 
 void unsetDebugLevel(int levels) {
+  ForcedMutexLocker lock(debugLevelsMutex());
   activatedDebugLevels &= ~levels;
 }
 
@@ -72,10 +83,12 @@ DebuggingScheduleVector _schedule;
 int _savedDebugLevels = ENone;
 
 void scheduleDebug(const DebuggingScheduleVector& schedule) {
+  ForcedMutexLocker lock(debugLevelsMutex());
   _schedule = schedule;
 }
 
 void scheduleDebug(DebuggingSchedule schedule, int nentries) {
+  ForcedMutexLocker lock(debugLevelsMutex());
   _schedule.resize(nentries);
   for (int i=0; i<nentries; i++) {
     _schedule[i].first.first = schedule[i][0];
@@ -85,26 +98,40 @@ void scheduleDebug(DebuggingSchedule schedule, int nentries) {
 }
 
 void restoreDebugLevels() {
-   activatedDebugLevels = _savedDebugLevels;
+  ForcedMutexLocker lock(debugLevelsMutex());
+  activatedDebugLevels = _savedDebugLevels;
 }
 
 void saveDebugLevels() {
+  ForcedMutexLocker lock(debugLevelsMutex());
   _savedDebugLevels = activatedDebugLevels;
 }
 
 void setDebugLevelForTimeIndex(int index) {
-  restoreDebugLevels();
+  ForcedMutexLocker lock(debugLevelsMutex());
+  // the levels are only assigned once, so that the algorithms running in
+  // other threads never see the intermediate ones
+  int levels = _savedDebugLevels;
   for (int i=0; i<(int)_schedule.size(); i++) {
     if (_schedule[i].first.first <= index && index <= _schedule[i].first.second) {
-      setDebugLevel(_schedule[i].second);
+      levels |= _schedule[i].second;
     }
   }
+  activatedDebugLevels = levels;
 }
 
 
-// NOTE: in a thread-safe implementation, the msg queue would be thread-safe and
-//       the flushing would need to happen in a separate thread
-//       This can be achieved using tbb::concurrent_queue
+// the lock of the message queue, which is pushed to from any thread
+static ForcedMutex& loggerMutex() {
+  static ForcedMutex mutex;
+  return mutex;
+}
+
+void Logger::push(const string& msg) {
+  ForcedMutexLocker lock(loggerMutex());
+  _msgQueue.push_back(msg);
+  flush();
+}
 
 void Logger::flush() {
   while (!_msgQueue.empty()) {
@@ -116,6 +143,7 @@ void Logger::flush() {
 
 void Logger::debug(DebuggingModule module, const string& msg, bool resetHeader) {
   if (module & activatedDebugLevels) {
+    ForcedMutexLocker lock(loggerMutex());
     if (_addHeader) {
       _msgQueue.push_back(E_STRINGIFY(debugModuleDescription(module)      // module name
                                       + string(debugIndentLevel * 8, ' ') // indentation
@@ -132,20 +160,17 @@ void Logger::debug(DebuggingModule module, const string& msg, bool resetHeader)
 
 void Logger::info(const string& msg) {
   if (!infoLevelActive) return;
-  _msgQueue.push_back(E_STRINGIFY(GREEN_FONT << "[   INFO   ] " << RESET_FONT << msg << '\n'));
-  flush();
+  push(E_STRINGIFY(GREEN_FONT << "[   INFO   ] " << RESET_FONT << msg << '\n'));
 }
 
 void Logger::warning(const string& msg) {
   if (!warningLevelActive) return;
-  _msgQueue.push_back(E_STRINGIFY(YELLOW_FONT << "[ WARNING  ] " << RESET_FONT << msg << '\n'));
-  flush();
+  push(E_STRINGIFY(YELLOW_FONT << "[ WARNING  ] " << RESET_FONT << msg << '\n'));
 }
 
 void Logger::error(const string& msg) {
   if (!errorLevelActive) return;
-  _msgQueue.push_back(E_STRINGIFY(RED_FONT << "[  ERROR   ] " << RESET_FONT << msg << '\n'));
-  flush();
+  push(E_STRINGIFY(RED_FONT << "[  ERROR   ] " << RESET_FONT << msg << '\n'));
 }
 
 } // namespace essentia
@@ -105,13 +105,18 @@ void scheduleDebug(const DebuggingScheduleVector& schedule);
 void setDebugLevelForTimeIndex(int index);
 
 /**
- * Asynchronous thread-safe logger object. (TODO: implementation is still not thread-safe)
+ * Thread-safe logger object. The messages are queued and flushed under a
+ * lock, so that algorithms running in different threads can log at the same
+ * time.
  */
 class ESSENTIA_API Logger {
  protected:
   std::deque<std::string> _msgQueue;
   bool _addHeader;
 
+  // adds a message to the queue and flushes it, holding the lock
+  void push(const std::string& msg);
+  // needs to be called with the lock held
   void flush();
 
   std::string GREEN_FONT;
@@ -1284,26 +1284,91 @@ void heavisideStepFunction(std::vector<std::vector<T> >& inputArray) {
 
 
 /**
- * Pairwise euclidean distances between two 2D vectors.
- * Throws an exception if the input array is empty.
- * Returns a (m.shape[0], n.shape[0]) dimensional vector where m and n are the two input arrays
- * TODO: [add other distance metrics beside euclidean such as cosine, mahalanobis etc as a configurable parameter]
+ * Pairwise euclidean distances between two 2D vectors, written into @c pdist,
+ * which is resized to (m.size(), n.size()).
+ * The distances are computed as sqrt(|a|^2 + |b|^2 - 2ab): the rows of both
+ * inputs are copied to contiguous blocks and the products ab are computed in
+ * double precision as matrix products by Eigen, which are cache-blocked and
+ * vectorized. If @c runBlocks is given, it is called with the number of
+ * blocks of rows of m and the function computing a block, so that the caller
+ * can run the blocks concurrently (eg: on a ThreadPool).
+ * Throws an exception if one of the inputs is empty or if its rows do not all
+ * have the same size.
  */
 template <typename T>
-std::vector<std::vector<T> > pairwiseDistance(const std::vector<std::vector<T> >& m, const std::vector<std::vector<T> >& n) {
+void pairwiseDistance(const std::vector<std::vector<T> >& m, const std::vector<std::vector<T> >& n,
+                      std::vector<std::vector<T> >& pdist,
+                      const std::function<void(size_t, const std::function<void(size_t)>&)>& runBlocks=nullptr) {
 
   if (m.empty() || n.empty())
     throw EssentiaException("pairwiseDistance: found empty array as input!");
 
-  size_t mSize = m.size();
-  size_t nSize = n.size();
-  std::vector<std::vector<T> > pdist(mSize, std::vector<T>(nSize));
+  typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> Matrix;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> RowMajorMatrix;
+
+  const size_t mSize = m.size();
+  const size_t nSize = n.size();
+  const size_t dim = m[0].size();
+
+  // the rows of n as the columns of a contiguous matrix, so that every block
+  // of distances comes from a single matrix product
+  Matrix nMatrix(dim, nSize);
+  for (size_t j=0; j<nSize; j++) {
+    if (n[j].size() != dim)
+      throw EssentiaException("pairwiseDistance: all the rows of the input arrays must have the same size");
+    std::copy(n[j].begin(), n[j].end(), nMatrix.col(j).data());
+  }
   for (size_t i=0; i<mSize; i++) {
+    if (m[i].size() != dim)
+      throw EssentiaException("pairwiseDistance: all the rows of the input arrays must have the same size");
+  }
+  const Eigen::VectorXd nNorms = nMatrix.colwise().squaredNorm().transpose();
+
+  pdist.resize(mSize);
+  for (size_t i=0; i<mSize; i++) pdist[i].resize(nSize);
+
+  const size_t blockSize = 64;
+  const size_t nBlocks = (mSize + blockSize - 1) / blockSize;
+
+  std::function<void(size_t)> computeBlock = [&](size_t block) {
+    const size_t first = block * blockSize;
+    const size_t rows = (std::min)(blockSize, mSize - first);
+
+    RowMajorMatrix mBlock(rows, dim);
+    for (size_t i=0; i<rows; i++) {
+      std::copy(m[first+i].begin(), m[first+i].end(), mBlock.row(i).data());
+    }
+    const Eigen::VectorXd mNorms = mBlock.rowwise().squaredNorm();
+    const RowMajorMatrix products = mBlock * nMatrix;
+
+    for (size_t i=0; i<rows; i++) {
+      T* row = &pdist[first+i][0];
       for (size_t j=0; j<nSize; j++) {
-          Real item = dotProduct(m[i], m[i]) - 2*dotProduct(m[i], n[j]) + dotProduct(n[j], n[j]);
-          pdist[i][j] = sqrt(item);
+        // rounding errors can make the squared distance slightly negative
+        double item = mNorms(i) + nNorms(j) - 2*products(i, j);
+        row[j] = (T)std::sqrt((std::max)(item, 0.));
       }
+    }
+  };
+
+  if (runBlocks && nBlocks > 1) {
+    runBlocks(nBlocks, computeBlock);
+  }
+  else {
+    for (size_t block=0; block<nBlocks; block++) computeBlock(block);
   }
+}
+
+/**
+ * Pairwise euclidean distances between two 2D vectors.
+ * Throws an exception if the input array is empty.
+ * Returns a (m.shape[0], n.shape[0]) dimensional vector where m and n are the two input arrays
+ * TODO: [add other distance metrics beside euclidean such as cosine, mahalanobis etc as a configurable parameter]
+ */
+template <typename T>
+std::vector<std::vector<T> > pairwiseDistance(const std::vector<std::vector<T> >& m, const std::vector<std::vector<T> >& n) {
+  std::vector<std::vector<T> > pdist;
+  pairwiseDistance(m, n, pdist);
   if (pdist.empty())
       throw EssentiaException("pairwiseDistance: outputs an empty similarity matrix!");
   return pdist;
@@ -57,6 +57,9 @@ class ESSENTIA_API InputBase : public TypeProxy {
     _data = sink.getTokens();
   }
 
+  // forgets the bound object, e.g. before it is destroyed
+  void unbind() { _data = 0; }
+
  protected:
   const void* _data;
 
@@ -88,6 +91,9 @@ class ESSENTIA_API OutputBase : public TypeProxy {
     _data = source.getTokens();
   }
 
+  // forgets the bound object, e.g. before it is destroyed
+  void unbind() { _data = 0; }
+
  protected:
   void* _data;
 
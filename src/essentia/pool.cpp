@@ -27,11 +27,171 @@ using namespace TNT;
 
 namespace essentia {
 
+size_t VectorRealFrames::frameSize() const {
+  if (!_contiguous) {
+    throw EssentiaException("VectorRealFrames: the frames do not all have the same size");
+  }
+  return _frameSize;
+}
+
+const Real* VectorRealFrames::data() const {
+  if (!_contiguous) {
+    throw EssentiaException("VectorRealFrames: the frames do not all have the same size");
+  }
+  return _data->empty() ? 0 : &(*_data)[0];
+}
+
+shared_ptr<const vector<Real> > VectorRealFrames::sharedData() const {
+  if (!_contiguous) {
+    throw EssentiaException("VectorRealFrames: the frames do not all have the same size");
+  }
+  return _data;
+}
+
+const Real* VectorRealFrames::row(size_t i) const {
+  if (!_contiguous) return _frames[i].empty() ? 0 : &_frames[i][0];
+  return _frameSize == 0 ? 0 : &(*_data)[i*_frameSize];
+}
+
+vector<Real> VectorRealFrames::frame(size_t i) const {
+  const Real* values = row(i);
+  return vector<Real>(values, values + rowSize(i));
+}
+
+void VectorRealFrames::copyTo(vector<vector<Real> >& frames, size_t first) const {
+  frames.reserve(frames.size() + _size - first);
+  for (size_t i=first; i<_size; ++i) frames.push_back(frame(i));
+}
+
+void VectorRealFrames::push_back(const vector<Real>& frame) {
+  if (_contiguous) {
+    if (_size == 0) _frameSize = frame.size();
+
+    if (frame.size() == _frameSize) {
+      detach();
+      _data->insert(_data->end(), frame.begin(), frame.end());
+      ++_size;
+      return;
+    }
+    makeJagged();
+  }
+
+  _frames.push_back(frame);
+  ++_size;
+}
+
+void VectorRealFrames::reserve(size_t nFrames) {
+  if (_contiguous && _size > 0) {
+    detach();
+    _data->reserve(nFrames*_frameSize);
+  }
+  else _frames.reserve(nFrames);
+}
+
+void VectorRealFrames::clear() {
+  _data = make_shared<vector<Real> >();
+  _frames.clear();
+  _size = 0;
+  _frameSize = 0;
+  _contiguous = true;
+}
+
+void VectorRealFrames::makeJagged() {
+  copyTo(_frames);
+  _data = make_shared<vector<Real> >();
+  _contiguous = false;
+}
+
+void VectorRealFrames::detach() {
+  if (_data.use_count() > 1) {
+    shared_ptr<vector<Real> > data = make_shared<vector<Real> >();
+    data->reserve(max(_data->capacity(), _data->size() + _frameSize));
+    data->assign(_data->begin(), _data->end());
+    _data = data;
+  }
+}
+
+
+Pool::Pool(const Pool& pool) {
+  GLOBAL_LOCK_OF(pool);
+
+  _poolSingleReal = pool._poolSingleReal;
+  _poolSingleString = pool._poolSingleString;
+  _poolSingleVectorReal = pool._poolSingleVectorReal;
+  _poolSingleVectorString = pool._poolSingleVectorString;
+  _poolSingleTensorReal = pool._poolSingleTensorReal;
+  _poolReal = pool._poolReal;
+  _poolVectorReal = pool._poolVectorReal;
+  _poolString = pool._poolString;
+  _poolVectorString = pool._poolVectorString;
+  _poolArray2DReal = pool._poolArray2DReal;
+  _poolTensorReal = pool._poolTensorReal;
+  _poolStereoSample = pool._poolStereoSample;
+
+  ForcedMutexLocker lockIndex(pool._indexMutex);
+  _index = pool._index;
+}
+
+Pool::Pool(Pool&& pool) {
+  GLOBAL_LOCK_OF(pool);
+
+  _poolSingleReal = std::move(pool._poolSingleReal);
+  _poolSingleString = std::move(pool._poolSingleString);
+  _poolSingleVectorReal = std::move(pool._poolSingleVectorReal);
+  _poolSingleVectorString = std::move(pool._poolSingleVectorString);
+  _poolSingleTensorReal = std::move(pool._poolSingleTensorReal);
+  _poolReal = std::move(pool._poolReal);
+  _poolVectorReal = std::move(pool._poolVectorReal);
+  _poolString = std::move(pool._poolString);
+  _poolVectorString = std::move(pool._poolVectorString);
+  _poolArray2DReal = std::move(pool._poolArray2DReal);
+  _poolTensorReal = std::move(pool._poolTensorReal);
+  _poolStereoSample = std::move(pool._poolStereoSample);
+  pool._poolVectorRealCopies.clear();
+
+  ForcedMutexLocker lockIndex(pool._indexMutex);
+  _index = std::move(pool._index);
+}
+
+// The other pool is copied (or moved) to a temporary first, so that the two
+// pools are never locked at the same time
+Pool& Pool::operator=(const Pool& pool) {
+  if (this != &pool) *this = Pool(pool);
+  return *this;
+}
+
+Pool& Pool::operator=(Pool&& pool) {
+  if (this == &pool) return *this;
+  Pool other(std::move(pool));
+
+  GLOBAL_LOCK;
+
+  _poolSingleReal.swap(other._poolSingleReal);
+  _poolSingleString.swap(other._poolSingleString);
+  _poolSingleVectorReal.swap(other._poolSingleVectorReal);
+  _poolSingleVectorString.swap(other._poolSingleVectorString);
+  _poolSingleTensorReal.swap(other._poolSingleTensorReal);
+  _poolReal.swap(other._poolReal);
+  _poolVectorReal.swap(other._poolVectorReal);
+  _poolString.swap(other._poolString);
+  _poolVectorString.swap(other._poolVectorString);
+  _poolArray2DReal.swap(other._poolArray2DReal);
+  _poolTensorReal.swap(other._poolTensorReal);
+  _poolStereoSample.swap(other._poolStereoSample);
+  _poolVectorRealCopies.clear();
+
+  ForcedMutexLocker lockIndex(_indexMutex);
+  _index = std::move(other._index);
+  return *this;
+}
+
+
 void Pool::clear() {
   GLOBAL_LOCK;
 
   _poolReal.clear();
   _poolVectorReal.clear();
+  _poolVectorRealCopies.clear();
   _poolString.clear();
   _poolVectorString.clear();
   _poolArray2DReal.clear();
@@ -42,6 +202,11 @@ void Pool::clear() {
   _poolSingleVectorReal.clear();
   _poolSingleVectorString.clear();
   _poolSingleTensorReal.clear();
+
+  ForcedMutexLocker lockIndex(_indexMutex);
+  _index.names.clear();
+  _index.namespaces.clear();
+  _index.unbindHandles();
 }
 
 void Pool::checkIntegrity() const {
@@ -65,13 +230,18 @@ void Pool::checkIntegrity() const {
 // this implementation makes the assumption that the key 'name' only exists in
 // one of the sub-pools, as enforced by checkIntegrity
 void Pool::remove(const string& name) {
+  {
+    ForcedMutexLocker lock(mutexVectorReal);
+    _poolVectorRealCopies.erase(name);
+  }
 
   #define SEARCH_AND_DESTROY(t, tname)                                         \
   {                                                                            \
-    MutexLocker lock(mutex##tname);                                            \
+    ForcedMutexLocker lock(mutex##tname);                                            \
     map<string, t >::iterator i = _pool##tname.find(name);                     \
     if (i != _pool##tname.end()) {                                             \
       _pool##tname.erase(i);                                                   \
+      unindexKey(name);                                                        \
       return;                                                                  \
     }                                                                          \
   }
@@ -79,7 +249,7 @@ void Pool::remove(const string& name) {
   SEARCH_AND_DESTROY(Real, SingleReal);
   SEARCH_AND_DESTROY(vector<Real>, Real);
   SEARCH_AND_DESTROY(vector<Real>, SingleVectorReal);
-  SEARCH_AND_DESTROY(vector<vector<Real> >, VectorReal);
+  SEARCH_AND_DESTROY(VectorRealFrames, VectorReal);
 
   SEARCH_AND_DESTROY(string, SingleString);
   SEARCH_AND_DESTROY(vector<string>, String);
@@ -88,16 +258,24 @@ void Pool::remove(const string& name) {
 
   SEARCH_AND_DESTROY(vector<TNT::Array2D<Real> >, Array2DReal);
   SEARCH_AND_DESTROY(vector<Tensor<Real> >, TensorReal);
+  SEARCH_AND_DESTROY(Tensor<Real>, SingleTensorReal);
   SEARCH_AND_DESTROY(vector<StereoSample>, StereoSample);
 
   #undef SEARCH_AND_DESTROY
 }
 
 void Pool::removeNamespace(const string& ns) {
+  {
+    ForcedMutexLocker lock(mutexVectorReal);
+    PoolOf(vector<Real>)::iterator it = _poolVectorRealCopies.lower_bound(ns+".");
+    while (it != _poolVectorRealCopies.end() && it->first.compare(0, ns.size()+1, ns+".") == 0) {
+      _poolVectorRealCopies.erase(it++);
+    }
+  }
 
   #define SEARCH_AND_DESTROY(t, tname)                              \
   {                                                                 \
-    MutexLocker lock(mutex##tname);                                 \
+    ForcedMutexLocker lock(mutex##tname);                                 \
     map<string, t >::iterator it = _pool##tname.begin();            \
     int pos = 0;                                                    \
     /*temp iterator that keeps track of the position in the map*/   \
@@ -106,6 +284,7 @@ void Pool::removeNamespace(const string& ns) {
     while (it != _pool##tname.end()) {                              \
       string::size_type strIdx = it->first.find(ns+".");            \
       if (strIdx==0) {                                              \
+        unindexKey(it->first);                                      \
         _pool##tname.erase(it);                                     \
         if (pos == 0) it = _pool##tname.begin();                    \
         else it = tmpIt;                                            \
@@ -121,7 +300,7 @@ void Pool::removeNamespace(const string& ns) {
   SEARCH_AND_DESTROY(Real, SingleReal);
   SEARCH_AND_DESTROY(vector<Real>, Real);
   SEARCH_AND_DESTROY(vector<Real>, SingleVectorReal);
-  SEARCH_AND_DESTROY(vector<vector<Real> >, VectorReal);
+  SEARCH_AND_DESTROY(VectorRealFrames, VectorReal);
 
   SEARCH_AND_DESTROY(string, SingleString);
   SEARCH_AND_DESTROY(vector<string>, String);
@@ -129,6 +308,7 @@ void Pool::removeNamespace(const string& ns) {
   SEARCH_AND_DESTROY(vector<vector<string> >, VectorString);
 
   SEARCH_AND_DESTROY(vector<Tensor<Real> >, TensorReal);
+  SEARCH_AND_DESTROY(Tensor<Real>, SingleTensorReal);
   SEARCH_AND_DESTROY(vector<TNT::Array2D<Real> >, Array2DReal);
   SEARCH_AND_DESTROY(vector<StereoSample>, StereoSample);
 
@@ -136,13 +316,31 @@ void Pool::removeNamespace(const string& ns) {
 }
 
 
+const vector<vector<Real> >& Pool::vectorRealCopy(const string& name,
+                                                  const VectorRealFrames& frames) const {
+  vector<vector<Real> >& copy = _poolVectorRealCopies[name];
+  if (copy.size() > frames.size()) copy.clear();
+  frames.copyTo(copy, copy.size());
+  return copy;
+}
+
+const PoolOf(vector<Real>)& Pool::getVectorRealPool() const {
+  ForcedMutexLocker lock(mutexVectorReal);
+  for (map<string, VectorRealFrames>::const_iterator it = _poolVectorReal.begin();
+       it != _poolVectorReal.end(); ++it) {
+    vectorRealCopy(it->first, it->second);
+  }
+  return _poolVectorRealCopies;
+}
+
+
 vector<string> Pool::descriptorNames() const {
   vector<string> descNames;
   int i=0;
 
   #define ADD_DESC_NAMES(type, tname)                                          \
   {                                                                            \
-    MutexLocker lock(mutex##tname);                                            \
+    ForcedMutexLocker lock(mutex##tname);                                            \
     descNames.resize(descNames.size() + _pool##tname.size());                  \
     for (map<string, type >::const_iterator it = _pool##tname.begin();         \
          it != _pool##tname.end();                                             \
@@ -154,7 +352,7 @@ vector<string> Pool::descriptorNames() const {
   ADD_DESC_NAMES(Real, SingleReal);
   ADD_DESC_NAMES(vector<Real>, Real);
   ADD_DESC_NAMES(vector<Real>, SingleVectorReal);
-  ADD_DESC_NAMES(vector<vector<Real> >, VectorReal);
+  ADD_DESC_NAMES(VectorRealFrames, VectorReal);
   ADD_DESC_NAMES(string, SingleString);
   ADD_DESC_NAMES(vector<string>, String);
   ADD_DESC_NAMES(vector<string>, SingleVectorString);  
@@ -173,7 +371,7 @@ vector<string> Pool::descriptorNames(const std::string& ns) const {
   vector<string> descNames;
   #define ADD_DESC_NAMES(type, tname)                            \
   {                                                              \
-    MutexLocker lock(mutex##tname);                              \
+    ForcedMutexLocker lock(mutex##tname);                              \
     map<string, type>::const_iterator it = _pool##tname.begin(); \
     while (it != _pool##tname.end()) {                           \
       if (it->first.find(ns+".") == 0)                           \
@@ -185,7 +383,7 @@ vector<string> Pool::descriptorNames(const std::string& ns) const {
   ADD_DESC_NAMES(Real, SingleReal);
   ADD_DESC_NAMES(vector<Real>, Real);
   ADD_DESC_NAMES(vector<Real>, SingleVectorReal);
-  ADD_DESC_NAMES(vector<vector<Real> >, VectorReal);
+  ADD_DESC_NAMES(VectorRealFrames, VectorReal);
   ADD_DESC_NAMES(string, SingleString);
   ADD_DESC_NAMES(vector<string>, String);
   ADD_DESC_NAMES(vector<string>, SingleVectorString);
@@ -227,7 +425,7 @@ vector<string> Pool::descriptorNamesNoLocking() const {
   ADD_DESC_NAMES(Real, SingleReal);
   ADD_DESC_NAMES(vector<Real>, Real);
   ADD_DESC_NAMES(vector<Real>, SingleVectorReal);
-  ADD_DESC_NAMES(vector<vector<Real> >, VectorReal);
+  ADD_DESC_NAMES(VectorRealFrames, VectorReal);
   ADD_DESC_NAMES(string, SingleString);
   ADD_DESC_NAMES(vector<string>, String);
   ADD_DESC_NAMES(vector<string>, SingleVectorString);
@@ -242,39 +440,157 @@ vector<string> Pool::descriptorNamesNoLocking() const {
   return descNames;
 }
 
+Pool::DescriptorIndex::DescriptorIndex(const DescriptorIndex& index) :
+  names(index.names), namespaces(index.namespaces) {}
+
+Pool::DescriptorIndex::DescriptorIndex(DescriptorIndex&& index) :
+  names(std::move(index.names)), namespaces(std::move(index.namespaces)) {
+  index.names.clear();
+  index.namespaces.clear();
+  index.unbindHandles();
+}
+
+Pool::DescriptorIndex& Pool::DescriptorIndex::operator=(const DescriptorIndex& index) {
+  if (this != &index) {
+    names = index.names;
+    namespaces = index.namespaces;
+    unbindHandles();
+  }
+  return *this;
+}
+
+Pool::DescriptorIndex& Pool::DescriptorIndex::operator=(DescriptorIndex&& index) {
+  if (this != &index) {
+    names = std::move(index.names);
+    namespaces = std::move(index.namespaces);
+    index.names.clear();
+    index.namespaces.clear();
+    unbindHandles();
+    index.unbindHandles();
+  }
+  return *this;
+}
+
+Pool::DescriptorIndex::~DescriptorIndex() {
+  for (unordered_map<string, DescriptorHandle::Entry*>::iterator it = handles.begin();
+       it != handles.end(); ++it) {
+    delete it->second;
+  }
+}
+
+void Pool::DescriptorIndex::unbindHandles() {
+  for (unordered_map<string, DescriptorHandle::Entry*>::iterator it = handles.begin();
+       it != handles.end(); ++it) {
+    it->second->values = 0;
+  }
+}
+
+
+const string& DescriptorHandle::name() const {
+  if (!_entry) throw EssentiaException("DescriptorHandle: invalid handle");
+  return _entry->name;
+}
+
+
 void Pool::validateKey(const string& name) {
-  std::vector<std::string> allNames = descriptorNamesNoLocking();
-  for (int i=0; i<int(allNames.size()); ++i) {
-    /* first check if name already exists in another sub-pool */
-    if (name == allNames[i]) {
-      throw EssentiaException("Pool: Cannot set/add/merge value to the pool under "
-                              "the name '"+name+"' because that name already exists but "
-                              "contains a different data type than value");
-    }
-    /* now check if adding this new key will result in a parent descriptor
-     * having a value and child descriptors (there are 2 cases where this can
-     * happen)*/
-    if ( name.find(allNames[i] + ".") == 0 ) {
+  checkKey(name);
+  indexKey(name);
+}
+
+void Pool::checkKey(const string& name) const {
+  ForcedMutexLocker lock(_indexMutex);
+
+  /* first check if name already exists in another sub-pool */
+  if (_index.names.count(name)) {
+    throw EssentiaException("Pool: Cannot set/add/merge value to the pool under "
+                            "the name '"+name+"' because that name already exists but "
+                            "contains a different data type than value");
+  }
+
+  /* now check if adding this new key will result in a parent descriptor
+   * having a value and child descriptors (there are 2 cases where this can
+   * happen)*/
+  for (string::size_type pos = name.find('.'); pos != string::npos; pos = name.find('.', pos+1)) {
+    string parent = name.substr(0, pos);
+    if (_index.names.count(parent)) {
       throw EssentiaException("Pool: Cannot set/add/merge value to the pool under the name '"+name+
                               "' because '"+name+"' has a parent descriptor name already in "
-                              "the pool (e.g. '"+allNames[i]+"')");
+                              "the pool (e.g. '"+parent+"')");
     }
+  }
 
-    if ( allNames[i].find(name+".") == 0 ) {
-      throw EssentiaException("Pool: Cannot add/set/merge value to the pool under "
-                              "the name '"+name+"' because '"+name+"' has child descriptor "
-                              "names (e.g. '"+allNames[i]+"')");
+  if (_index.namespaces.count(name)) {
+    string child;
+    for (unordered_set<string>::const_iterator it = _index.names.begin(); it != _index.names.end(); ++it) {
+      if (it->find(name+".") == 0) {
+        child = *it;
+        break;
+      }
     }
+    throw EssentiaException("Pool: Cannot add/set/merge value to the pool under "
+                            "the name '"+name+"' because '"+name+"' has child descriptor "
+                            "names (e.g. '"+child+"')");
   }
 }
 
+void Pool::indexKey(const string& name) {
+  ForcedMutexLocker lock(_indexMutex);
+  _index.names.insert(name);
+  for (string::size_type pos = name.find('.'); pos != string::npos; pos = name.find('.', pos+1)) {
+    _index.namespaces[name.substr(0, pos)]++;
+  }
+}
+
+void Pool::unindexKey(const string& name) {
+  ForcedMutexLocker lock(_indexMutex);
+  if (!_index.names.erase(name)) return;
+
+  for (string::size_type pos = name.find('.'); pos != string::npos; pos = name.find('.', pos+1)) {
+    unordered_map<string, int>::iterator ns = _index.namespaces.find(name.substr(0, pos));
+    if (--ns->second == 0) _index.namespaces.erase(ns);
+  }
+
+  unordered_map<string, DescriptorHandle::Entry*>::iterator handle = _index.handles.find(name);
+  if (handle != _index.handles.end()) handle->second->values = 0;
+}
+
+
+DescriptorHandle Pool::newHandle(const string& name, const void* subPool, void* values) {
+  ForcedMutexLocker lock(_indexMutex);
+  DescriptorHandle::Entry*& entry = _index.handles[name];
+  if (!entry) {
+    entry = new DescriptorHandle::Entry();
+    entry->name = name;
+    entry->pool = this;
+    entry->subPool = subPool;
+  }
+  else if (entry->subPool != subPool) {
+    throw EssentiaException("Pool: Cannot create a handle for the name '"+name+"' because a "
+                            "handle for a different data type already exists");
+  }
+  entry->values = values;
+  return DescriptorHandle(entry);
+}
+
+DescriptorHandle::Entry* Pool::handleEntry(const DescriptorHandle& handle, const void* subPool) const {
+  DescriptorHandle::Entry* entry = handle._entry;
+  if (!entry || entry->pool != this) {
+    throw EssentiaException("Pool: the descriptor handle was not created by this pool");
+  }
+  if (entry->subPool != subPool) {
+    throw EssentiaException("Pool: Cannot add value to the pool under the name '"+entry->name+
+                            "' because the handle was created for a different data type than value");
+  }
+  return entry;
+}
+
 #define SPECIALIZE_ADD_IMPL(type, tname)                                     \
 void Pool::add(const string& name, const type& value, bool validityCheck) {  \
                                                                              \
   /* first check if the pool has ever seen this key before, if it has, we can
    * just add it, if not, we need to run some validation tests */            \
   {                                                                          \
-    MutexLocker lock(mutex##tname);                                          \
+    ForcedMutexLocker lock(mutex##tname);                                          \
     if (validityCheck && !isValid(value)) {                                  \
       throw EssentiaException("Pool::add value contains invalid numbers (NaN or inf)");\
     }                                                                        \
@@ -285,7 +601,8 @@ void Pool::add(const string& name, const type& value, bool validityCheck) {  \
   }                                                                          \
   /* validating will require checking all sub-pools, acquire a global lock*/ \
   GLOBAL_LOCK                                                                \
-  validateKey(name);                                                         \
+  /* another thread may have added it in the meantime */                     \
+  if (_pool##tname.find(name) == _pool##tname.end()) validateKey(name);      \
   _pool##tname[name].push_back(value);                                       \
 }
 
@@ -297,11 +614,43 @@ SPECIALIZE_ADD_IMPL(vector<string>, VectorString);
 SPECIALIZE_ADD_IMPL(StereoSample, StereoSample);
 
 
+#define SPECIALIZE_ADD_HANDLE_IMPL(type, storage, tname)                                     \
+void Pool::add(const DescriptorHandle& handle, const type& value, bool validityCheck) {      \
+  DescriptorHandle::Entry* entry = handleEntry(handle, &_pool##tname);                       \
+  {                                                                                          \
+    ForcedMutexLocker lock(mutex##tname);                                                          \
+    if (validityCheck && !isValid(value)) {                                                  \
+      throw EssentiaException("Pool::add value contains invalid numbers (NaN or inf)");      \
+    }                                                                                        \
+    if (entry->values) {                                                                     \
+      static_cast<storage*>(entry->values)->push_back(value);                                \
+      return;                                                                                \
+    }                                                                                        \
+  }                                                                                          \
+  /* the descriptor does not exist yet or was removed, or values were added to it
+   * by name only: look it up and bind the handle to its values */                           \
+  GLOBAL_LOCK                                                                                \
+  map<string, storage >::iterator it = _pool##tname.find(entry->name);                       \
+  if (it == _pool##tname.end()) {                                                            \
+    validateKey(entry->name);                                                                \
+    it = _pool##tname.insert(make_pair(entry->name, storage())).first;                       \
+  }                                                                                          \
+  it->second.push_back(value);                                                               \
+  entry->values = &it->second;                                                               \
+}
+
+SPECIALIZE_ADD_HANDLE_IMPL(Real, vector<Real>, Real);
+SPECIALIZE_ADD_HANDLE_IMPL(vector<Real>, VectorRealFrames, VectorReal);
+SPECIALIZE_ADD_HANDLE_IMPL(string, vector<string>, String);
+SPECIALIZE_ADD_HANDLE_IMPL(vector<string>, vector<vector<string> >, VectorString);
+SPECIALIZE_ADD_HANDLE_IMPL(StereoSample, vector<StereoSample>, StereoSample);
+
+
 void Pool::add(const string& name, const Tensor<Real>& value, bool validityCheck) {
   /* first check if the pool has ever seen this key before, if it has, we can
    * just add it, if not, we need to run some validation tests */
   {
-    MutexLocker lock(mutexTensorReal);
+    ForcedMutexLocker lock(mutexTensorReal);
     if (validityCheck && !isValid(value)) {
       throw EssentiaException("Pool::add tensor contains invalid numbers (NaN or inf)");
     }
@@ -311,7 +660,8 @@ void Pool::add(const string& name, const Tensor<Real>& value, bool validityCheck
     }
   }
   GLOBAL_LOCK
-  validateKey(name);
+  // another thread may have added it in the meantime
+  if (_poolTensorReal.find(name) == _poolTensorReal.end()) validateKey(name);
   _poolTensorReal[name].push_back(Tensor<Real>(value));
 }
 
@@ -322,7 +672,7 @@ void Pool::add(const string& name, const Array2D<Real>& value, bool validityChec
   /* first check if the pool has ever seen this key before, if it has, we can
    * just add it, if not, we need to run some validation tests */
   {
-    MutexLocker lock(mutexArray2DReal);
+    ForcedMutexLocker lock(mutexArray2DReal);
     if (validityCheck && !isValid(value)) {
       throw EssentiaException("Pool::add array contains invalid numbers (NaN or inf)");
     }
@@ -332,7 +682,8 @@ void Pool::add(const string& name, const Array2D<Real>& value, bool validityChec
     }
   }
   GLOBAL_LOCK
-  validateKey(name);
+  // another thread may have added it in the meantime
+  if (_poolArray2DReal.find(name) == _poolArray2DReal.end()) validateKey(name);
   _poolArray2DReal[name].push_back(value.copy());
 }
 
@@ -342,7 +693,7 @@ void Pool::set(const string& name, const type& value, bool validityCheck) {  \
   /* first check if the pool has ever seen this key before, if it has, we can
    * just set it, if not, we need to run some validation tests */            \
   {                                                                          \
-    MutexLocker lock(mutexSingle##tname);                                    \
+    ForcedMutexLocker lock(mutexSingle##tname);                                    \
     if (validityCheck && !isValid(value)) {                                  \
       throw EssentiaException("Pool::set value contains invalid numbers (NaN or inf)");\
     }                                                                        \
@@ -352,7 +703,8 @@ void Pool::set(const string& name, const type& value, bool validityCheck) {  \
     }                                                                        \
   }                                                                          \
   GLOBAL_LOCK                                                                \
-  validateKey(name);                                                         \
+  /* another thread may have set it in the meantime */                       \
+  if (_poolSingle##tname.find(name) == _poolSingle##tname.end()) validateKey(name);\
   _poolSingle##tname[name] = value;                                          \
 }
 
@@ -366,7 +718,7 @@ void Pool::set(const string& name, const Tensor<Real>& value, bool validityCheck
   /* first check if the pool has ever seen this key before, if it has, we can
    * just add it, if not, we need to run some validation tests */
   {
-    MutexLocker lock(mutexSingleTensorReal);
+    ForcedMutexLocker lock(mutexSingleTensorReal);
     if (validityCheck && !isValid(value)) {
       throw EssentiaException("Pool::set tensor contains invalid numbers (NaN or inf)");
     }
@@ -377,7 +729,8 @@ void Pool::set(const string& name, const Tensor<Real>& value, bool validityCheck
     }
   }
   GLOBAL_LOCK
-  validateKey(name);
+  // another thread may have set it in the meantime
+  if (_poolSingleTensorReal.find(name) == _poolSingleTensorReal.end()) validateKey(name);
 
   _poolSingleTensorReal[name].resize(value.dimensions());
   _poolSingleTensorReal[name] = value;
@@ -386,12 +739,12 @@ void Pool::set(const string& name, const Tensor<Real>& value, bool validityCheck
 
 void Pool::merge(Pool& p, const string& mergeType) {
 
-  #define MERGE_POOL(t, tname) {                                                     \
+  #define MERGE_POOL(t, storage, tname) {                                            \
     vector<string> descNames;                                                        \
     descNames.reserve(p.get##tname##Pool().size());                                  \
     {                                                                                \
-      MutexLocker lock(p.mutex##tname);                                              \
-      for (map<string, vector<t> >::const_iterator it = p.get##tname##Pool().begin();\
+      ForcedMutexLocker lock(p.mutex##tname);                                              \
+      for (map<string, storage >::const_iterator it = p.get##tname##Pool().begin();  \
            it != p.get##tname##Pool().end();                                         \
            ++it) {                                                                   \
         descNames.push_back(it->first);                                              \
@@ -406,7 +759,7 @@ void Pool::merge(Pool& p, const string& mergeType) {
     vector<string> descNames;                                                \
     descNames.reserve(p.get##tname##Pool().size());                          \
     {                                                                        \
-      MutexLocker lock(p.mutex##tname);                                    \
+      ForcedMutexLocker lock(p.mutex##tname);                                    \
       for (map<string, t>::const_iterator it = p.get##tname##Pool().begin(); \
            it != p.get##tname##Pool().end();                                 \
            ++it) {                                                           \
@@ -426,13 +779,32 @@ void Pool::merge(Pool& p, const string& mergeType) {
   MERGE_SINGLE_POOL(Tensor<Real>, SingleTensorReal);
 
   // multiple value:
-  MERGE_POOL(Real, Real);
-  MERGE_POOL(string, String);
-  MERGE_POOL(vector<Real>, VectorReal);
-  MERGE_POOL(vector<string>, VectorString);
-  MERGE_POOL(StereoSample, StereoSample);
-  MERGE_POOL(TNT::Array2D<Real>, Array2DReal);
-  MERGE_POOL(Tensor<Real>, TensorReal);
+  MERGE_POOL(Real, vector<Real>, Real);
+  MERGE_POOL(string, vector<string>, String);
+
+  // the frames of vectors of Reals are copied one descriptor at a time
+  {
+    vector<string> descNames;
+    descNames.reserve(p.getVectorRealFramesPool().size());
+    {
+      ForcedMutexLocker lock(p.mutexVectorReal);
+      for (map<string, VectorRealFrames>::const_iterator it = p.getVectorRealFramesPool().begin();
+           it != p.getVectorRealFramesPool().end();
+           ++it) {
+        descNames.push_back(it->first);
+      }
+    }
+    for (int i=0; i < int(descNames.size()); ++i) {
+      vector<vector<Real> > frames;
+      p.value<VectorRealFrames>(descNames[i]).copyTo(frames);
+      merge(descNames[i], frames, mergeType);
+    }
+  }
+
+  MERGE_POOL(vector<string>, vector<vector<string> >, VectorString);
+  MERGE_POOL(StereoSample, vector<StereoSample>, StereoSample);
+  MERGE_POOL(TNT::Array2D<Real>, vector<TNT::Array2D<Real> >, Array2DReal);
+  MERGE_POOL(Tensor<Real>, vector<Tensor<Real> >, TensorReal);
 
   #undef MERGE_SINGLE_POOL
   #undef MERGE_POOL
@@ -445,7 +817,7 @@ void Pool::merge(const string& name, const vector<type>& value, const string& me
   /* first check if the pool has ever seen this key before, if it has, we can
    * just add it, if not, we need to run some validation tests */                                      \
   {                                                                                                    \
-    MutexLocker lock(mutex##tname);                                                                    \
+    ForcedMutexLocker lock(mutex##tname);                                                                    \
     map<string, vector<type> >::iterator it = _pool##tname.find(name);                                 \
     if (it != _pool##tname.end()) {                                                                    \
       if (mergeType == "") {                                                                           \
@@ -460,22 +832,20 @@ void Pool::merge(const string& name, const vector<type>& value, const string& me
         }                                                                                              \
       }                                                                                                \
       else if (mergeType == "replace") {                                                               \
-        _pool##tname.erase(it);                                                                        \
-        _pool##tname.insert(make_pair(name, value));                                                   \
+        /* values are replaced in place, so that handles to them remain valid */                       \
+        it->second = value;                                                                            \
       }                                                                                                \
       else if (mergeType=="interleave") {                                                              \
-        if (value.size() != _pool##tname[name].size()) {                                               \
+        if (value.size() != it->second.size()) {                                                       \
           throw EssentiaException("Pool::merge, cannot interleave descriptors with different sizes :", name);\
         }                                                                                              \
-        vector<type> temp = _pool##tname[name];                                                        \
-        _pool##tname.erase(it);\
-        _pool##tname[name].push_back(temp[0]);                                                         \
-        _pool##tname[name].push_back(value[0]);                                                        \
-        _pool##tname[name].reserve(2*temp.size());                                                     \
-        for (int i=1; i<(int)temp.size(); i++) {                                                       \
-          _pool##tname[name].push_back(temp[i]);                                                       \
-          _pool##tname[name].push_back(value[i]);                                                      \
+        vector<type> interleaved;                                                                      \
+        interleaved.reserve(2*value.size());                                                           \
+        for (int i=0; i<(int)value.size(); i++) {                                                      \
+          interleaved.push_back(it->second[i]);                                                        \
+          interleaved.push_back(value[i]);                                                             \
         }                                                                                              \
+        it->second.swap(interleaved);                                                                  \
         return;\
       }                                                                                                \
       else {                                                                                           \
@@ -494,19 +864,75 @@ void Pool::merge(const string& name, const vector<type>& value, const string& me
 }
 
 SPECIALIZE_MERGE_IMPL(Real, Real);
-SPECIALIZE_MERGE_IMPL(vector<Real>, VectorReal);
 SPECIALIZE_MERGE_IMPL(string, String);
 SPECIALIZE_MERGE_IMPL(vector<string>, VectorString);
 SPECIALIZE_MERGE_IMPL(StereoSample, StereoSample);
 SPECIALIZE_MERGE_IMPL(Tensor<Real>, TensorReal);
 
+void Pool::merge(const string& name, const vector<vector<Real> >& value, const string& mergeType) {
+  if (value.empty()) return;
+
+  /* first check if the pool has ever seen this key before, if it has, we can
+   * just add it, if not, we need to run some validation tests */
+  {
+    ForcedMutexLocker lock(mutexVectorReal);
+    map<string, VectorRealFrames>::iterator it = _poolVectorReal.find(name);
+    if (it != _poolVectorReal.end()) {
+      VectorRealFrames& frames = it->second;
+      if (mergeType == "") {
+        throw EssentiaException("Pool::merge, cannot merge descriptor names with the same name:" +
+                                name + " unless a merge type (\"append\", \"replace\" or " +
+                                "\"interleave\") is specified");
+      }
+      else if (mergeType=="append") {
+        frames.reserve(frames.size()+value.size());
+        for (int i=0; i<int(value.size()); i++) {
+          frames.push_back(value[i]);
+        }
+      }
+      else if (mergeType == "replace") {
+        _poolVectorRealCopies.erase(name);
+        frames.clear();
+        frames.reserve(value.size());
+        for (int i=0; i<int(value.size()); i++) {
+          frames.push_back(value[i]);
+        }
+      }
+      else if (mergeType=="interleave") {
+        if (value.size() != frames.size()) {
+          throw EssentiaException("Pool::merge, cannot interleave descriptors with different sizes :", name);
+        }
+        _poolVectorRealCopies.erase(name);
+        VectorRealFrames interleaved;
+        interleaved.reserve(2*value.size());
+        for (int i=0; i<(int)value.size(); i++) {
+          interleaved.push_back(frames.frame(i));
+          interleaved.push_back(value[i]);
+        }
+        std::swap(frames, interleaved);
+      }
+      else {
+        throw EssentiaException("Pool::merge, unknown merge type: ", mergeType);
+      }
+      return;
+    }
+  }
+  GLOBAL_LOCK
+  validateKey(name);
+  VectorRealFrames& frames = _poolVectorReal[name];
+  frames.reserve(value.size());
+  for (int i=0; i<(int)value.size(); ++i) {
+    frames.push_back(value[i]);
+  }
+}
+
 #define SPECIALIZE_MERGE_SINGLE_IMPL(type, tname)                                                      \
 void Pool::mergeSingle(const string& name, const type& value, const string& mergeType) {               \
                                                                                                        \
   /* first check if the pool has ever seen this key before, if it has, we can
    * just add it, if not, we need to run some validation tests */                                      \
   {                                                                                                    \
-    MutexLocker lock(mutexSingle##tname);                                                              \
+    ForcedMutexLocker lock(mutexSingle##tname);                                                              \
     map<string, type>::iterator it = _poolSingle##tname.find(name);                                    \
     if (it != _poolSingle##tname.end()) {                                                              \
       if (mergeType == "replace") {                                                                    \
@@ -537,7 +963,7 @@ void Pool::merge(const string& name, const vector<Array2D<Real> >& value, const
   /* first check if the pool has ever seen this key before, if it has, we can
    * just add it, if not, we need to run some validation tests */
   {
-    MutexLocker lock(mutexArray2DReal);
+    ForcedMutexLocker lock(mutexArray2DReal);
     map<string, vector<Array2D<Real> > >::iterator it = _poolArray2DReal.find(name);
     if (it != _poolArray2DReal.end()) {
       if (mergeType == "") {
@@ -552,25 +978,23 @@ void Pool::merge(const string& name, const vector<Array2D<Real> >& value, const
         }
       }
       else if (mergeType == "replace") {
-        _poolArray2DReal.erase(it);
-        _poolArray2DReal[name].reserve(value.size());
+        it->second.clear();
+        it->second.reserve(value.size());
         for(int i=0; i<int(value.size()); i++) {
-          _poolArray2DReal[name].push_back(value[i].copy());
+          it->second.push_back(value[i].copy());
         }
       }
       else if (mergeType=="interleave") {
-        if (value.size() != _poolArray2DReal[name].size()) {
+        if (value.size() != it->second.size()) {
           throw EssentiaException("Pool::merge, cannot interleave descriptors with different sizes :", name);
         }
-        vector<Array2D<Real> > temp = _poolArray2DReal[name];
-        _poolArray2DReal.erase(it);
-        _poolArray2DReal[name].push_back(temp[0].copy());
-        _poolArray2DReal[name].push_back(value[0].copy());
-        _poolArray2DReal[name].reserve(2*temp.size());
-        for (int i=1; i<(int)temp.size(); i++) {
-          _poolArray2DReal[name].push_back(temp[i].copy());
-          _poolArray2DReal[name].push_back(value[i].copy());
+        vector<Array2D<Real> > interleaved;
+        interleaved.reserve(2*value.size());
+        for (int i=0; i<(int)value.size(); i++) {
+          interleaved.push_back(it->second[i]);
+          interleaved.push_back(value[i].copy());
         }
+        it->second.swap(interleaved);
         return;
       }
       else {
@@ -591,7 +1015,7 @@ void Pool::merge(const string& name, const vector<Array2D<Real> >& value, const
 bool Pool::isSingleValue(const string& name) {
   #define SEARCH_SINGLE(t, tname)                                              \
   {                                                                            \
-    MutexLocker lock(mutex##tname);                                            \
+    ForcedMutexLocker lock(mutex##tname);                                            \
     map<string, t >::iterator i = _pool##tname.find(name);                     \
     if (i != _pool##tname.end()) {                                             \
       return true;                                                             \
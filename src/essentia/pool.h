@@ -20,6 +20,9 @@
 #ifndef ESSENTIA_POOL_H
 #define ESSENTIA_POOL_H
 
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include "types.h"
 #include "threading.h"
 #include "utils/tnt/tnt.h"
@@ -34,6 +37,124 @@ namespace essentia {
 
 typedef std::string DescriptorName;
 
+class Pool;
+
+/**
+ * Storage for the frames of a descriptor of type std::vector<Real>, such as
+ * the MFCCs or the HPCPs of each frame of an audio file.
+ *
+ * As long as all the frames have the same size, they are stored one after the
+ * other in a single contiguous block, that is, as a row-major matrix that can
+ * be accessed with data() without any copy. When a frame of a different size
+ * is added, the frames are moved to a vector of frames.
+ *
+ * In both cases, each frame can be read in place with row() and rowSize().
+ *
+ * The contiguous block can be shared (see sharedData()), e.g. to expose it to
+ * python without copying it. A shared block is never modified: it is copied
+ * first if frames are added to it afterwards.
+ */
+class ESSENTIA_API VectorRealFrames {
+ public:
+  VectorRealFrames() : _data(std::make_shared<std::vector<Real> >()),
+                       _size(0), _frameSize(0), _contiguous(true) {}
+
+  /**
+   * @returns the number of frames
+   */
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  /**
+   * @returns whether all the frames have the same size and are stored in a
+   *          contiguous block
+   */
+  bool isContiguous() const { return _contiguous; }
+
+  /**
+   * @returns the size of the frames. Throws an exception if the frames are not
+   *          contiguous.
+   */
+  size_t frameSize() const;
+
+  /**
+   * @returns the contiguous block of size()*frameSize() values in which the
+   *          frames are stored. Throws an exception if the frames are not
+   *          contiguous.
+   */
+  const Real* data() const;
+
+  /**
+   * @returns the contiguous block of size()*frameSize() values in which the
+   *          frames are stored, which stays valid and unchanged even if frames
+   *          are added to this storage or it is destroyed. Throws an exception
+   *          if the frames are not contiguous.
+   */
+  std::shared_ptr<const std::vector<Real> > sharedData() const;
+
+  /**
+   * @returns the values of the i-th frame, which has rowSize(i) values
+   */
+  const Real* row(size_t i) const;
+  size_t rowSize(size_t i) const { return _contiguous ? _frameSize : _frames[i].size(); }
+
+  /**
+   * @returns a copy of the i-th frame
+   */
+  std::vector<Real> frame(size_t i) const;
+
+  /**
+   * Appends a copy of the frames starting at the @c first one to @c frames
+   */
+  void copyTo(std::vector<std::vector<Real> >& frames, size_t first=0) const;
+
+  void push_back(const std::vector<Real>& frame);
+  void reserve(size_t nFrames);
+  void clear();
+
+ protected:
+  void makeJagged();
+
+  // copies the contiguous block if it is shared, before modifying it
+  void detach();
+
+  std::shared_ptr<std::vector<Real> > _data;
+  size_t _size;
+  size_t _frameSize;
+  bool _contiguous;
+
+  // all the frames if they are not contiguous, empty otherwise
+  std::vector<std::vector<Real> > _frames;
+};
+
+/**
+ * Handle to a descriptor name of a Pool, as returned by Pool::descriptorHandle().
+ * Values added through a handle go directly to the storage of the descriptor,
+ * without looking up or validating its name again. A handle can only be used
+ * with the Pool that created it, and only as long as this Pool exists.
+ */
+class ESSENTIA_API DescriptorHandle {
+ public:
+  DescriptorHandle() : _entry(0) {}
+
+  bool isValid() const { return _entry != 0; }
+  const std::string& name() const;
+
+ protected:
+  friend class Pool;
+
+  struct Entry {
+    std::string name;
+    const Pool* pool;     // pool that created the handle
+    const void* subPool;  // sub-pool the values are added to
+    void* values;         // values of the descriptor, or 0 if they don't exist yet
+  };
+
+  explicit DescriptorHandle(Entry* entry) : _entry(entry) {}
+
+  Entry* _entry;
+};
+
 /**
  * The pool is a storage structure which can hold frames of all kinds of
  * descriptors. A Pool instance is thread-safe.
@@ -66,6 +187,11 @@ typedef std::string DescriptorName;
  * of Reals, a @b vector @b of @b vector of Reals is returned when the data is
  * retrieved.
  *
+ * Vectors of Reals added under the same name, such as the values of a
+ * frame-wise descriptor, are stored contiguously when they all have the same
+ * size. They can then be accessed as a matrix, without copying them, with
+ * value<VectorRealFrames>().
+ *
  * It is not allowed to mix data types under the same descriptor name. Each of
  * the four types listed above are treated as separate types. In addition, a descriptor name that
  * maps to a single datum is considered mapping to a different type than a descriptor name that maps
@@ -77,18 +203,25 @@ typedef std::string DescriptorName;
  * into a Pool using the YamlInput algorithm.
  *
  * For each type, the pool has its own public mutex (i.e. mutexReal, mutexVectorReal, etc.)
+ * These are real mutexes (ForcedMutex), as a pool can be filled from several
+ * threads, e.g. by algorithms run without the Python GIL. The references
+ * returned by value() and the get*Pool() accessors are not protected once
+ * returned though, so they should not be used while other threads modify the
+ * same descriptors.
  * If locking the pool globally or partially, lock should be acquired in the following order:
  *
- *         MutexLocker lockReal(mutexReal)
- *         MutexLocker lockVectorReal(mutexVectorReal)
- *         MutexLocker lockString(mutexString)
- *         MutexLocker lockVectorString(mutexVectorString)
- *         MutexLocker lockArray2DReal(mutexArray2DReal)
- *         MutexLocker lockStereoSample(mutexStereoSample)
- *         MutexLocker lockSingleReal(mutexSingleReal)
- *         MutexLocker lockSingleString(mutexSingleString)
- *         MutexLocker lockSingleVectorReal(mutexSingleVectorReal)
- *         MutexLocker lockSingleVectorString(mutexSingleVectorString)
+ *         ForcedMutexLocker lockReal(mutexReal)
+ *         ForcedMutexLocker lockVectorReal(mutexVectorReal)
+ *         ForcedMutexLocker lockString(mutexString)
+ *         ForcedMutexLocker lockVectorString(mutexVectorString)
+ *         ForcedMutexLocker lockArray2DReal(mutexArray2DReal)
+ *         ForcedMutexLocker lockTensorReal(mutexTensorReal)
+ *         ForcedMutexLocker lockStereoSample(mutexStereoSample)
+ *         ForcedMutexLocker lockSingleReal(mutexSingleReal)
+ *         ForcedMutexLocker lockSingleString(mutexSingleString)
+ *         ForcedMutexLocker lockSingleVectorReal(mutexSingleVectorReal)
+ *         ForcedMutexLocker lockSingleVectorString(mutexSingleVectorString)
+ *         ForcedMutexLocker lockSingleTensorReal(mutexSingleTensorReal)
  *
  * To release the locks, the order should be reversed!
  *
@@ -105,29 +238,94 @@ class ESSENTIA_API Pool {
 
   // maps for vectors of values:
   PoolOf(Real) _poolReal;
-  PoolOf(std::vector<Real>) _poolVectorReal;
+  std::map<std::string, VectorRealFrames> _poolVectorReal;
   PoolOf(std::string) _poolString;
   PoolOf(std::vector<std::string>) _poolVectorString;
   PoolOf(TNT::Array2D<Real>) _poolArray2DReal;
   PoolOf(Tensor<Real>) _poolTensorReal;
   PoolOf(StereoSample) _poolStereoSample;
 
+  /**
+   * Index of the descriptor names of all the sub-pools, so that new names can
+   * be validated without scanning the pool, and registry of the handles given
+   * out by the pool. As handles are bound to the pool that created them, a copy
+   * of the index has no handles, and the handles of an index that is assigned
+   * to or moved from are unbound from their values.
+   */
+  class DescriptorIndex {
+   public:
+    DescriptorIndex() {}
+    DescriptorIndex(const DescriptorIndex& index);
+    DescriptorIndex(DescriptorIndex&& index);
+    DescriptorIndex& operator=(const DescriptorIndex& index);
+    DescriptorIndex& operator=(DescriptorIndex&& index);
+    ~DescriptorIndex();
+
+    void unbindHandles();
+
+    std::unordered_set<std::string> names;
+    // number of descriptor names under each namespace
+    std::unordered_map<std::string, int> namespaces;
+    std::unordered_map<std::string, DescriptorHandle::Entry*> handles;
+  };
+
+  DescriptorIndex _index;
+  mutable ForcedMutex _indexMutex;
+
+  /**
+   * Copies of the frames of _poolVectorReal as vectors of frames, only built
+   * for the accessors that return them as such (getVectorRealPool() and
+   * value<std::vector<std::vector<Real> > >()). Only the frames added since
+   * the last call are copied, and the copy of a descriptor is dropped when the
+   * descriptor is removed or its frames are replaced. They are protected by
+   * mutexVectorReal.
+   */
+  mutable PoolOf(std::vector<Real>) _poolVectorRealCopies;
+
+  // WARNING: this function assumes that mutexVectorReal is locked
+  const std::vector<std::vector<Real> >& vectorRealCopy(const std::string& name,
+                                                        const VectorRealFrames& frames) const;
+
   // WARNING: this function assumes that all sub-pools are locked
   std::vector<std::string> descriptorNamesNoLocking() const;
 
   /**
    * helper function for key validation when adding/setting/merging values to
-   * the pool
+   * the pool. As it is always followed by the insertion of the key, it also
+   * adds the key to the index
    */
    void validateKey(const std::string& name);
 
+  /**
+   * throws an exception if @e name cannot be added to the pool, because it
+   * already exists or it has a parent or child descriptor names
+   */
+  void checkKey(const std::string& name) const;
+  void indexKey(const std::string& name);
+  void unindexKey(const std::string& name);
+
+  DescriptorHandle newHandle(const std::string& name, const void* subPool, void* values);
+  DescriptorHandle::Entry* handleEntry(const DescriptorHandle& handle, const void* subPool) const;
+
 
  public:
 
-  mutable Mutex mutexReal, mutexVectorReal, mutexString, mutexVectorString,
-                mutexArray2DReal, mutexStereoSample,
-                mutexSingleReal, mutexSingleString, mutexSingleVectorReal,
-                mutexSingleVectorString, mutexTensorReal, mutexSingleTensorReal;
+  mutable ForcedMutex mutexReal, mutexVectorReal, mutexString, mutexVectorString,
+                      mutexArray2DReal, mutexStereoSample,
+                      mutexSingleReal, mutexSingleString, mutexSingleVectorReal,
+                      mutexSingleVectorString, mutexTensorReal, mutexSingleTensorReal;
+
+  Pool() {}
+
+  /**
+   * Copies (or moves) the descriptors of @e pool, which is locked meanwhile.
+   * The mutexes are not copied, and the handles of @e pool are not valid
+   * for the copy (see descriptorHandle()).
+   */
+  Pool(const Pool& pool);
+  Pool(Pool&& pool);
+  Pool& operator=(const Pool& pool);
+  Pool& operator=(Pool&& pool);
 
   /**
    * Adds @e value to the Pool under @e name
@@ -171,6 +369,47 @@ class ESSENTIA_API Pool {
   /** @copydoc add(const std::string&,const Real&,bool) */
   void add(const std::string& name, const StereoSample& value, bool validityCheck = false);
 
+  /**
+   * Adds @e value to the Pool under the descriptor name of @e handle, in the
+   * same way as add(const std::string&,const Real&,bool).
+   * @remark @e handle must have been created by this Pool for the type of
+   *         @e value, otherwise an exception is thrown.
+   */
+  void add(const DescriptorHandle& handle, const Real& value, bool validityCheck = false);
+
+  /** @copydoc add(const DescriptorHandle&,const Real&,bool) */
+  void add(const DescriptorHandle& handle, const std::vector<Real>& value, bool validityCheck = false);
+
+  /** @copydoc add(const DescriptorHandle&,const Real&,bool) */
+  void add(const DescriptorHandle& handle, const std::string& value, bool validityCheck = false);
+
+  /** @copydoc add(const DescriptorHandle&,const Real&,bool) */
+  void add(const DescriptorHandle& handle, const std::vector<std::string>& value, bool validityCheck = false);
+
+  /** @copydoc add(const DescriptorHandle&,const Real&,bool) */
+  void add(const DescriptorHandle& handle, const StereoSample& value, bool validityCheck = false);
+
+  /**
+   * Registers the descriptor name @e name for adding values of type @e T, and
+   * returns a handle to be used instead of the name in the add() methods.
+   * Repeatedly adding values to a descriptor, for instance one value per frame,
+   * is faster with a handle, as the name is only looked up and validated once.
+   *
+   * Registering a name does not create the descriptor: it is created, and
+   * validated again, when the first value is added. If the descriptor is
+   * removed from the pool, the handle remains valid and adding a value
+   * creates it again.
+   *
+   * Handles are supported for the types that can be added to the pool, except
+   * for TNT::Array2D<Real> and Tensor<Real>.
+   *
+   * @remark An exception is thrown if @e name cannot be used for values of
+   *         type @e T, as add() would do, or if a handle for another type was
+   *         already created for @e name.
+   */
+  template <typename T>
+  DescriptorHandle descriptorHandle(const std::string& name);
+
   /**
    * WARNING: this is an utility method that might fail in weird ways if not used
    * correctly. When in doubt, always use the add() method. This is provided for
@@ -322,8 +561,17 @@ class ESSENTIA_API Pool {
   /**
    * @returns a map where the key is a descriptor name and the values are
    *          of type vector<Real>
+   * @remark the frames are stored as VectorRealFrames, and this method copies
+   *         them into vectors of frames (see getVectorRealFramesPool())
+   */
+  const PoolOf(std::vector<Real>)& getVectorRealPool() const;
+
+  /**
+   * @returns a map where the key is a descriptor name and the values are
+   *          the frames of type vector<Real>, which can be read without copying
+   *          them
    */
-  const PoolOf(std::vector<Real>)& getVectorRealPool() const { return _poolVectorReal; }
+  const std::map<std::string, VectorRealFrames>& getVectorRealFramesPool() const { return _poolVectorReal; }
 
   /**
    * @returns a std::map where the key is a descriptor name and the values are
@@ -411,7 +659,7 @@ class ESSENTIA_API Pool {
 #define SPECIALIZE_VALUE(type, tname)                                          \
 template <>                                                                    \
 inline const type& Pool::value(const std::string& name) const {                \
-  MutexLocker lock(mutex##tname);                                              \
+  ForcedMutexLocker lock(mutex##tname);                                              \
   std::map<std::string,type >::const_iterator result = _pool##tname.find(name);\
   if (result == _pool##tname.end()) {                                          \
     std::ostringstream msg;                                                    \
@@ -425,20 +673,35 @@ inline const type& Pool::value(const std::string& name) const {                \
 SPECIALIZE_VALUE(Real, SingleReal);
 SPECIALIZE_VALUE(std::string, SingleString);
 //SPECIALIZE_VALUE(std::vector<std::string>, String);
-SPECIALIZE_VALUE(std::vector<std::vector<Real> >, VectorReal);
+SPECIALIZE_VALUE(VectorRealFrames, VectorReal);
 SPECIALIZE_VALUE(std::vector<std::vector<std::string> >, VectorString);
 SPECIALIZE_VALUE(std::vector<TNT::Array2D<Real> >, Array2DReal);
 SPECIALIZE_VALUE(std::vector<Tensor<Real> >, TensorReal);
 SPECIALIZE_VALUE(Tensor<Real>, SingleTensorReal);
 SPECIALIZE_VALUE(std::vector<StereoSample>, StereoSample);
 
+// The frames of vectors of Reals are copied to a vector of frames, see
+// Pool::_poolVectorRealCopies
+template<>
+inline const std::vector<std::vector<Real> >& Pool::value(const std::string& name) const {
+  ForcedMutexLocker lock(mutexVectorReal);
+  std::map<std::string, VectorRealFrames>::const_iterator result = _poolVectorReal.find(name);
+  if (result == _poolVectorReal.end()) {
+    std::ostringstream msg;
+    msg << "Descriptor name '" << name << "' of type "
+        << nameOfType(typeid(std::vector<std::vector<Real> >)) << " not found";
+    throw EssentiaException(msg);
+  }
+  return vectorRealCopy(name, result->second);
+}
+
 // This value function is not under the macro above because it needs to check
 // in two separate sub-pools (poolReal and poolSingleVectorReal)
 template<>
 inline const std::vector<Real>& Pool::value(const std::string& name) const {
   std::map<std::string, std::vector<Real> >::const_iterator result;
   {
-    MutexLocker lock(mutexReal);
+    ForcedMutexLocker lock(mutexReal);
     result = _poolReal.find(name);
     if (result != _poolReal.end()) {
       return result->second;
@@ -446,7 +709,7 @@ inline const std::vector<Real>& Pool::value(const std::string& name) const {
   }
 
   {
-    MutexLocker lock(mutexSingleVectorReal);
+    ForcedMutexLocker lock(mutexSingleVectorReal);
     result = _poolSingleVectorReal.find(name);
     if (result != _poolSingleVectorReal.end()) {
       return result->second;
@@ -465,7 +728,7 @@ template<>
 inline const std::vector<std::string>& Pool::value(const std::string& name) const {
   std::map<std::string, std::vector<std::string> >::const_iterator result;
   {
-    MutexLocker lock(mutexString);
+    ForcedMutexLocker lock(mutexString);
     result = _poolString.find(name);
     if (result != _poolString.end()) {
       return result->second;
@@ -473,7 +736,7 @@ inline const std::vector<std::string>& Pool::value(const std::string& name) cons
   }
 
   {
-    MutexLocker lock(mutexSingleVectorString);
+    ForcedMutexLocker lock(mutexSingleVectorString);
     result = _poolSingleVectorString.find(name);
     if (result != _poolSingleVectorString.end()) {
       return result->second;
@@ -490,7 +753,7 @@ inline const std::vector<std::string>& Pool::value(const std::string& name) cons
 #define SPECIALIZE_CONTAINS(type, tname)                                       \
 template <>                                                                    \
 inline bool Pool::contains<type>(const std::string& name) const {              \
-  MutexLocker lock(mutex##tname);                                              \
+  ForcedMutexLocker lock(mutex##tname);                                              \
   std::map<std::string,type >::const_iterator result = _pool##tname.find(name);\
   if (result == _pool##tname.end()) {                                          \
     return false;                                                              \
@@ -501,20 +764,25 @@ inline bool Pool::contains<type>(const std::string& name) const {              \
 SPECIALIZE_CONTAINS(Real, SingleReal);
 SPECIALIZE_CONTAINS(std::string, SingleString);
 //SPECIALIZE_CONTAINS(std::vector<std::string>, String);
-SPECIALIZE_CONTAINS(std::vector<std::vector<Real> >, VectorReal);
+SPECIALIZE_CONTAINS(VectorRealFrames, VectorReal);
 SPECIALIZE_CONTAINS(std::vector<std::vector<std::string> >, VectorString);
 SPECIALIZE_CONTAINS(std::vector<TNT::Array2D<Real> >, Array2DReal);
 SPECIALIZE_CONTAINS(std::vector<Tensor<Real> >, TensorReal);
 SPECIALIZE_CONTAINS(Tensor<Real> , SingleTensorReal);
 SPECIALIZE_CONTAINS(std::vector<StereoSample>, StereoSample);
 
+template<>
+inline bool Pool::contains<std::vector<std::vector<Real> > >(const std::string& name) const {
+  return contains<VectorRealFrames>(name);
+}
+
 // This value function is not under the macro above because it needs to check
 // in two separate sub-pools (poolReal and poolSingleVectorReal)
 template<>
 inline bool Pool::contains<std::vector<Real> >(const std::string& name) const {
   std::map<std::string, std::vector<Real> >::const_iterator result;
   {
-    MutexLocker lock(mutexReal);
+    ForcedMutexLocker lock(mutexReal);
     result = _poolReal.find(name);
     if (result != _poolReal.end()) {
       return true;
@@ -522,7 +790,7 @@ inline bool Pool::contains<std::vector<Real> >(const std::string& name) const {
   }
 
   {
-    MutexLocker lock(mutexSingleVectorReal);
+    ForcedMutexLocker lock(mutexSingleVectorReal);
     result = _poolSingleVectorReal.find(name);
     if (result != _poolSingleVectorReal.end()) {
       return true;
@@ -539,7 +807,7 @@ template<>
 inline bool Pool::contains<std::vector<std::string> >(const std::string& name) const {
   std::map<std::string, std::vector<std::string> >::const_iterator result;
   {
-    MutexLocker lock(mutexString);
+    ForcedMutexLocker lock(mutexString);
     result = _poolString.find(name);
     if (result != _poolString.end()) {
       return true;
@@ -547,7 +815,7 @@ inline bool Pool::contains<std::vector<std::string> >(const std::string& name) c
   }
 
   {
-    MutexLocker lock(mutexSingleVectorString);
+    ForcedMutexLocker lock(mutexSingleVectorString);
     result = _poolSingleVectorString.find(name);
     if (result != _poolSingleVectorString.end()) {
       return true;
@@ -559,19 +827,21 @@ inline bool Pool::contains<std::vector<std::string> >(const std::string& name) c
 
 // Used to get a lock over all sub-pools, make sure to update this when adding
 // a new sub-pool
-#define GLOBAL_LOCK                                         \
-MutexLocker lockReal(mutexReal);                            \
-MutexLocker lockVectorReal(mutexVectorReal);                \
-MutexLocker lockString(mutexString);                        \
-MutexLocker lockVectorString(mutexVectorString);            \
-MutexLocker lockArray2DReal(mutexArray2DReal);              \
-MutexLocker lockTensorReal(mutexTensorReal);              \
-MutexLocker lockStereoSample(mutexStereoSample);            \
-MutexLocker lockSingleReal(mutexSingleReal);                \
-MutexLocker lockSingleString(mutexSingleString);            \
-MutexLocker lockSingleVectorReal(mutexSingleVectorReal);    \
-MutexLocker lockSingleVectorString(mutexSingleVectorString);\
-MutexLocker lockSingleTensorReal(mutexSingleTensorReal);
+#define GLOBAL_LOCK_OF(pool)                                                  \
+ForcedMutexLocker lockReal((pool).mutexReal);                                 \
+ForcedMutexLocker lockVectorReal((pool).mutexVectorReal);                     \
+ForcedMutexLocker lockString((pool).mutexString);                             \
+ForcedMutexLocker lockVectorString((pool).mutexVectorString);                 \
+ForcedMutexLocker lockArray2DReal((pool).mutexArray2DReal);                   \
+ForcedMutexLocker lockTensorReal((pool).mutexTensorReal);                     \
+ForcedMutexLocker lockStereoSample((pool).mutexStereoSample);                 \
+ForcedMutexLocker lockSingleReal((pool).mutexSingleReal);                     \
+ForcedMutexLocker lockSingleString((pool).mutexSingleString);                 \
+ForcedMutexLocker lockSingleVectorReal((pool).mutexSingleVectorReal);         \
+ForcedMutexLocker lockSingleVectorString((pool).mutexSingleVectorString);     \
+ForcedMutexLocker lockSingleTensorReal((pool).mutexSingleTensorReal);
+
+#define GLOBAL_LOCK GLOBAL_LOCK_OF(*this)
 
 
 
@@ -584,7 +854,7 @@ inline void Pool::append(const std::string& name, const std::vector<T>& values)
 template <>                                                                           \
 inline void Pool::append(const std::string& name, const std::vector<type>& values) {  \
   {                                                                                   \
-    MutexLocker lock(mutex##tname);                                                   \
+    ForcedMutexLocker lock(mutex##tname);                                                   \
     PoolOf(type)::iterator result = _pool##tname.find(name);                          \
     if (result != _pool##tname.end()) {                                               \
                                                                                       \
@@ -597,17 +867,63 @@ inline void Pool::append(const std::string& name, const std::vector<type>& value
   }                                                                                   \
                                                                                       \
   GLOBAL_LOCK                                                                         \
-  validateKey(name);                                                                  \
-  _pool##tname[name] = values;                                                        \
+  /* another thread may have added it in the meantime */                              \
+  if (_pool##tname.find(name) == _pool##tname.end()) validateKey(name);               \
+  std::vector<type>& v = _pool##tname[name];                                          \
+  v.insert(v.end(), values.begin(), values.end());                                    \
 }
 
 
 SPECIALIZE_APPEND(Real, Real);
-SPECIALIZE_APPEND(std::vector<Real>, VectorReal);
 SPECIALIZE_APPEND(std::string, String);
 SPECIALIZE_APPEND(std::vector<std::string>, VectorString);
 SPECIALIZE_APPEND(StereoSample, StereoSample);
 
+template <>
+inline void Pool::append(const std::string& name, const std::vector<std::vector<Real> >& values) {
+  {
+    ForcedMutexLocker lock(mutexVectorReal);
+    std::map<std::string, VectorRealFrames>::iterator result = _poolVectorReal.find(name);
+    if (result != _poolVectorReal.end()) {
+      VectorRealFrames& v = result->second;
+      v.reserve(v.size() + values.size());
+      for (int i=0; i<(int)values.size(); ++i) v.push_back(values[i]);
+      return;
+    }
+  }
+
+  GLOBAL_LOCK
+  // another thread may have added it in the meantime
+  if (_poolVectorReal.find(name) == _poolVectorReal.end()) validateKey(name);
+  VectorRealFrames& v = _poolVectorReal[name];
+  v.reserve(v.size() + values.size());
+  for (int i=0; i<(int)values.size(); ++i) v.push_back(values[i]);
+}
+
+
+template<typename T>
+inline DescriptorHandle Pool::descriptorHandle(const std::string& name) {
+  throw EssentiaException("Pool::descriptorHandle not implemented for type: ", nameOfType(typeid(T)));
+}
+
+#define SPECIALIZE_DESCRIPTOR_HANDLE(type, storage, tname)                            \
+template <>                                                                           \
+inline DescriptorHandle Pool::descriptorHandle<type>(const std::string& name) {      \
+  GLOBAL_LOCK                                                                         \
+  std::map<std::string, storage >::iterator result = _pool##tname.find(name);         \
+  if (result == _pool##tname.end()) {                                                 \
+    checkKey(name);                                                                   \
+    return newHandle(name, &_pool##tname, 0);                                         \
+  }                                                                                   \
+  return newHandle(name, &_pool##tname, &result->second);                             \
+}
+
+SPECIALIZE_DESCRIPTOR_HANDLE(Real, std::vector<Real>, Real);
+SPECIALIZE_DESCRIPTOR_HANDLE(std::vector<Real>, VectorRealFrames, VectorReal);
+SPECIALIZE_DESCRIPTOR_HANDLE(std::string, std::vector<std::string>, String);
+SPECIALIZE_DESCRIPTOR_HANDLE(std::vector<std::string>, std::vector<std::vector<std::string> >, VectorString);
+SPECIALIZE_DESCRIPTOR_HANDLE(StereoSample, std::vector<StereoSample>, StereoSample);
+
 /// @endcond
 
 } // namespace essentia
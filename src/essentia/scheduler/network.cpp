@@ -18,10 +18,14 @@
  */
 
 #include <stack>
+#include <algorithm>
+#include <functional>
 #include "network.h"
 #include "graphutils.h"
 #include "../streaming/streamingalgorithm.h"
 #include "../streaming/streamingalgorithmcomposite.h"
+#include "../utils/atomic.h"
+#include "../utils/threadpool.h"
 using namespace std;
 using namespace essentia;
 using namespace essentia::streaming;
@@ -166,11 +170,22 @@ vector<NetworkNode*> NetworkNode::addVisibleDependencies(map<Algorithm*, Network
 
 Network* Network::lastCreated = 0;
 
+// networks can be created and deleted in different threads at the same time
+static ForcedMutex& lastCreatedMutex() {
+  static ForcedMutex mutex;
+  return mutex;
+}
+
 Network::Network(Algorithm* generator, bool takeOwnership) : _takeOwnership(takeOwnership),
                                                              _generator(generator),
                                                              _visibleNetworkRoot(0),
-                                                             _executionNetworkRoot(0) {
-  lastCreated = this;
+                                                             _executionNetworkRoot(0),
+                                                             _nThreads(1),
+                                                             _threadPool(0) {
+  {
+    ForcedMutexLocker lock(lastCreatedMutex());
+    lastCreated = this;
+  }
 
   // 1- find the simple list of algorithms connected in this network
   buildVisibleNetwork();
@@ -182,8 +197,24 @@ Network::Network(Algorithm* generator, bool takeOwnership) : _takeOwnership(take
 }
 
 Network::~Network() {
-  if (lastCreated == this) lastCreated = 0;
+  {
+    ForcedMutexLocker lock(lastCreatedMutex());
+    if (lastCreated == this) lastCreated = 0;
+  }
   clear();
+  delete _threadPool;
+}
+
+void Network::setNumberThreads(int nThreads) {
+  if (nThreads <= 0) nThreads = (int)std::thread::hardware_concurrency();
+  if (nThreads <= 0) nThreads = 1;
+  if (nThreads == _nThreads) return;
+
+  delete _threadPool;
+  _threadPool = 0;
+  _nThreads = nThreads;
+
+  if (_nThreads > 1) _threadPool = new ThreadPool(_nThreads);
 }
 
 void Network::clear() {
@@ -255,6 +286,11 @@ void Network::runPrepare() {
   // 4- resize the buffers depending on the requirements of the connected sinks
   checkBufferSizes();
 
+  // 5- find out which algorithms can be run concurrently. This is done even
+  //    when running on a single thread, as setNumberThreads() may still be
+  //    called before runStep()
+  buildParallelSchedule();
+
 #if DEBUGGING_ENABLED
   for (int i=0; i<(int)_toposortedNetwork.size(); i++) _toposortedNetwork[i]->nProcess = 0;
 #endif
@@ -273,12 +309,12 @@ bool Network::runStep() {
 #if DEBUGGING_ENABLED
   string dash(24, '-');
 
-  restoreDebugLevels();
+  // starts from the saved levels, which it changes in a single step
   setDebugLevelForTimeIndex(gen->nProcess);
   E_DEBUG(ENetwork, "-------- Running generator loop index " << gen->nProcess << " --------");
 
   E_DEBUG(EScheduler, dash << " Buffer states before running generator, nProcess = " << gen->nProcess << " " << dash);
-  printNetworkBufferFillState();
+  printBufferFillState();
 #endif
 
   // first run the generator once
@@ -299,7 +335,17 @@ bool Network::runStep() {
 
   // then run each algorithm as many times as needed for them to consume everything on their input
   stack<int> runStack;
-  runStack.push(1);
+
+  if (_nThreads > 1 && !endOfStream) {
+    // run all the algorithms once on the thread pool, and only the ones that
+    // need to be rescheduled sequentially afterwards
+    vector<int> rescheduled = runParallelStep();
+    for (int i=0; i<(int)rescheduled.size(); i++) runStack.push(rescheduled[i]);
+  }
+  else {
+    runStack.push(1);
+  }
+
   while (!runStack.empty()) {
     int startIndex = runStack.top();
     runStack.pop();
@@ -333,7 +379,7 @@ bool Network::runStep() {
           E_WARNING("You may want to consider resizing one of the output buffers of " <<
                     "this algorithm for better performance");
           */
-          printNetworkBufferFillState();
+          printBufferFillState();
         }
       } while (status == OK);
 
@@ -344,6 +390,87 @@ bool Network::runStep() {
   return true;
 }
 
+void Network::buildParallelSchedule() {
+  int n = (int)_toposortedNetwork.size();
+  map<Algorithm*, int> index;
+  for (int i=0; i<n; i++) index[_toposortedNetwork[i]] = i;
+
+  _parallelChildren.assign(n, vector<int>());
+  _parallelParents.assign(n, 0);
+
+  NodeVector nodes = depthFirstSearch(_executionNetworkRoot);
+  for (int i=0; i<(int)nodes.size(); i++) {
+    int parent = index[nodes[i]->algorithm()];
+    // the generator is run before all the others, no need to wait for it
+    if (parent == 0) continue;
+
+    const NodeVector& children = nodes[i]->children();
+    for (int j=0; j<(int)children.size(); j++) {
+      int child = index[children[j]->algorithm()];
+      _parallelChildren[parent].push_back(child);
+      _parallelParents[child]++;
+    }
+  }
+}
+
+vector<int> Network::runParallelStep() {
+  int n = (int)_toposortedNetwork.size();
+
+  // number of parents that still need to be run for each algorithm
+  vector<Atomic> waitingFor(n);
+  for (int i=0; i<n; i++) waitingFor[i] = _parallelParents[i];
+
+  vector<int> rescheduled;
+  ForcedMutex rescheduledMutex;
+
+  // the task for algorithm i runs it until it can't consume any more tokens,
+  // then schedules those of its children which have no parents left to wait for
+  std::function<void(int)> runAlgorithm = [&](int i) {
+    Algorithm* algo = _toposortedNetwork[i];
+    algo->shouldStop(false);
+
+    AlgorithmStatus status;
+    {
+      // algorithms without outputs usually write to shared storage (eg: a Pool)
+      std::unique_lock<ForcedMutex> lock(_sinkMutex, std::defer_lock);
+      if (algo->outputs().empty()) lock.lock();
+
+      do {
+        status = algo->process();
+#if DEBUGGING_ENABLED
+        if (status == OK || status == FINISHED) algo->nProcess++;
+#endif
+      } while (status == OK);
+    }
+
+    if (status == NO_OUTPUT) {
+      ForcedMutexLocker lock(rescheduledMutex);
+      rescheduled.push_back(i);
+    }
+
+    const vector<int>& children = _parallelChildren[i];
+    for (int j=0; j<(int)children.size(); j++) {
+      int child = children[j];
+      if (waitingFor[child].fetch_add(-1) == 1) {
+        _threadPool->submit([&runAlgorithm, child]() { runAlgorithm(child); });
+      }
+    }
+  };
+
+  for (int i=1; i<n; i++) {
+    if (_parallelParents[i] == 0) {
+      _threadPool->submit([&runAlgorithm, i]() { runAlgorithm(i); });
+    }
+  }
+
+  _threadPool->wait();
+
+  // keep the same order as the sequential scheduler would have pushed them
+  sort(rescheduled.begin(), rescheduled.end());
+  return rescheduled;
+}
+
+
 Algorithm* Network::findAlgorithm(const std::string& name) {
   NodeVector nodes = depthFirstSearch(_visibleNetworkRoot);
   for (NodeVector::iterator node = nodes.begin(); node != nodes.end(); ++node) {
@@ -967,8 +1094,12 @@ void Network::printBufferFillState() {
 }
 
 void printNetworkBufferFillState() {
+  // the network can't be deleted while printing it, as its destructor needs
+  // the lock
+  ForcedMutexLocker lock(lastCreatedMutex());
   if (!Network::lastCreated) {
     E_WARNING("No network created, or last created network has been deleted...");
+    return;
   }
 
   Network::lastCreated->printBufferFillState();
@@ -25,8 +25,12 @@
 #include <stack>
 #include "../streaming/streamingalgorithm.h"
 #include "../essentiautil.h"
+#include "../threading.h"
 
 namespace essentia {
+
+class ThreadPool;
+
 namespace streaming {
 
 class AlgorithmComposite;
@@ -131,6 +135,25 @@ class ESSENTIA_API Network {
    */
   bool runStep();
 
+  /**
+   * Sets the number of threads used to run the network.
+   *
+   * With 1 thread (the default), the algorithms are run sequentially in their
+   * topological order. With more threads, each step of the network runs the
+   * algorithms on a work-stealing thread pool as soon as all of their parents
+   * in the execution network have been run, so that independent branches
+   * (eg: spectral, tonal and rhythm descriptors hanging off the same
+   * FrameCutter) are computed concurrently. Algorithms without any output
+   * (PoolStorage, FileOutput, ...) are never run concurrently with each other,
+   * as they usually write to shared storage, and the last step (when the end
+   * of the stream is propagated) is always run sequentially.
+   * If @c nThreads <= 0, the number of hardware threads is used. It can be
+   * called at any time, including between runPrepare() and runStep().
+   */
+  void setNumberThreads(int nThreads);
+
+  int numberThreads() const { return _nThreads; }
+
   /**
    * Rebuilds the visible and execution network.
    */
@@ -198,7 +221,8 @@ class ESSENTIA_API Network {
 
   /**
    * Last instance of Network created, 0 if it has been deleted or if
-   * no network has been created yet.
+   * no network has been created yet. When networks are created in several
+   * threads, it is only safe to use through printNetworkBufferFillState().
    */
   static Network* lastCreated;
 
@@ -209,6 +233,23 @@ class ESSENTIA_API Network {
   NetworkNode* _executionNetworkRoot;
   std::vector<streaming::Algorithm*> _toposortedNetwork;
 
+  int _nThreads;
+  ThreadPool* _threadPool;
+
+  /**
+   * For the parallel scheduler: for each algorithm in @c _toposortedNetwork,
+   * the indices of its children and the number of its parents (not counting
+   * the generator, which is always run first).
+   */
+  std::vector<std::vector<int> > _parallelChildren;
+  std::vector<int> _parallelParents;
+
+  /**
+   * Serializes the execution of the algorithms which have no outputs when
+   * running the network in parallel.
+   */
+  ForcedMutex _sinkMutex;
+
   /**
    * Build the network of visibly connected algorithms (ie: do not enter composite
    * algorithms) and stores its root in @c _visibleNetworkRoot.
@@ -228,6 +269,20 @@ class ESSENTIA_API Network {
    */
   void topologicalSortExecutionNetwork();
 
+  /**
+   * Compute the dependencies between the algorithms of the topologically
+   * sorted network, used by the parallel scheduler.
+   */
+  void buildParallelSchedule();
+
+  /**
+   * Run once all the algorithms of the network (except the generator) on the
+   * thread pool, respecting their dependencies. Returns the indices of the
+   * algorithms that need to be rescheduled because their output buffers were
+   * full.
+   */
+  std::vector<int> runParallelStep();
+
   /**
    * Execution dependencies are stored inside the network nodes themselves, and
    * might enter/exit CompositeAlgorithms boundaries.
@@ -30,6 +30,7 @@ class PoolStorageBase : public Algorithm {
  protected:
   Pool* _pool;
   std::string _descriptorName;
+  DescriptorHandle _descriptorHandle;
   bool _setSingle;
 
  public:
@@ -93,24 +94,34 @@ class PoolStorage : public PoolStorageBase {
     return OK;
   }
 
+  // tokens are added one by one through a handle, so that the descriptor name
+  // is only looked up and validated once
+  template <typename T>
+  void addWithHandle(const T& value) {
+    if (!_descriptorHandle.isValid()) {
+      _descriptorHandle = _pool->descriptorHandle<T>(_descriptorName);
+    }
+    _pool->add(_descriptorHandle, value);
+  }
+
   template <typename T>
   void addToPool(const std::vector<T>& value) {
     if (_setSingle) {
       for (int i=0; i<(int)value.size();++i)
       _pool->add(_descriptorName, value[i]);
     }
-    else _pool->add(_descriptorName, value);
+    else addWithHandle(value);
   }
 
   void addToPool(const std::vector<Real>& value) {
     if (_setSingle) _pool->set(_descriptorName, value);
-    else            _pool->add(_descriptorName, value);
+    else            addWithHandle(value);
   }
 
   template <typename T>
   void addToPool(const T& value) {
     if (_setSingle) _pool->set(_descriptorName, value);
-    else            _pool->add(_descriptorName, value);
+    else            addWithHandle(value);
    }
 
   template <typename T>
@@ -136,7 +147,7 @@ class PoolStorage : public PoolStorageBase {
                               " is not supported by Pool.");
     }
     else {
-      _pool->add(_descriptorName, value);
+      addWithHandle(value);
     }
   }
 
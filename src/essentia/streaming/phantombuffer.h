@@ -21,9 +21,9 @@
 #define ESSENTIA_PHANTOMBUFFER_H
 
 #include <vector>
+#include <atomic>
 #include "multiratebuffer.h"
 #include "../roguevector.h"
-#include "../threading.h"
 #include "../essentiautil.h"
 
 
@@ -44,6 +44,28 @@ class Window {
 };
 
 
+/**
+ * Total number of tokens written or read through a Window, as published to
+ * the other threads accessing the buffer. A store is a release operation and
+ * a load an acquire one, so that the tokens counted in a total are visible to
+ * (or not in use anymore by) whoever loads it.
+ * It is copyable so that it can be stored in a std::vector, but copies are
+ * only meant to happen while configuring the buffer.
+ */
+class PublishedTotal {
+ public:
+  PublishedTotal(int total = 0) : _total(total) {}
+  PublishedTotal(const PublishedTotal& other) : _total(other.load()) {}
+  PublishedTotal& operator=(const PublishedTotal& other) { store(other.load()); return *this; }
+
+  inline int load() const { return _total.load(std::memory_order_acquire); }
+  inline void store(int total) { _total.store(total, std::memory_order_release); }
+
+ protected:
+  std::atomic<int> _total;
+};
+
+
 /**
  * The PhantomBuffer class is an implementation of the MultiRateBuffer interface
  * that has a special zone at its end, called the phantom zone, which is also
@@ -51,7 +73,14 @@ class Window {
  * that retrieving any number of samples lower than the phantom size can be done
  * on a contiguous zone in memory.
  *
- * @todo class should be thread-safe, but make sure it really is
+ * The buffer is lock-free for a single writer and multiple readers living on
+ * different threads: the write window is only ever touched by the writer and
+ * each read window only by its reader. They communicate exclusively through
+ * the published totals of tokens written and read, so a reader only sees
+ * tokens which have been completely written, and the writer never overwrites
+ * tokens which haven't been released by all the readers.
+ * Adding/removing readers, resizing and resetting the buffer are not
+ * thread-safe and should only be done while it is not being used.
  *
  * NB: we can only guarantee that availableFor* returns a least the size of the phantom buffer, not more
  *     we have to choose the size of the phantom zone carefully, or make it dynamically resizable
@@ -107,6 +136,7 @@ class PhantomBuffer : public MultiRateBuffer<T> {
     _bufferSize = info.size;
     _phantomSize = info.maxContiguousElements;
     _buffer.resize(_bufferSize + _phantomSize);
+    publishTotals();
   }
 
   PhantomBuffer(SourceBase* parent, int size, int phantomSize) :
@@ -140,7 +170,7 @@ class PhantomBuffer : public MultiRateBuffer<T> {
   void releaseForWrite(int released);
   void releaseForRead(ReaderID id, int released);
 
-  // @todo mutex-lock these functions or not??
+  // NB: these are not thread-safe, see the class documentation
   /**
    * Add a new reader and return its ID. The reader will start at the point
    * where the write window is currently located.
@@ -163,26 +193,25 @@ class PhantomBuffer : public MultiRateBuffer<T> {
     _buffer.resize(size+phantomSize);
     _bufferSize = size;
     _phantomSize = phantomSize;
+    publishTotals();
   }
 
   int totalTokensWritten() const {
-    MutexLocker lock(mutex); NOWARN_UNUSED(lock);
-    return _writeWindow.total(_bufferSize);
+    return _writeTotal.load();
   }
 
   int totalTokensRead(ReaderID id) const {
-    MutexLocker lock(mutex); NOWARN_UNUSED(lock);
-    return _readWindow[id].total(_bufferSize);
+    return _readTotal[id].load();
   }
 
   const T& lastTokenProduced() const {
-    MutexLocker lock(mutex); NOWARN_UNUSED(lock);
-    if (_writeWindow.total(_bufferSize) == 0) {
+    int total = _writeTotal.load();
+    if (total == 0) {
       throw EssentiaException("Tried to call ::lastTokenProduced() on ", _parent->fullName(),
                               " which hasn't produced any token yet");
     }
 
-    int idx = _writeWindow.begin;
+    int idx = total % _bufferSize;
     if (idx == 0) return _buffer[_bufferSize-1];
     return _buffer[idx-1];
   }
@@ -199,12 +228,13 @@ class PhantomBuffer : public MultiRateBuffer<T> {
   Window _writeWindow;
   std::vector<Window> _readWindow;
 
+  // totals of the windows above, as seen by the other threads
+  PublishedTotal _writeTotal;
+  std::vector<PublishedTotal> _readTotal;
+
   RogueVector<T> _writeView;
   std::vector<RogueVector<T> > _readView; // @todo CAREFUL WHEN COPYING ROGUEVECTOR...
 
-  // threading-related & locking structures
-  mutable Mutex mutex; // should be locked before any modification to the object
-
  protected:
   // this function is only here to make sure we do not overflow the window.turn variable
   // @todo we could make the class smarter by not counting the turns, but just knowing if
@@ -215,7 +245,9 @@ class PhantomBuffer : public MultiRateBuffer<T> {
   void updateReadView(ReaderID id);
   void updateWriteView();
 
-  // mutex should be locked before entering this function
+  // copy the totals of the windows to their published version
+  void publishTotals();
+
   // make sure it doesn't overflow
   int availableForRead(ReaderID id) const;
   int availableForWrite(bool contiguous=true) const;
@@ -39,6 +39,7 @@ ReaderID PhantomBuffer<T>::addReader(bool startFromZero) {
     w.end = w.begin = _writeWindow.begin;
   }
   _readWindow.push_back(w);
+  _readTotal.push_back(PublishedTotal(w.total(_bufferSize)));
 
   ReaderID id = _readWindow.size() - 1; // index of last one
 
@@ -52,6 +53,7 @@ template <typename T>
 void PhantomBuffer<T>::removeReader(ReaderID id) {
   _readView.erase(_readView.begin() + id);
   _readWindow.erase(_readWindow.begin() + id);
+  _readTotal.erase(_readTotal.begin() + id);
 }
 
 
@@ -82,7 +84,6 @@ bool PhantomBuffer<T>::acquireForRead(ReaderID id, int requested) {
     throw EssentiaException(msg);
   }
 
-  MutexLocker lock(mutex); NOWARN_UNUSED(lock);
   if (availableForRead(id) < requested) return false;
 
   _readWindow[id].end = _readWindow[id].begin + requested;
@@ -110,7 +111,6 @@ bool PhantomBuffer<T>::acquireForWrite(int requested) {
     throw EssentiaException(msg);
   }
 
-  MutexLocker lock(mutex); NOWARN_UNUSED(lock);
   if (availableForWrite() < requested) return false;
 
   _writeWindow.end = _writeWindow.begin + requested;
@@ -121,8 +121,6 @@ bool PhantomBuffer<T>::acquireForWrite(int requested) {
 
 template <typename T>
 void PhantomBuffer<T>::releaseForWrite(int released) {
-  MutexLocker lock(mutex); NOWARN_UNUSED(lock);
-
   // error checking:
   if (released > _writeWindow.end - _writeWindow.begin) {
     std::ostringstream msg;
@@ -151,12 +149,15 @@ void PhantomBuffer<T>::releaseForWrite(int released) {
   relocateWriteWindow();
   updateWriteView();
 
+  // only now that the tokens (and their phantom copy) have been written can
+  // the readers see them
+  _writeTotal.store(_writeWindow.total(_bufferSize));
+
   //DEBUG_NL(" - total written tokens: " << _writeWindow.total(_bufferSize));
 }
 
 template <typename T>
 void PhantomBuffer<T>::releaseForRead(ReaderID id, int released) {
-  MutexLocker lock(mutex); NOWARN_UNUSED(lock);
   Window& w = _readWindow[id];
 
   // error checking:
@@ -171,6 +172,9 @@ void PhantomBuffer<T>::releaseForRead(ReaderID id, int released) {
   relocateReadWindow(id);
   updateReadView(id);
 
+  // let the writer know it can now overwrite these tokens
+  _readTotal[id].store(w.total(_bufferSize));
+
   //DEBUG_NL(" - total read tokens: " << w.total(_bufferSize));
 }
 
@@ -210,7 +214,15 @@ inline void PhantomBuffer<T>::updateWriteView() {
 }
 
 
-// mutex should be locked before entering this function
+template <typename T>
+inline void PhantomBuffer<T>::publishTotals() {
+  _writeTotal.store(_writeWindow.total(_bufferSize));
+  for (uint i=0; i<_readWindow.size(); i++) {
+    _readTotal[i].store(_readWindow[i].total(_bufferSize));
+  }
+}
+
+
 // make sure it doesn't overflow
 /**
  * This method computes the maximum number of contiguous tokens that can be
@@ -223,7 +235,8 @@ template <typename T>
 int PhantomBuffer<T>::availableForRead(ReaderID id) const {
   //relocateReadWindow(id); // this call should be useless, but it's a safety guard to have it
 
-  int theoretical = _writeWindow.total(_bufferSize) - _readWindow[id].total(_bufferSize);
+  // the writer might be on another thread, only rely on what it has published
+  int theoretical = _writeTotal.load() - _readWindow[id].total(_bufferSize);
   int contiguous = _bufferSize + _phantomSize - _readWindow[id].begin;
 
   /*
@@ -247,17 +260,17 @@ int PhantomBuffer<T>::availableForWrite(bool contiguous) const {
   //relocateWriteWindow(); // this call should be useless, but it's a safety guard to have it
 
   int minTotal = _bufferSize;
-  if (!_readWindow.empty()) { // someone is connected, take its value instead of bufferSize
-    minTotal = _readWindow.begin()->total(_bufferSize);
+  if (!_readTotal.empty()) { // someone is connected, take its value instead of bufferSize
+    minTotal = _readTotal.begin()->load();
   }
 
   //DEBUG_PLAIN(_writeWindow.total(_bufferSize) << " read:");
 
-  // for each read window, find the one that is the latest, as it is the one
-  // that the write window should not overtake.
-  for (uint i=0; i<_readWindow.size(); i++) {
-    const Window& w = _readWindow[i];
-    minTotal = (std::min)(minTotal, w.total(_bufferSize));
+  // for each reader, find the one that is the latest, as it is the one that
+  // the write window should not overtake. The readers might be on other
+  // threads, so only rely on what they have published.
+  for (uint i=0; i<_readTotal.size(); i++) {
+    minTotal = (std::min)(minTotal, _readTotal[i].load());
   }
 
   int theoretical = minTotal - _writeWindow.total(_bufferSize) + _bufferSize;
@@ -302,6 +315,7 @@ void PhantomBuffer<T>::reset() {
   for (int i=0; i<(int)_readWindow.size(); i++) {
     _readWindow[i] = Window();
   }
+  publishTotals();
 }
 
 } // namespace streaming
@@ -214,7 +214,7 @@ class SinkProxy : public SinkProxyBase {
 
   void disconnect(SourceBase& source) {
     _source = 0;
-    _proxiedSink->setSource(0);
+    if (_proxiedSink) _proxiedSink->setSource(0);
   }
 
   virtual const void* getTokens() const {
@@ -38,6 +38,13 @@ class Atomic {
       _a += i;
   }
 
+  // returns the value held before the addition, as std::atomic does
+  inline int fetch_add(const int& i) {
+    int old = _a;
+    _a += i;
+    return old;
+  }
+
   inline void operator-=(const int &i) { add(-i); }
   inline void operator+=(const int &i) { add(i); }
 
@@ -90,6 +97,10 @@ class Atomic {
   inline void operator--() {
     InterlockedDecrement(&i_);
   }
+
+  inline int fetch_add(const int &i) {
+    return InterlockedExchangeAdd(&i_, i);
+  }
 };
 
 } // namespace essentia
@@ -124,6 +135,10 @@ class Atomic {
   inline void operator--() {
     OSAtomicDecrement32Barrier(&i_);
   }
+
+  inline int fetch_add(const int &i) {
+    return OSAtomicAdd32Barrier(i, &i_) - i;
+  }
 };
 
 } // namespace essentia
@@ -152,6 +167,14 @@ class Atomic {
 #endif
   }
 
+  inline int fetch_add(const int& i) {
+#if GCC_VERSION >= 40000
+    return __gnu_cxx::__exchange_and_add(&_a, i);
+#else
+    return __exchange_and_add(&_a, i);
+#endif
+  }
+
   inline void operator-=(const int &i) { add(-i); }
   inline void operator+=(const int &i) { add(i); }
 
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "audioinputsource.h"
+using namespace std;
+
+namespace essentia {
+
+int MemoryAudioInputSource::read(uint8_t* buffer, int size) {
+  int64_t n = min((int64_t)size, _size - _position);
+  if (n <= 0) return 0;
+
+  memcpy(buffer, _data + _position, n);
+  _position += n;
+  return (int)n;
+}
+
+int64_t MemoryAudioInputSource::seek(int64_t offset, int whence) {
+  int64_t position;
+  switch (whence) {
+    case SEEK_SET: position = offset; break;
+    case SEEK_CUR: position = _position + offset; break;
+    case SEEK_END: position = _size + offset; break;
+    default: return -1;
+  }
+  if (position < 0 || position > _size) return -1;
+
+  _position = position;
+  return _position;
+}
+
+} // namespace essentia
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_AUDIOINPUTSOURCE_H
+#define ESSENTIA_AUDIOINPUTSOURCE_H
+
+#include <memory>
+#include <cstddef>
+#include <cstdio>
+#include <stdint.h>
+#include "config.h"
+
+namespace essentia {
+
+/**
+ * A source of encoded audio data (the contents of an audio file), which audio
+ * loaders can decode instead of opening a file. This allows decoding audio
+ * that lives in memory or comes from a network stream without writing it to
+ * a temporary file first.
+ */
+class ESSENTIA_API AudioInputSource {
+ public:
+  virtual ~AudioInputSource() {}
+
+  /**
+   * Reads up to @c size bytes into @c buffer. Returns the number of bytes
+   * read, 0 at the end of the data, or a negative value on error.
+   */
+  virtual int read(uint8_t* buffer, int size) = 0;
+
+  /**
+   * Moves the read position as fseek() does, with @c whence being one of
+   * SEEK_SET, SEEK_CUR or SEEK_END. Returns the new position, or a negative
+   * value if the source cannot seek.
+   */
+  virtual int64_t seek(int64_t offset, int whence) = 0;
+
+  /**
+   * Returns the total size of the data in bytes, or a negative value if it is
+   * not known.
+   */
+  virtual int64_t size() = 0;
+};
+
+
+/**
+ * An AudioInputSource reading from a memory buffer. The buffer is not copied,
+ * so it must stay valid as long as the source is in use.
+ */
+class ESSENTIA_API MemoryAudioInputSource : public AudioInputSource {
+ protected:
+  const uint8_t* _data;
+  int64_t _size;
+  int64_t _position;
+
+ public:
+  MemoryAudioInputSource(const void* data, size_t size)
+    : _data((const uint8_t*)data), _size((int64_t)size), _position(0) {}
+
+  int read(uint8_t* buffer, int size);
+  int64_t seek(int64_t offset, int whence);
+  int64_t size() { return _size; }
+};
+
+
+/**
+ * Interface of the algorithms which can decode their audio from an
+ * AudioInputSource instead of a file.
+ */
+class ESSENTIA_API AudioInputSourceReader {
+ public:
+  virtual ~AudioInputSourceReader() {}
+
+  /**
+   * Decodes the audio from @c source instead of the file given by the
+   * "filename" parameter, until another source is set. Passing a null pointer
+   * goes back to reading the file.
+   */
+  virtual void setInputSource(const std::shared_ptr<AudioInputSource>& source) = 0;
+
+  /**
+   * Decodes the audio from the @c size bytes at @c data, which are not
+   * copied and must stay valid as long as they are used.
+   */
+  void setInputBuffer(const void* data, size_t size) {
+    setInputSource(std::make_shared<MemoryAudioInputSource>(data, size));
+  }
+};
+
+} // namespace essentia
+
+#endif // ESSENTIA_AUDIOINPUTSOURCE_H
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <memory>
+#include "framebatch.h"
+#include "algorithmfactory.h"
+#include "threadpool.h"
+using namespace std;
+
+namespace essentia {
+namespace standard {
+
+typedef vector<vector<Real> > FrameMatrix;
+
+
+// unbinds all the inputs and outputs of the algorithm, so that it does not
+// keep pointing to the matrices (and local values) once the batch is done
+static void unbindAll(Algorithm* algorithm) {
+  vector<string> inputNames = algorithm->inputNames();
+  vector<string> outputNames = algorithm->outputNames();
+  for (int k=0; k<(int)inputNames.size(); ++k) algorithm->input(inputNames[k]).unbind();
+  for (int k=0; k<(int)outputNames.size(); ++k) algorithm->output(outputNames[k]).unbind();
+}
+
+
+// computes the frames in [begin, end) with the given algorithm, binding its
+// inputs and vector outputs to the rows of the matrices without copying them
+static void computeFrames(Algorithm* algorithm,
+                          const vector<const FrameMatrix*>& inputs,
+                          vector<FrameMatrix>& outputs,
+                          int begin, int end) {
+  vector<string> inputNames = algorithm->inputNames();
+  vector<string> outputNames = algorithm->outputNames();
+  vector<const type_info*> outputTypes = algorithm->outputTypes();
+
+  int nOutputs = (int)outputNames.size();
+  vector<bool> isReal(nOutputs);
+  for (int k=0; k<nOutputs; ++k) isReal[k] = sameType(*outputTypes[k], typeid(Real));
+
+  // Real outputs are computed here, and then stored in a row of size 1
+  vector<Real> values(nOutputs);
+  for (int k=0; k<nOutputs; ++k) {
+    if (isReal[k]) algorithm->output(outputNames[k]).set(values[k]);
+  }
+
+  try {
+    for (int i=begin; i<end; ++i) {
+      for (int k=0; k<(int)inputNames.size(); ++k) {
+        algorithm->input(inputNames[k]).set((*inputs[k])[i]);
+      }
+      for (int k=0; k<nOutputs; ++k) {
+        if (!isReal[k]) algorithm->output(outputNames[k]).set(outputs[k][i]);
+      }
+
+      algorithm->compute();
+
+      for (int k=0; k<nOutputs; ++k) {
+        if (isReal[k]) outputs[k][i].assign(1, values[k]);
+      }
+    }
+  }
+  catch (...) {
+    unbindAll(algorithm);
+    throw;
+  }
+  unbindAll(algorithm);
+}
+
+
+void computeFrameBatch(Algorithm* algorithm,
+                       const vector<const FrameMatrix*>& inputs,
+                       vector<FrameMatrix>& outputs,
+                       int nThreads) {
+  vector<const type_info*> inputTypes = algorithm->inputTypes();
+  vector<const type_info*> outputTypes = algorithm->outputTypes();
+
+  if (inputs.size() != inputTypes.size()) {
+    throw EssentiaException("computeFrameBatch: ", algorithm->name(), " has a different number of inputs than the given matrices: ", inputTypes.size());
+  }
+  for (int k=0; k<(int)inputTypes.size(); ++k) {
+    if (!sameType(*inputTypes[k], typeid(vector<Real>))) {
+      throw EssentiaException("computeFrameBatch: all the inputs of ", algorithm->name(), " should be of type vector<Real>");
+    }
+  }
+  for (int k=0; k<(int)outputTypes.size(); ++k) {
+    if (!sameType(*outputTypes[k], typeid(vector<Real>)) && !sameType(*outputTypes[k], typeid(Real))) {
+      throw EssentiaException("computeFrameBatch: all the outputs of ", algorithm->name(), " should be of type vector<Real> or Real");
+    }
+  }
+
+  int nFrames = inputs.empty() ? 0 : (int)inputs[0]->size();
+  for (int k=1; k<(int)inputs.size(); ++k) {
+    if ((int)inputs[k]->size() != nFrames) {
+      throw EssentiaException("computeFrameBatch: all the inputs should have the same number of frames");
+    }
+  }
+
+  outputs.resize(outputTypes.size());
+  for (int k=0; k<(int)outputs.size(); ++k) outputs[k].resize(nFrames);
+
+  if (nThreads <= 0) nThreads = (int)thread::hardware_concurrency();
+  nThreads = max(min(nThreads, nFrames), 1);
+
+  if (nThreads == 1) {
+    computeFrames(algorithm, inputs, outputs, 0, nFrames);
+    return;
+  }
+
+  // the first chunk of frames is computed by the given algorithm, and the
+  // other ones by copies configured with the same parameters
+  ParameterMap params;
+  vector<string> paramNames = algorithm->defaultParameters().keys();
+  for (int i=0; i<(int)paramNames.size(); ++i) {
+    const Parameter& param = algorithm->parameter(paramNames[i]);
+    if (param.isConfigured()) params.add(paramNames[i], param);
+  }
+
+  vector<unique_ptr<Algorithm> > copies(nThreads - 1);
+  for (int t=0; t<nThreads-1; ++t) {
+    copies[t].reset(AlgorithmFactory::create(algorithm->name()));
+    copies[t]->configure(params);
+  }
+
+  ThreadPool pool(nThreads);
+  for (int t=0; t<nThreads; ++t) {
+    Algorithm* algo = (t == 0) ? algorithm : copies[t-1].get();
+    int begin = (int)((long long)nFrames * t / nThreads);
+    int end = (int)((long long)nFrames * (t+1) / nThreads);
+    pool.submit([algo, &inputs, &outputs, begin, end]() {
+      computeFrames(algo, inputs, outputs, begin, end);
+    });
+  }
+  pool.wait();
+}
+
+} // namespace standard
+} // namespace essentia
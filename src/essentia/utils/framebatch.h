@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_UTILS_FRAMEBATCH_H
+#define ESSENTIA_UTILS_FRAMEBATCH_H
+
+#include <vector>
+#include "algorithm.h"
+
+namespace essentia {
+namespace standard {
+
+/**
+ * Computes a per-frame algorithm on a whole batch of frames at once, e.g. all
+ * the frames of a track, as if calling compute() on each of them in order.
+ *
+ * @c inputs contains, for each input of the algorithm, the matrix of its
+ * frames (one row per frame). All the inputs of the algorithm must be of type
+ * std::vector<Real>, and all the matrices must have the same number of rows.
+ * @c outputs gets, for each output of the algorithm, the matrix of its
+ * values for each frame. The outputs can be of type std::vector<Real> or
+ * Real, in which case each row has a single value. The inputs and vector
+ * outputs of the algorithm are bound to the rows of these matrices, and they
+ * are all unbound once the batch is done.
+ *
+ * With @c nThreads > 1 (or <= 0 to use all the hardware threads), the frames
+ * are split between copies of the algorithm configured with the same
+ * parameters and computed in parallel. This is only valid for algorithms
+ * that do not keep any state from one frame to the next.
+ */
+ESSENTIA_API void computeFrameBatch(Algorithm* algorithm,
+                                    const std::vector<const std::vector<std::vector<Real> >*>& inputs,
+                                    std::vector<std::vector<std::vector<Real> > >& outputs,
+                                    int nThreads=1);
+
+} // namespace standard
+} // namespace essentia
+
+#endif // ESSENTIA_UTILS_FRAMEBATCH_H
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_UTILS_SHAREDINSTANCES_H
+#define ESSENTIA_UTILS_SHAREDINSTANCES_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include "threading.h"
+
+namespace essentia {
+
+/**
+ * A registry of instances that are expensive to create (e.g., loaded models),
+ * so that all the callers asking for the same key share a single instance.
+ * The instances are only kept while some caller uses them.
+ *
+ * Each key has its own lock: callers asking for the same key wait for the
+ * first one to create the instance, while the instances of different keys
+ * are created concurrently.
+ */
+template <typename T>
+class SharedInstances {
+ public:
+  typedef std::function<std::shared_ptr<T>()> Creator;
+
+  /**
+   * Returns the instance registered under @c key, or creates it with
+   * @c create and registers it if there is none. If @c create throws, nothing
+   * is registered and the next caller tries again.
+   */
+  std::shared_ptr<T> get(const std::string& key, const Creator& create) {
+    std::shared_ptr<Entry> entry;
+    {
+      ForcedMutexLocker lock(_mutex);
+
+      // forget about the instances that have been released in the meantime
+      // and that nobody is creating
+      for (typename std::map<std::string, std::shared_ptr<Entry> >::iterator it = _entries.begin();
+           it != _entries.end();) {
+        if (it->second.use_count() == 1 && it->second->instance.expired()) _entries.erase(it++);
+        else ++it;
+      }
+
+      std::shared_ptr<Entry>& slot = _entries[key];
+      if (!slot) slot.reset(new Entry());
+      entry = slot;
+    }
+
+    ForcedMutexLocker lock(entry->mutex);
+    std::shared_ptr<T> instance = entry->instance.lock();
+    if (!instance) {
+      instance = create();
+      entry->instance = instance;
+    }
+    return instance;
+  }
+
+ protected:
+  struct Entry {
+    ForcedMutex mutex;
+    std::weak_ptr<T> instance;
+  };
+
+  ForcedMutex _mutex;
+  std::map<std::string, std::shared_ptr<Entry> > _entries;
+};
+
+} // namespace essentia
+
+#endif // ESSENTIA_UTILS_SHAREDINSTANCES_H
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <Eigen/Core>
+#include "sparsefilterbank.h"
+#include "sharedinstances.h"
+using namespace std;
+
+namespace essentia {
+
+static SharedInstances<const SparseFilterbank> cachedFilterbanks;
+
+
+shared_ptr<SparseFilterbank> SparseFilterbank::fromDense(const vector<vector<Real> >& weights) {
+  int spectrumSize = weights.empty() ? 0 : (int)weights[0].size();
+  shared_ptr<SparseFilterbank> filterbank = make_shared<SparseFilterbank>(spectrumSize);
+
+  for (int i=0; i<(int)weights.size(); ++i) {
+    const vector<Real>& row = weights[i];
+    int begin = 0;
+    int end = (int)row.size();
+    while (begin < end && row[begin] == 0) ++begin;
+    while (end > begin && row[end-1] == 0) --end;
+
+    filterbank->addBand(begin, vector<Real>(row.begin() + begin, row.begin() + end));
+  }
+
+  return filterbank;
+}
+
+
+shared_ptr<const SparseFilterbank> SparseFilterbank::cached(const string& key,
+    const function<shared_ptr<SparseFilterbank>()>& create) {
+  return cachedFilterbanks.get(key, create);
+}
+
+
+void SparseFilterbank::addBand(int start, const vector<Real>& weights) {
+  if (start < 0 || start + (int)weights.size() > _spectrumSize) {
+    throw EssentiaException("SparseFilterbank: the band does not fit in the spectrum");
+  }
+
+  if (_offset.empty()) _offset.push_back(0);
+
+  _start.push_back(start);
+  _weights.insert(_weights.end(), weights.begin(), weights.end());
+  _offset.push_back((int)_weights.size());
+}
+
+
+void SparseFilterbank::apply(const vector<Real>& spectrum, vector<Real>& bands, bool squared) const {
+  typedef Eigen::Map<const Eigen::Array<Real, Eigen::Dynamic, 1> > ConstArrayMap;
+
+  if ((int)spectrum.size() != _spectrumSize) {
+    throw EssentiaException("SparseFilterbank: the size of the spectrum does not match the size of the filterbank: ",
+                            spectrum.size(), " != ", _spectrumSize);
+  }
+
+  int nBands = numberBands();
+  bands.resize(nBands);
+
+  // Eigen vectorizes these products and sums
+  for (int i=0; i<nBands; ++i) {
+    int size = bandSize(i);
+    ConstArrayMap bins(&spectrum[0] + _start[i], size);
+    ConstArrayMap weights(bandWeights(i), size);
+
+    if (squared) bands[i] = (bins.square() * weights).sum();
+    else         bands[i] = (bins * weights).sum();
+  }
+}
+
+} // namespace essentia
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_UTILS_SPARSEFILTERBANK_H
+#define ESSENTIA_UTILS_SPARSEFILTERBANK_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "types.h"
+
+namespace essentia {
+
+/**
+ * A bank of filters applied to a spectrum, where each filter only covers a
+ * contiguous range of bins. Only the weights inside that range are stored,
+ * contiguously for all the bands, so applying the filterbank costs the total
+ * width of the filters instead of nBands x spectrumSize.
+ *
+ * A filterbank is immutable once built, so the same instance can be shared by
+ * all the algorithms using the same configuration (see cached()), and applied
+ * from several threads at the same time.
+ */
+class ESSENTIA_API SparseFilterbank {
+ public:
+  /**
+   * Creates an empty filterbank for spectrums of @c spectrumSize bins. The
+   * filters are added with addBand().
+   */
+  SparseFilterbank(int spectrumSize) : _spectrumSize(spectrumSize) {}
+
+  /**
+   * Creates a filterbank from the dense weights of each filter, with one row
+   * per filter. The zero weights at the beginning and the end of each row are
+   * not stored.
+   */
+  static std::shared_ptr<SparseFilterbank> fromDense(const std::vector<std::vector<Real> >& weights);
+
+  /**
+   * Returns the filterbank cached under @c key, or builds it with @c create
+   * and caches it if there is none. The key should identify all the
+   * parameters the filterbank depends on, including the spectrum size.
+   * Filterbanks are only kept in the cache while some algorithm uses them.
+   */
+  static std::shared_ptr<const SparseFilterbank> cached(const std::string& key,
+      const std::function<std::shared_ptr<SparseFilterbank>()>& create);
+
+  /**
+   * Appends a filter with the given @c weights, applied to the bins starting
+   * at @c start.
+   */
+  void addBand(int start, const std::vector<Real>& weights);
+
+  int numberBands() const { return (int)_start.size(); }
+  int spectrumSize() const { return _spectrumSize; }
+
+  int bandStart(int band) const { return _start[band]; }
+  int bandSize(int band) const { return _offset[band+1] - _offset[band]; }
+  const Real* bandWeights(int band) const { return _weights.data() + _offset[band]; }
+
+  /**
+   * Computes the weighted sum of the bins of @c spectrum covered by each
+   * filter, or of their squares if @c squared is true. The size of the
+   * spectrum must be spectrumSize().
+   */
+  void apply(const std::vector<Real>& spectrum, std::vector<Real>& bands, bool squared) const;
+
+ protected:
+  int _spectrumSize;
+
+  // first bin of each band, and offset of its weights in _weights, with an
+  // extra offset at the end so that the size of band i is offset[i+1]-offset[i]
+  std::vector<int> _start;
+  std::vector<int> _offset;
+  std::vector<Real> _weights;
+};
+
+} // namespace essentia
+
+#endif // ESSENTIA_UTILS_SPARSEFILTERBANK_H
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "threadpool.h"
+using namespace std;
+
+namespace essentia {
+
+// pool and queue index of the worker running on the current thread, so that
+// tasks submitted from inside a task go to the queue of the worker running it
+static thread_local ThreadPool* currentPool = 0;
+static thread_local int currentQueue = -1;
+
+
+ThreadPool::ThreadPool(int nThreads) : _queued(0), _pending(0), _nextQueue(0), _stop(false) {
+  if (nThreads <= 0) nThreads = (int)thread::hardware_concurrency();
+  if (nThreads <= 0) nThreads = 1;
+
+  for (int i=0; i<nThreads; i++) _queues.push_back(new WorkQueue());
+
+  // the thread calling wait() counts as the first one
+  for (int i=1; i<nThreads; i++) {
+    _workers.push_back(thread(&ThreadPool::workerLoop, this, i));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    lock_guard<mutex> lock(_mutex);
+    _stop = true;
+  }
+  _condition.notify_all();
+
+  for (int i=0; i<(int)_workers.size(); i++) _workers[i].join();
+  for (int i=0; i<(int)_queues.size(); i++) delete _queues[i];
+}
+
+
+void ThreadPool::submit(const Task& task) {
+  int index = (currentPool == this) ? currentQueue
+                                    : (int)(_nextQueue++ % _queues.size());
+  ++_pending;
+  {
+    lock_guard<mutex> lock(_queues[index]->mutex);
+    _queues[index]->tasks.push_back(task);
+  }
+  {
+    // taking the lock makes sure no thread misses the notification between
+    // checking for queued tasks and going to sleep
+    lock_guard<mutex> lock(_mutex);
+    ++_queued;
+  }
+  _condition.notify_one();
+}
+
+
+bool ThreadPool::popTask(int index, Task& task) {
+  int n = (int)_queues.size();
+
+  // first look at our own queue, newest task first...
+  if (index >= 0) {
+    WorkQueue& q = *_queues[index];
+    lock_guard<mutex> lock(q.mutex);
+    if (!q.tasks.empty()) {
+      task = q.tasks.back();
+      q.tasks.pop_back();
+      --_queued;
+      return true;
+    }
+  }
+
+  // ...then try to steal the oldest task from the other ones
+  int start = (index >= 0) ? index + 1 : 0;
+  for (int i=0; i<n; i++) {
+    WorkQueue& q = *_queues[(start + i) % n];
+    lock_guard<mutex> lock(q.mutex);
+    if (!q.tasks.empty()) {
+      task = q.tasks.front();
+      q.tasks.pop_front();
+      --_queued;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+void ThreadPool::runTask(Task& task) {
+  try {
+    task();
+  }
+  catch (...) {
+    lock_guard<mutex> lock(_mutex);
+    if (!_exception) _exception = current_exception();
+  }
+
+  if (--_pending == 0) {
+    lock_guard<mutex> lock(_mutex);
+    _condition.notify_all();
+  }
+}
+
+
+void ThreadPool::workerLoop(int index) {
+  currentPool = this;
+  currentQueue = index;
+
+  Task task;
+  while (true) {
+    if (popTask(index, task)) {
+      runTask(task);
+      continue;
+    }
+
+    unique_lock<mutex> lock(_mutex);
+    _condition.wait(lock, [this]() { return _stop || _queued > 0; });
+    if (_stop) return;
+  }
+}
+
+
+void ThreadPool::wait() {
+  ThreadPool* previousPool = currentPool;
+  int previousQueue = currentQueue;
+  currentPool = this;
+  currentQueue = 0;
+
+  Task task;
+  while (_pending > 0) {
+    if (popTask(0, task)) {
+      runTask(task);
+      continue;
+    }
+
+    unique_lock<mutex> lock(_mutex);
+    _condition.wait(lock, [this]() { return _pending == 0 || _queued > 0; });
+  }
+
+  currentPool = previousPool;
+  currentQueue = previousQueue;
+
+  exception_ptr e;
+  {
+    lock_guard<mutex> lock(_mutex);
+    swap(e, _exception);
+  }
+  if (e) rethrow_exception(e);
+}
+
+} // namespace essentia
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_UTILS_THREADPOOL_H
+#define ESSENTIA_UTILS_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "config.h"
+
+namespace essentia {
+
+/**
+ * A small work-stealing thread pool.
+ *
+ * Each worker owns a queue of tasks: tasks submitted from a worker thread are
+ * pushed onto the back of its own queue and popped back from there (LIFO, for
+ * cache locality), while idle workers steal from the front of the other queues.
+ * Tasks submitted from outside the pool are distributed in a round-robin
+ * fashion.
+ *
+ * The thread calling wait() also takes part in the execution of the tasks, so
+ * a pool of N threads only spawns N-1 workers.
+ */
+class ESSENTIA_API ThreadPool {
+ public:
+  typedef std::function<void()> Task;
+
+  /**
+   * Creates a pool that runs tasks on @c nThreads threads (including the one
+   * calling wait()). If @c nThreads <= 0, the number of hardware threads is used.
+   */
+  ThreadPool(int nThreads = 0);
+  ~ThreadPool();
+
+  int numberThreads() const { return (int)_queues.size(); }
+
+  /**
+   * Schedules a task to be run by one of the threads of the pool. This method
+   * can be called from within a task.
+   */
+  void submit(const Task& task);
+
+  /**
+   * Blocks until all the tasks submitted so far (and the ones they submitted
+   * in turn) have been completed, helping to run them in the meantime.
+   * If any task threw an exception, the first one is rethrown here.
+   */
+  void wait();
+
+ protected:
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<WorkQueue*> _queues;
+  std::vector<std::thread> _workers;
+
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  std::atomic<int> _queued;   // number of tasks waiting in the queues
+  std::atomic<int> _pending;  // number of tasks submitted but not completed yet
+  std::atomic<unsigned int> _nextQueue;
+  bool _stop;
+
+  std::exception_ptr _exception;
+
+  bool popTask(int index, Task& task);
+  void runTask(Task& task);
+  void workerLoop(int index);
+};
+
+} // namespace essentia
+
+#endif // ESSENTIA_UTILS_THREADPOOL_H
@@ -21,6 +21,10 @@
 #include <windows.h>
 #endif
 
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
 #include <essentia/essentia.h>
 #include <essentia/algorithm.h>
 #include <essentia/algorithmfactory.h> 
@@ -37,6 +41,11 @@ using namespace essentia::standard;
 void usage(char *progname) {
     cout << "Error: wrong number of arguments" << endl;
     cout << "Usage: " << progname << " input_audiofile output_textfile [profile]" << endl;
+    cout << "       " << progname << " --batch manifest [profile] [--threads N]" << endl;
+    cout << endl << "In batch mode, the manifest is a text file (or '-' to read it from the standard input)" << endl
+         << "with one 'input_audiofile<TAB>output_textfile' pair per line. The files are analyzed" << endl
+         << "by N worker threads (default: number of cores), each one reusing the same configured" << endl
+         << "extractor for all its files." << endl;
     cout << endl << "Music extractor version '" << MUSIC_EXTRACTOR_VERSION << "'" << endl 
          << "built with Essentia version " << essentia::version_git_sha << endl;
     creditLibAV();
@@ -90,6 +99,147 @@ int essentia_main(string audioFilename, string outputFilename, string profileFil
   return 0;
 }
 
+int essentia_batch_main(string manifestFilename, string profileFilename, int nThreads) {
+  // Returns: 1 if any of the files could not be analyzed
+
+  vector<pair<string, string> > jobs;
+  ifstream manifestFile;
+  if (manifestFilename != "-") {
+    manifestFile.open(manifestFilename.c_str());
+    if (!manifestFile.is_open()) {
+      cerr << "Could not open manifest file " << manifestFilename << endl;
+      return 1;
+    }
+  }
+  istream& manifest = (manifestFilename == "-") ? cin : manifestFile;
+
+  string line;
+  while (getline(manifest, line)) {
+    if (!line.empty() && line[line.size()-1] == '\r') line.erase(line.size()-1);
+    if (line.empty()) continue;
+
+    size_t tab = line.find('\t');
+    if (tab == string::npos) {
+      cerr << "Invalid line in manifest (expected 'input_audiofile<TAB>output_textfile'): " << line << endl;
+      return 1;
+    }
+    jobs.push_back(make_pair(line.substr(0, tab), line.substr(tab+1)));
+  }
+
+  if (nThreads <= 0) nThreads = (int)thread::hardware_concurrency();
+  if (nThreads <= 0) nThreads = 1;
+  nThreads = min(nThreads, max((int)jobs.size(), 1));
+
+  try {
+    essentia::init();
+    cout.precision(10);
+
+    Pool options;
+    setExtractorDefaultOptions(options);
+    setExtractorOptions(profileFilename, options);
+
+    atomic<int> nextJob(0);
+    atomic<int> failures(0);
+    mutex logMutex;
+
+    // each worker configures its own extractor once (loading the profile and
+    // models) and reuses it for all the files it processes
+    auto worker = [&]() {
+      Algorithm* extractor = 0;
+      try {
+        extractor = AlgorithmFactory::create("MusicExtractor", "profile", profileFilename);
+      }
+      catch (EssentiaException& e) {
+        lock_guard<mutex> lock(logMutex);
+        cerr << e.what() << endl;
+        // give up on the jobs no worker has taken yet, so that each of them
+        // is only counted once, even if several workers fail
+        int firstUnclaimed = nextJob.exchange((int)jobs.size());
+        if (firstUnclaimed < (int)jobs.size()) failures += (int)jobs.size() - firstUnclaimed;
+        return;
+      }
+
+      int job;
+      while ((job = nextJob++) < (int)jobs.size()) {
+        const string& audioFilename = jobs[job].first;
+        const string& outputFilename = jobs[job].second;
+
+        try {
+          Pool results;
+          Pool resultsFrames;
+
+          extractor->input("filename").set(audioFilename);
+          extractor->output("results").set(results);
+          extractor->output("resultsFrames").set(resultsFrames);
+
+          extractor->compute();
+
+          mergeValues(results, options);
+
+          outputToFile(results, outputFilename, options);
+          if (options.value<Real>("outputFrames")) {
+            outputToFile(resultsFrames, outputFilename+"_frames", options);
+          }
+        }
+        catch (EssentiaException& e) {
+          lock_guard<mutex> lock(logMutex);
+          cerr << "Error processing " << audioFilename << ": " << e.what() << endl;
+          failures++;
+        }
+        catch (const std::bad_alloc& e) {
+          lock_guard<mutex> lock(logMutex);
+          cerr << "Error processing " << audioFilename << ": bad_alloc exception: Out of memory " << e.what() << endl;
+          failures++;
+        }
+      }
+
+      delete extractor;
+    };
+
+    vector<thread> workers;
+    for (int i=1; i<nThreads; i++) workers.push_back(thread(worker));
+    worker();
+    for (int i=0; i<(int)workers.size(); i++) workers[i].join();
+
+    essentia::shutdown();
+
+    if (failures > 0) {
+      cerr << failures << " out of " << jobs.size() << " files could not be analyzed" << endl;
+      return 1;
+    }
+  }
+  catch (EssentiaException& e) {
+    cerr << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+
+int batch_main(int argc, char* argv[]) {
+  // argv: progname --batch manifest [profile] [--threads N]
+  string manifestFilename = argv[2];
+  string profileFilename;
+  int nThreads = 0;
+
+  for (int i=3; i<argc; i++) {
+    string arg = argv[i];
+    if (arg == "--threads" && i+1 < argc) {
+      nThreads = atoi(argv[++i]);
+    }
+    else if (profileFilename.empty()) {
+      profileFilename = arg;
+    }
+    else {
+      usage(argv[0]);
+    }
+  }
+
+  return essentia_batch_main(manifestFilename, profileFilename, nThreads);
+}
+
+
 #ifdef _WIN32
 int main(int win32_argc, char **win32_argv)
 {
@@ -116,6 +266,10 @@ int main(int win32_argc, char **win32_argv)
 
   LocalFree(argv);
 
+  if (argc >= 3 && string(utf8_argv[1]) == "--batch") {
+    return batch_main(argc, utf8_argv);
+  }
+
   string audioFilename, outputFilename, profileFilename;
 
   switch (argc) {
@@ -138,6 +292,10 @@ int main(int win32_argc, char **win32_argv)
 #else
 int main(int argc, char* argv[]) {
 
+  if (argc >= 3 && string(argv[1]) == "--batch") {
+    return batch_main(argc, argv);
+  }
+
   string audioFilename, outputFilename, profileFilename;
 
   switch (argc) {
@@ -39,6 +39,7 @@ using namespace essentia;
 
 
 #include "typedefs.h"
+#include "pyaudioinputsource.cpp"
 #include "pyalgorithm.cpp"
 #include "pystreamingalgorithm.cpp"
 #include "pyvectorinput.cpp"
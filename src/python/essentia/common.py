@@ -531,6 +531,14 @@ class Pool:
 
         return self.cppPool.__value__(key, self.cppPool.__keyType__(key))
 
+    def view(self, key):
+        # same as pool[key], except that frames of the same size are returned
+        # as a read-only array that shares the Pool's storage instead of a copy
+        if not self.containsKey(key):
+            raise KeyError('no key found named \''+key+'\'')
+
+        return self.cppPool.__value__(key, self.cppPool.__keyType__(key), True)
+
     def containsKey(self, key):
         return key in self.descriptorNames()
 
@@ -22,6 +22,7 @@ from . import common as _c
 import sys as _sys
 from ._essentia import keys as algorithmNames, info as algorithmInfo
 from copy import copy
+import numpy as _numpy
 
 # given an essentia algorithm name, create the corresponding class
 def _create_essentia_class(name, moduleName = __name__):
@@ -71,7 +72,7 @@ def _create_essentia_class(name, moduleName = __name__):
 
             # we have to make some exceptions for YamlOutput and PoolAggregator
             # because they expect cpp Pools
-            if name in ('YamlOutput', 'PoolAggregator', 'SvmClassifier', 'PCA', 'GaiaTransform', 'TensorflowPredict'):
+            if name in ('YamlOutput', 'PoolAggregator', 'SvmClassifier', 'PCA', 'GaiaTransform', 'TensorflowPredict', 'OnnxPredict'):
                 args = (args[0].cppPool,)
 
             # verify that all types match and do any necessary conversions
@@ -105,7 +106,7 @@ def _create_essentia_class(name, moduleName = __name__):
 
             # we have to make an exceptional case for YamlInput, because we need
             # to wrap the Pool that it outputs w/ our python Pool from common.py
-            if name in ('YamlInput', 'PoolAggregator', 'SvmClassifier', 'PCA', 'GaiaTransform', 'Extractor', 'TensorflowPredict'):
+            if name in ('YamlInput', 'PoolAggregator', 'SvmClassifier', 'PCA', 'GaiaTransform', 'Extractor', 'TensorflowPredict', 'OnnxPredict'):
                 return _c.Pool(results)
 
             # MusicExtractor and FreesoundExtractor output two pools
@@ -119,6 +120,27 @@ def _create_essentia_class(name, moduleName = __name__):
             else:
                 return results
 
+        def computeBatch(self, *args, threads=1):
+            # compute the algorithm on a batch of frames (2D arrays, one frame per
+            # row) in a single call. The frames are copied to and from C++, and
+            # computed without holding the GIL. With threads > 1 (or 0 for all the
+            # cores), the frames are split between copies of the algorithm, which
+            # is only valid if it keeps no state from one frame to the next
+            inputNames = self.inputNames()
+
+            if len(args) != len(inputNames):
+                raise ValueError(name+'.computeBatch requires '+str(len(inputNames))+' argument(s), '+str(len(args))+' given')
+
+            convertedArgs = []
+            for arg in args:
+                if isinstance(arg, _numpy.ndarray):
+                    arg = _numpy.ascontiguousarray(arg, dtype='float32')
+                else:
+                    arg = [_numpy.ascontiguousarray(frame, dtype='float32') for frame in arg]
+                convertedArgs.append(arg)
+
+            return self.__compute_batch__(convertedArgs, threads)
+
         def __call__(self, *args):
             return self.compute(*args)
 
@@ -123,6 +123,21 @@ def normalize(array):
 def derivative(array):
     return _essentia.derivative(_c.convertData(array, _c.Edt.VECTOR_REAL))
 
+def fftwImportWisdom(filename):
+    return _essentia.fftwImportWisdom(_c.convertData(filename, _c.Edt.STRING))
+
+def fftwExportWisdom(filename):
+    return _essentia.fftwExportWisdom(_c.convertData(filename, _c.Edt.STRING))
+
+def fftwForgetWisdom():
+    return _essentia.fftwForgetWisdom()
+
+def fftwPlannerRigor():
+    return _essentia.fftwPlannerRigor()
+
+def fftwSetPlannerRigor(rigor):
+    return _essentia.fftwSetPlannerRigor(_c.convertData(rigor, _c.Edt.STRING))
+
 __all__ = [ 'isSilent', 'instantPower',
             'nextPowerTwo', 'isPowerTwo',
             'lin2db', 'db2lin',
@@ -138,4 +153,6 @@ __all__ = [ 'isSilent', 'instantPower',
             'velocity2db', 'db2velocity',
             'postProcessTicks',
             'normalize', 'derivative',
-            'equivalentKey', 'lin2log']
+            'equivalentKey', 'lin2log',
+            'fftwImportWisdom', 'fftwExportWisdom', 'fftwForgetWisdom',
+            'fftwPlannerRigor', 'fftwSetPlannerRigor']
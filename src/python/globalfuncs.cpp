@@ -22,6 +22,9 @@
 #include "poolstorage.h" // connecting pools
 #include "../algorithms/io/fileoutputproxy.h" // connecting FileOutput algorithm
 #include "bpmutil.h" // postProcessTicks()
+#ifdef HAVE_FFTW
+#include "../algorithms/standard/fftw.h" // FFTW wisdom and planner rigor
+#endif
 
 static PyObject*
 get_version() {
@@ -846,11 +849,23 @@ static PyObject* run(PyObject* notUsed, PyObject* obj) {
 
   PyStreamingAlgorithm* pyAlg = reinterpret_cast<PyStreamingAlgorithm*>(obj);
 
+  // the network only works on C++ data (the python objects it may use, such
+  // as file-like audio sources, take the GIL themselves), so other python
+  // threads can run in the meantime
+  bool failed = false;
+  string error;
+  Py_BEGIN_ALLOW_THREADS
   try {
     scheduler::Network(pyAlg->algo, false).run();
   }
   catch (const exception& e) {
-    PyErr_SetString(PyExc_RuntimeError, e.what());
+    failed = true;
+    error = e.what();
+  }
+  Py_END_ALLOW_THREADS
+
+  if (failed) {
+    PyErr_SetString(PyExc_RuntimeError, error.c_str());
     return NULL;
   }
 
@@ -1136,6 +1151,59 @@ postProcessTicks(PyObject* self, PyObject* args) {
 }
 
 
+#ifdef HAVE_FFTW
+#define FFTW_CALL(call) try { call; } \
+  catch (const exception& e) { PyErr_SetString(PyExc_RuntimeError, e.what()); return NULL; }
+#else
+#define FFTW_CALL(call) \
+  PyErr_SetString(PyExc_RuntimeError, "Essentia was not compiled with FFTW"); return NULL;
+#endif
+
+static PyObject*
+fftwImportWisdom(PyObject* self, PyObject* arg) {
+  if (!PyString_Check(arg)) {
+    PyErr_SetString(PyExc_TypeError, (char*)"argument must be a string");
+    return NULL;
+  }
+  FFTW_CALL(standard::FFTW::importWisdom(PyString_AS_STRING(arg)));
+  Py_RETURN_NONE;
+}
+
+static PyObject*
+fftwExportWisdom(PyObject* self, PyObject* arg) {
+  if (!PyString_Check(arg)) {
+    PyErr_SetString(PyExc_TypeError, (char*)"argument must be a string");
+    return NULL;
+  }
+  FFTW_CALL(standard::FFTW::exportWisdom(PyString_AS_STRING(arg)));
+  Py_RETURN_NONE;
+}
+
+static PyObject*
+fftwForgetWisdom() {
+  FFTW_CALL(standard::FFTW::forgetWisdom());
+  Py_RETURN_NONE;
+}
+
+static PyObject*
+fftwSetPlannerRigor(PyObject* self, PyObject* arg) {
+  if (!PyString_Check(arg)) {
+    PyErr_SetString(PyExc_TypeError, (char*)"argument must be a string");
+    return NULL;
+  }
+  FFTW_CALL(standard::FFTW::setPlannerRigor(PyString_AS_STRING(arg)));
+  Py_RETURN_NONE;
+}
+
+static PyObject*
+fftwPlannerRigor() {
+  string rigor;
+  FFTW_CALL(rigor = standard::FFTW::plannerRigor());
+  return PyString_FromString(rigor.c_str());
+}
+
+#undef FFTW_CALL
+
 
 static PyMethodDef Essentia__Methods[] = {
   { "debugLevel",      (PyCFunction)debug_level,       METH_NOARGS,  "return the activated debugging modules." },
@@ -1202,5 +1270,10 @@ static PyMethodDef Essentia__Methods[] = {
   { "version_git_sha",      (PyCFunction)get_version_git_sha, METH_NOARGS, "returns essentia's version git commit SHA hash" }, 
   { "almostEqualArray", (PyCFunction)almostEqualArray,   METH_VARARGS, "Returns true if two numpy arrays are within a given precision of each other" },
   { "postProcessTicks", (PyCFunction)postProcessTicks,   METH_VARARGS, "Purges ticks array based on ticks amplitude and the preferred period" },
+  { "fftwImportWisdom",    (PyCFunction)fftwImportWisdom,    METH_O,       "loads FFTW wisdom from a file." },
+  { "fftwExportWisdom",    (PyCFunction)fftwExportWisdom,    METH_O,       "saves the accumulated FFTW wisdom to a file." },
+  { "fftwForgetWisdom",    (PyCFunction)fftwForgetWisdom,    METH_NOARGS,  "forgets the accumulated FFTW wisdom." },
+  { "fftwPlannerRigor",    (PyCFunction)fftwPlannerRigor,    METH_NOARGS,  "returns the rigor of the FFTW planner." },
+  { "fftwSetPlannerRigor", (PyCFunction)fftwSetPlannerRigor, METH_O,       "sets the rigor of the FFTW planner (estimate, measure, patient or exhaustive)." },
   { NULL } // Sentinel
 };
@@ -21,6 +21,7 @@
 #include "structmember.h"
 #include "algorithm.h"
 #include "algorithmfactory.h"
+#include "framebatch.h"
 #include "roguevector.h"
 #include "commonfunctions.h"
 #include "parsing.h"
@@ -43,6 +44,10 @@ class PyAlgorithm {
 
   Algorithm* algo;
 
+  // set while the algorithm is being configured or computed, as the GIL is
+  // released meanwhile and another python thread could try to use it
+  bool computing;
+
   static PyObject* make_new(PyTypeObject* type, PyObject* args, PyObject* kwds);
   static int init(PyAlgorithm *self, PyObject *args, PyObject *kwds);
   static void dealloc(PyObject* self);
@@ -52,6 +57,7 @@ class PyAlgorithm {
   }
 
   static PyObject* reset(PyAlgorithm* self) {
+    if (isComputing(self)) return NULL;
     self->algo->reset();
     Py_RETURN_NONE;
   }
@@ -71,14 +77,32 @@ class PyAlgorithm {
     return VectorString::toPythonCopy(&names);
   }
 
+  // raises an exception if the algorithm is in use by another python thread
+  static bool isComputing(PyAlgorithm* self) {
+    if (!self->computing) return false;
+    ostringstream msg;
+    msg << self->algo->name() << " is already in use by another thread";
+    PyErr_SetString(PyExc_RuntimeError, msg.str().c_str());
+    return true;
+  }
+
   static PyObject* configure(PyAlgorithm* self, PyObject* args, PyObject* keywds);
   static PyObject* compute(PyAlgorithm* self, PyObject* args);
+  static PyObject* computeBatch(PyAlgorithm* self, PyObject* args);
   static PyObject* inputType(PyAlgorithm* self, PyObject* name);
   static PyObject* paramType(PyAlgorithm* self, PyObject* name);
   static PyObject* paramValue(PyAlgorithm* self, PyObject* name);
 
   static PyObject* getDoc(PyAlgorithm* self);
   static PyObject* getStruct(PyAlgorithm* self);
+
+  static PyObject* setInputBuffer(PyAlgorithm* self, PyObject* obj) {
+    return setAudioInput(self->algo, obj, true);
+  }
+
+  static PyObject* setInputSource(PyAlgorithm* self, PyObject* obj) {
+    return setAudioInput(self->algo, obj, false);
+  }
 };
 
 
@@ -86,6 +110,16 @@ PyObject* PyAlgorithm::make_new(PyTypeObject* type, PyObject* args, PyObject* kw
   return (PyObject*)(type->tp_alloc(type, 0));
 }
 
+// marks an algorithm as computing for the lifetime of this object
+class ComputingGuard {
+ public:
+  ComputingGuard(PyAlgorithm* algo) : _algo(algo) { _algo->computing = true; }
+  ~ComputingGuard() { _algo->computing = false; }
+ protected:
+  PyAlgorithm* _algo;
+};
+
+
 void PyAlgorithm::dealloc(PyObject* self) {
   delete ((PyAlgorithm*)self)->algo;
   self->ob_type->tp_free(self);
@@ -121,6 +155,9 @@ PyObject* PyAlgorithm::configure(PyAlgorithm* self, PyObject* args, PyObject* ke
 
   E_DEBUG(EPyBindings, PY_ALGONAME << "::configure()");
 
+  if (isComputing(self)) return NULL;
+  ComputingGuard guard(self);
+
   // create the list of named parameters that this algorithm can accept
   ParameterMap pm = self->algo->defaultParameters();
 
@@ -135,13 +172,23 @@ PyObject* PyAlgorithm::configure(PyAlgorithm* self, PyObject* args, PyObject* ke
     return NULL;
   }
 
-  // actually configure the underlying C++ algorithm
+  // actually configure the underlying C++ algorithm. This may take some time
+  // (e.g., loading a model), so let other python threads run meanwhile.
+  bool failed = false;
+  string error;
+  Py_BEGIN_ALLOW_THREADS
   try {
     self->algo->configure(pm);
   }
   catch (const exception& e) {
+    failed = true;
+    error = e.what();
+  }
+  Py_END_ALLOW_THREADS
+
+  if (failed) {
     ostringstream msg;
-    msg << "Error while configuring " << self->algo->name() << ": " << e.what();
+    msg << "Error while configuring " << self->algo->name() << ": " << error;
     PyErr_SetString(PyExc_RuntimeError, msg.str().c_str());
     return NULL;
   }
@@ -173,7 +220,7 @@ void deallocate_outputs(vector<void*> outputs, vector<Edt> outputTypes) {
     if (outputs[i] == NULL) continue;
     Edt tp = outputTypes[i];
     if (tp != VECTOR_REAL && tp != VECTOR_COMPLEX && tp != VECTOR_INTEGER &&
-        tp != MATRIX_REAL && tp != POOL) {
+        tp != MATRIX_REAL && tp != TENSOR_REAL && tp != POOL) {
       dealloc(outputs[i], tp);
     }
   }
@@ -183,6 +230,11 @@ void deallocate_outputs(vector<void*> outputs, vector<Edt> outputTypes) {
 PyObject* PyAlgorithm::compute(PyAlgorithm* self, PyObject* args) {
   E_DEBUG(EPyBindings, PY_ALGONAME << "::compute()");
 
+  // the inputs and outputs are bound to the algorithm itself, so it cannot
+  // compute in several threads at the same time
+  if (isComputing(self)) return NULL;
+  ComputingGuard guard(self);
+
   // parse the arguments into separate python objects
   vector<PyObject*> arg_list = unpack(args);
 
@@ -337,15 +389,25 @@ PyObject* PyAlgorithm::compute(PyAlgorithm* self, PyObject* args) {
 
 
   // now that the algorithm and ready and set to go (all inputs and outputs
-  // are correctly bound), we can safely call the compute() method.
+  // are correctly bound), we can safely call the compute() method. It only
+  // works on C++ data, so other python threads can run in the meantime.
   E_DEBUG(EPyBindings, PY_ALGONAME << ": computing...");
 
+  bool failed = false;
+  string error;
+  Py_BEGIN_ALLOW_THREADS
   try {
     self->algo->compute();
   }
   catch (const exception& e) {
+    failed = true;
+    error = e.what();
+  }
+  Py_END_ALLOW_THREADS
+
+  if (failed) {
     ostringstream msg;
-    msg << "In " << self->algo->name() << ".compute: " << e.what();
+    msg << "In " << self->algo->name() << ".compute: " << error;
     PyErr_SetString(PyExc_RuntimeError, msg.str().c_str());
 
     // clean up temp vars
@@ -367,7 +429,13 @@ PyObject* PyAlgorithm::compute(PyAlgorithm* self, PyObject* args) {
 
   for (int i=0; i<nOutputs; i++) {
     try {
-      result[i] = toPython(outputs[i], outputTypes[i]);
+      // the numpy array takes the ownership of the tensor, instead of copying it
+      if (outputTypes[i] == TENSOR_REAL) {
+        result[i] = TensorReal::toPythonRef((Tensor<Real>*)outputs[i]);
+      }
+      else {
+        result[i] = toPython(outputs[i], outputTypes[i]);
+      }
     }
     catch (const exception& e) {
       // clean up
@@ -393,6 +461,109 @@ PyObject* PyAlgorithm::compute(PyAlgorithm* self, PyObject* args) {
 }
 
 
+// copies a batch of frames, given either as a 2D numpy array of floats or as
+// a list of frames, to a matrix with one row per frame. The frames are copied
+// because computeFrameBatch works on std::vector rows, which cannot point to
+// the numpy data
+static vector<vector<Real> >* framesFromPython(PyObject* obj) {
+  if (!PyArray_Check(obj)) {
+    return (vector<vector<Real> >*)VectorVectorReal::fromPythonCopy(obj);
+  }
+
+  PyArrayObject* array = (PyArrayObject*)obj;
+  if (PyArray_NDIM(array) != 2) {
+    throw EssentiaException("the array of frames has dimension ", PyArray_NDIM(array), " (expected 2)");
+  }
+  if (PyArray_TYPE(array) != NPY_FLOAT || !PyArray_IS_C_CONTIGUOUS(array)) {
+    throw EssentiaException("the array of frames should be a C-contiguous array of Reals (dtype='f4')");
+  }
+
+  int nFrames = PyArray_DIM(array, 0);
+  int frameSize = PyArray_DIM(array, 1);
+  const Real* data = (const Real*)PyArray_DATA(array);
+
+  vector<vector<Real> >* frames = new vector<vector<Real> >(nFrames);
+  for (int i=0; i<nFrames; ++i) {
+    (*frames)[i].assign(data + i*frameSize, data + (i+1)*frameSize);
+  }
+  return frames;
+}
+
+
+PyObject* PyAlgorithm::computeBatch(PyAlgorithm* self, PyObject* args) {
+  E_DEBUG(EPyBindings, PY_ALGONAME << "::computeBatch()");
+
+  PyObject* frames;
+  int nThreads;
+  if (!PyArg_ParseTuple(args, "O!i", &PyList_Type, &frames, &nThreads)) {
+    return NULL;
+  }
+
+  if (isComputing(self)) return NULL;
+  ComputingGuard guard(self);
+
+  int nInputs = PyList_Size(frames);
+  vector<vector<vector<Real> >*> inputs;
+
+  try {
+    for (int i=0; i<nInputs; ++i) {
+      inputs.push_back(framesFromPython(PyList_GetItem(frames, i)));
+    }
+  }
+  catch (const exception& e) {
+    for (int i=0; i<(int)inputs.size(); ++i) delete inputs[i];
+    ostringstream msg;
+    msg << "In " << self->algo->name() << ".computeBatch: " << e.what();
+    PyErr_SetString(PyExc_TypeError, msg.str().c_str());
+    return NULL;
+  }
+
+  // all the frames are computed in C++, without holding the GIL
+  vector<const vector<vector<Real> >*> constInputs(inputs.begin(), inputs.end());
+  vector<vector<vector<Real> > > outputs;
+  bool failed = false;
+  string error;
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    computeFrameBatch(self->algo, constInputs, outputs, nThreads);
+  }
+  catch (const exception& e) {
+    failed = true;
+    error = e.what();
+  }
+  Py_END_ALLOW_THREADS
+
+  for (int i=0; i<(int)inputs.size(); ++i) delete inputs[i];
+
+  if (failed) {
+    ostringstream msg;
+    msg << "In " << self->algo->name() << ".computeBatch: " << error;
+    PyErr_SetString(PyExc_RuntimeError, msg.str().c_str());
+    return NULL;
+  }
+
+  // Real outputs are returned as a vector, and vector outputs are copied to a
+  // matrix
+  vector<const type_info*> outputTypes = self->algo->outputTypes();
+  vector<PyObject*> result(outputs.size());
+
+  for (int k=0; k<(int)outputs.size(); ++k) {
+    if (sameType(*outputTypes[k], typeid(Real))) {
+      RogueVector<Real>* values = new RogueVector<Real>(outputs[k].size(), 0.);
+      for (int i=0; i<(int)outputs[k].size(); ++i) (*values)[i] = outputs[k][i][0];
+      result[k] = VectorReal::toPythonRef(values);
+    }
+    else {
+      result[k] = VectorVectorReal::toPythonCopy(&outputs[k]);
+    }
+  }
+
+  E_DEBUG(EPyBindings, PY_ALGONAME << "::computeBatch() done!");
+
+  return buildReturnValue(result);
+}
+
+
 PyObject* PyAlgorithm::inputType(PyAlgorithm* self, PyObject* obj) {
   if (!PyString_Check(obj)) {
     PyErr_SetString(PyExc_TypeError, "Algorithm.inputType expects a string as the only argument");
@@ -494,6 +665,8 @@ static PyMethodDef PyAlgorithm_methods[] = {
                       "Configure the algorithm" },
   { "__compute__",    (PyCFunction)PyAlgorithm::compute, METH_VARARGS,
                       "compute the algorithm" },
+  { "__compute_batch__", (PyCFunction)PyAlgorithm::computeBatch, METH_VARARGS,
+                      "compute the algorithm on a batch of frames" },
   { "inputType",      (PyCFunction)PyAlgorithm::inputType, METH_O,
                       "Returns the type of the input given by its name" },
   { "paramType",      (PyCFunction)PyAlgorithm::paramType, METH_O,
@@ -504,6 +677,10 @@ static PyMethodDef PyAlgorithm_methods[] = {
                       "Returns the doc string for the algorithm"},
   { "getStruct",      (PyCFunction)PyAlgorithm::getStruct, METH_NOARGS,
                       "Returns the doc struct for the algorithm"},
+  { "setInputBuffer", (PyCFunction)PyAlgorithm::setInputBuffer, METH_O,
+                      "Decodes the audio from the given bytes-like object instead of a file (AudioLoader only)" },
+  { "setInputSource", (PyCFunction)PyAlgorithm::setInputSource, METH_O,
+                      "Decodes the audio from the given file-like object instead of a file (AudioLoader only)" },
   { NULL }  /* Sentinel */
 };
 
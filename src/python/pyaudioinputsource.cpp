@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <Python.h>
+#include "audioinputsource.h"
+
+using namespace essentia;
+using namespace std;
+
+
+/**
+ * AudioInputSource reading the memory of a Python object supporting the buffer
+ * protocol (bytes, bytearray, memoryview, numpy arrays...). The buffer is not
+ * copied, we only keep a reference to the object as long as the source lives.
+ */
+class PyBufferAudioInputSource : public MemoryAudioInputSource {
+ protected:
+  Py_buffer _view;
+
+ public:
+  PyBufferAudioInputSource(const Py_buffer& view)
+    : MemoryAudioInputSource(view.buf, (size_t)view.len), _view(view) {}
+
+  ~PyBufferAudioInputSource() {
+    PyGILState_STATE state = PyGILState_Ensure();
+    PyBuffer_Release(&_view);
+    PyGILState_Release(state);
+  }
+};
+
+
+/**
+ * AudioInputSource reading a Python file-like object through its read(),
+ * seek() and tell() methods. The decoder may call them from any thread, so
+ * they are always called holding the GIL.
+ */
+class PyFileAudioInputSource : public AudioInputSource {
+ protected:
+  PyObject* _file;
+
+  // calls the given method and returns its result as an integer, or -1 on error
+  int64_t callInt(const char* method, const char* format, int64_t a=0, int b=0) {
+    PyObject* result = PyObject_CallMethod(_file, method, format, (long long)a, b);
+    if (!result) {
+      PyErr_Clear();
+      return -1;
+    }
+    int64_t value = result == Py_None ? -1 : (int64_t)PyLong_AsLongLong(result);
+    Py_DECREF(result);
+    if (PyErr_Occurred()) {
+      PyErr_Clear();
+      return -1;
+    }
+    return value;
+  }
+
+ public:
+  PyFileAudioInputSource(PyObject* file) : _file(file) {
+    Py_INCREF(_file);
+  }
+
+  ~PyFileAudioInputSource() {
+    PyGILState_STATE state = PyGILState_Ensure();
+    Py_DECREF(_file);
+    PyGILState_Release(state);
+  }
+
+  int read(uint8_t* buffer, int size) {
+    PyGILState_STATE state = PyGILState_Ensure();
+
+    int n = -1;
+    PyObject* data = PyObject_CallMethod(_file, "read", "i", size);
+    if (data) {
+      Py_buffer view;
+      if (PyObject_GetBuffer(data, &view, PyBUF_SIMPLE) == 0) {
+        n = (int)min((Py_ssize_t)size, view.len);
+        memcpy(buffer, view.buf, n);
+        PyBuffer_Release(&view);
+      }
+      Py_DECREF(data);
+    }
+    if (n < 0) {
+      E_WARNING("AudioLoader: error reading from the Python input source");
+      PyErr_Clear();
+    }
+
+    PyGILState_Release(state);
+    return n;
+  }
+
+  int64_t seek(int64_t offset, int whence) {
+    PyGILState_STATE state = PyGILState_Ensure();
+    int64_t position = callInt("seek", "Li", offset, whence);
+    PyGILState_Release(state);
+    return position;
+  }
+
+  int64_t size() {
+    PyGILState_STATE state = PyGILState_Ensure();
+    int64_t size = -1;
+    int64_t position = callInt("tell", NULL);
+    if (position >= 0) {
+      size = callInt("seek", "Li", 0, SEEK_END);
+      callInt("seek", "Li", position, SEEK_SET);
+    }
+    PyGILState_Release(state);
+    return size;
+  }
+};
+
+
+/**
+ * Implements the setInputBuffer() and setInputSource() methods of the Python
+ * algorithms, for the ones which can decode from an AudioInputSource.
+ */
+static PyObject* setAudioInput(Configurable* algo, PyObject* obj, bool isBuffer) {
+  AudioInputSourceReader* reader = dynamic_cast<AudioInputSourceReader*>(algo);
+  if (!reader) {
+    ostringstream msg;
+    msg << algo->name() << " cannot read its audio from an input source";
+    PyErr_SetString(PyExc_TypeError, msg.str().c_str());
+    return NULL;
+  }
+
+  shared_ptr<AudioInputSource> source;
+
+  if (obj == Py_None) {
+    // go back to reading the file given by the "filename" parameter
+  }
+  else if (isBuffer) {
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_SIMPLE) != 0) return NULL;
+    source = make_shared<PyBufferAudioInputSource>(view);
+  }
+  else {
+    if (!PyObject_HasAttrString(obj, "read")) {
+      PyErr_SetString(PyExc_TypeError, "setInputSource expects a file-like object with a read() method");
+      return NULL;
+    }
+    source = make_shared<PyFileAudioInputSource>(obj);
+  }
+
+  try {
+    reader->setInputSource(source);
+  }
+  catch (const exception& e) {
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
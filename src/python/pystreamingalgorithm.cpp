@@ -73,6 +73,14 @@ class PyStreamingAlgorithm {
   static PyObject* paramValue(PyStreamingAlgorithm* self, PyObject* name);
 
   static PyObject* getDoc(PyStreamingAlgorithm* self);
+
+  static PyObject* setInputBuffer(PyStreamingAlgorithm* self, PyObject* obj) {
+    return setAudioInput(self->algo, obj, true);
+  }
+
+  static PyObject* setInputSource(PyStreamingAlgorithm* self, PyObject* obj) {
+    return setAudioInput(self->algo, obj, false);
+  }
   static PyObject* getStruct(PyStreamingAlgorithm* self);
 };
 
@@ -394,6 +402,12 @@ static PyMethodDef PyStreamingAlgorithm_methods[] = {
   { "getStruct", (PyCFunction)PyStreamingAlgorithm::getStruct, METH_NOARGS,
       "Returns the doc struct for the algorithm"},
 
+  { "setInputBuffer", (PyCFunction)PyStreamingAlgorithm::setInputBuffer, METH_O,
+      "Decodes the audio from the given bytes-like object instead of a file (AudioLoader only)" },
+
+  { "setInputSource", (PyCFunction)PyStreamingAlgorithm::setInputSource, METH_O,
+      "Decodes the audio from the given file-like object instead of a file (AudioLoader only)" },
+
   { NULL } /* Sentinel */
 };
 
@@ -35,7 +35,7 @@ PyMethodDef PyPool_methods[] = {
   { "__mergeSingle__",(PyCFunction)PyPool::mergeSingle, METH_VARARGS,
                       "Pool.mergeSingle(key, value) sets \"value\" in the pool under \"key\"" },
   { "__value__",      (PyCFunction)PyPool::value, METH_VARARGS,
-                      "Pool.value(key) retrieves a value from the pool under \"key\"" },
+                      "Pool.value(key, type, view=False) retrieves a value from the pool under \"key\"" },
   { "isSingleValue",  (PyCFunction)PyPool::isSingleValue, METH_O,
                       "Pool.isSingleValue(key) returns true if the descriptor under \"key\" is a single value descriptor" },
   { "remove",         (PyCFunction)PyPool::remove, METH_O,
@@ -136,7 +136,7 @@ PyObject* PyPool::keyType(PyPool* self, PyObject* obj) {
   }
 
   // search vector<Real> sub-pool
-  if (p.getVectorRealPool().find(key) != p.getVectorRealPool().end()) {
+  if (p.getVectorRealFramesPool().find(key) != p.getVectorRealFramesPool().end()) {
     return PyString_FromString( edtToString(VECTOR_VECTOR_REAL).c_str() );
   }
 
@@ -500,14 +500,16 @@ PyObject* PyPool::mergeSingle(PyPool* self, PyObject* pyArgs) {
 PyObject* PyPool::value(PyPool* self, PyObject* pyArgs) {
   vector<PyObject*> args = unpack(pyArgs);
 
-  // make sure we have two arg and they are strings
-  if (args.size() != 2 || !PyString_Check(args[0]) || !PyString_Check(args[1])) {
-    PyErr_SetString(PyExc_RuntimeError, "2 arguments required (string, string)");
+  // make sure we have two string args, and optionally a bool
+  if (args.size() < 2 || args.size() > 3 || !PyString_Check(args[0]) || !PyString_Check(args[1]) ||
+      (args.size() == 3 && !PyBool_Check(args[2]))) {
+    PyErr_SetString(PyExc_RuntimeError, "2 or 3 arguments required (string, string[, bool])");
     return NULL;
   }
 
   string key = PyString_AS_STRING(args[0]);
   Edt tp = stringToEdt( PyString_AS_STRING(args[1]) );
+  bool view = args.size() == 3 && args[2] == Py_True;
   Pool& p = *(self->pool);
 
   try {
@@ -526,7 +528,26 @@ PyObject* PyPool::value(PyPool* self, PyObject* pyArgs) {
       }
       case VECTOR_STRING: return VectorString::toPythonCopy(&p.value<vector<string> >(key));
       case VECTOR_STEREOSAMPLE: return VectorStereoSample::toPythonCopy(&p.value<vector<StereoSample> >(key));
-      case VECTOR_VECTOR_REAL: return VectorVectorReal::toPythonCopy(&p.value<vector<vector<Real> > >(key));
+      case VECTOR_VECTOR_REAL: {
+        // frames of the same size are copied in one go from the block in
+        // which the Pool stores them. If a view is asked for, the block is
+        // shared with a read-only array instead, and the Pool copies it if
+        // more frames are added afterwards.
+        const VectorRealFrames& frames = p.value<VectorRealFrames>(key);
+        if (frames.isContiguous() && frames.size() > 0 && frames.frameSize() > 0) {
+          npy_intp dims[2] = { (npy_intp)frames.size(), (npy_intp)frames.frameSize() };
+          if (view) {
+            typedef shared_ptr<const vector<Real> > SharedFrames;
+            SharedFrames* data = new SharedFrames(frames.sharedData());
+            return arrayFromOwner(2, dims, NPY_FLOAT, (void*)(*data)->data(), data, false);
+          }
+          vector<Real>* data = new vector<Real>(*frames.sharedData());
+          return arrayFromOwner(2, dims, NPY_FLOAT, (void*)data->data(), data);
+        }
+        vector<vector<Real> > copy;
+        frames.copyTo(copy);
+        return VectorVectorReal::toPythonCopy(&copy);
+      }
       case VECTOR_VECTOR_STRING: return VectorVectorString::toPythonCopy(&p.value<vector<vector<string> > >(key));
       case VECTOR_MATRIX_REAL: return VectorMatrixReal::toPythonCopy(&p.value<vector<TNT::Array2D<Real> > >(key));
       case VECTOR_TENSOR_REAL: return VectorTensorReal::toPythonCopy(&p.value<vector<Tensor<Real> > >(key));
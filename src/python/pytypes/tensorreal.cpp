@@ -53,6 +53,24 @@ PyObject* TensorReal::toPythonCopy(const essentia::Tensor<essentia::Real>* tenso
 }
 
 
+PyObject* TensorReal::toPythonRef(Tensor<Real>* tensor) {
+  npy_intp dims[TENSORRANK];
+  for (int i=0; i<TENSORRANK; i++) dims[i] = tensor->dimension(i);
+
+  if (tensor->size() == 0) {
+    delete tensor;
+    PyObject* result = PyArray_SimpleNew(TENSORRANK, dims, NPY_FLOAT);
+    if (result == NULL) {
+      throw EssentiaException("TensorReal: dang null object");
+    }
+    return result;
+  }
+
+  // the tensor is row-major, as numpy arrays, so its data can be used as is
+  return arrayFromOwner(TENSORRANK, dims, NPY_FLOAT, tensor->data(), tensor);
+}
+
+
 void* TensorReal::fromPythonCopy(PyObject* obj) {
   if (!PyArray_Check(obj)) {
     throw EssentiaException("TensorReal::fromPythonRef: expected PyArray, received: ", strtype(obj));
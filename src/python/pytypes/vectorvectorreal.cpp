@@ -34,6 +34,7 @@ PyObject* VectorVectorReal::toPythonCopy(const vector<vector<Real> >* v) {
   for (int i=1; i<dims[0]; i++) {
     if ((int)(*v)[i].size() != dims[1]) {
       isRectangular = false;
+      break;
     }
   }
 
@@ -208,6 +208,35 @@ inline void dealloc(void* ptr, Edt tp) {
   }
 }
 
+/**
+ * Creates a numpy array of the given dimensions that uses @c data without
+ * copying it. @c owner is the object in which the data is stored: it is kept
+ * alive by a capsule set as the base of the array, and deleted along with it.
+ */
+template <typename T>
+PyObject* arrayFromOwner(int nd, npy_intp* dims, int typenum, void* data, T* owner,
+                         bool writeable=true) {
+  PyObject* capsule = PyCapsule_New(owner, NULL, [](PyObject* capsule) {
+    delete (T*)PyCapsule_GetPointer(capsule, NULL);
+  });
+  if (capsule == NULL) {
+    delete owner;
+    throw essentia::EssentiaException("arrayFromOwner: could not create the capsule");
+  }
+
+  int flags = writeable ? NPY_ARRAY_CARRAY : NPY_ARRAY_CARRAY_RO;
+  PyObject* result = PyArray_New(&PyArray_Type, nd, dims, typenum, NULL, data, 0, flags, NULL);
+  if (result == NULL) {
+    Py_DECREF(capsule);
+    throw essentia::EssentiaException("arrayFromOwner: dang null object");
+  }
+
+  // steals the reference to the capsule
+  PyArray_SetBaseObject((PyArrayObject*)result, capsule);
+
+  return result;
+}
+
 inline std::string strtype(PyObject* obj) {
   return PyString_AsString(PyObject_Str(PyObject_Type(obj)));
 }
@@ -0,0 +1,16 @@
+/* This file is automatically created by the build system.
+ * Please make changes only in its source file version.h.in.
+ */
+
+#ifndef ESSENTIA_VERSION_H_
+#define ESSENTIA_VERSION_H_
+
+#define ESSENTIA_VERSION "2.1-beta6-dev"
+#define ESSENTIA_GIT_SHA ""
+#define ESSENTIA_VERSION_MAJOR 2
+#define ESSENTIA_VERSION_MINOR 1
+#define ESSENTIA_VERSION_PATCH 0
+
+#define ESSENTIA_VERSION_INT ( ( ESSENTIA_VERSION_MAJOR * 100 + ESSENTIA_VERSION_MINOR ) * 100 + ESSENTIA_VERSION_PATCH )
+
+#endif /* ESSENTIA_VERSION_H_ */
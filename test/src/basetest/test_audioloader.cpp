@@ -23,6 +23,9 @@
 #include "vectorinput.h"
 #include "vectoroutput.h"
 #include "customalgos.h"
+#include "audioinputsource.h"
+#include <fstream>
+#include <iterator>
 using namespace std;
 using namespace essentia;
 using namespace essentia::streaming;
@@ -101,3 +104,29 @@ TEST(AudioLoader, SampleFormatConversion) {
     EXPECT_EQ("pcm_s32le", p.value<string>("codec"));
     EXPECT_EQ(2822400, p.value<Real>("bit_rate"));
 }
+
+TEST(AudioLoader, InputBuffer) {
+    ifstream file("test/audio/recorded/cat_purrrr.wav", ios::binary);
+    string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    ASSERT_FALSE(data.empty());
+
+    AlgorithmFactory& factory = AlgorithmFactory::instance();
+    Algorithm* loader = factory.create("AudioLoader", "computeMD5", true);
+    dynamic_cast<AudioInputSourceReader*>(loader)->setInputBuffer(data.data(), data.size());
+    essentia::Pool p;
+
+    loader->output("audio")           >>  PC(p, "audio");
+    loader->output("sampleRate")      >>  PC(p, "samplerate");
+    loader->output("numberChannels")  >>  PC(p, "channels");
+    loader->output("md5")             >>  PC(p, "md5");
+    loader->output("codec")           >>  PC(p, "codec");
+    loader->output("bit_rate")        >>  PC(p, "bit_rate");
+
+    Network(loader).run();
+
+    EXPECT_EQ(44100,   p.value<Real>("samplerate"));
+    EXPECT_EQ(2,       p.value<Real>("channels"));
+    EXPECT_EQ(219343,  (int)p.value<vector<StereoSample> >("audio").size());
+    EXPECT_EQ("426fe5cf5ac3730f8c8db2a760e2b819", p.value<string>("md5"));
+    EXPECT_EQ("pcm_s16le", p.value<string>("codec"));
+}
@@ -17,6 +17,7 @@
  * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
  */
 
+#include <thread>
 #include "essentia_gtest.h"
 #include "scheduler/network.h"
 using namespace std;
@@ -136,6 +137,60 @@ TEST(Connectors, MultiReaderTest) {
   ASSERT_THROW(sink2.pop(), EssentiaException);
 }
 
+TEST(Connectors, MultiReaderThreaded) {
+  // the writer and the readers live on different threads, and the buffer is
+  // much smaller than the number of tokens exchanged so that it wraps around
+  Source<int> source("Source1");
+  Sink<int> sink("Sink1");
+  Sink<int> sink2("Sink2");
+
+  connect(source, sink);
+  connect(source, sink2);
+
+  BufferInfo buf;
+  buf.size = 64;
+  buf.maxContiguousElements = 8;
+  source.setBufferInfo(buf);
+
+  const int nTokens = 100000;
+  const int frameSize = 8;
+
+  std::thread writer([&]() {
+    for (int n=0; n<nTokens; n+=frameSize) {
+      while (!source.acquire(frameSize)) std::this_thread::yield();
+      vector<int>& tokens = source.tokens();
+      for (int i=0; i<frameSize; i++) tokens[i] = n + i;
+      source.release(frameSize);
+    }
+  });
+
+  vector<int> errors(2, 0);
+  Sink<int>* sinks[2] = { &sink, &sink2 };
+  vector<std::thread> readers;
+  for (int r=0; r<2; r++) {
+    readers.push_back(std::thread([&, r]() {
+      int expected = 0;
+      while (expected < nTokens) {
+        if (!sinks[r]->acquire(1)) {
+          std::this_thread::yield();
+          continue;
+        }
+        if (sinks[r]->tokens()[0] != expected) errors[r]++;
+        expected++;
+        sinks[r]->release(1);
+      }
+    }));
+  }
+
+  writer.join();
+  for (int r=0; r<2; r++) readers[r].join();
+
+  EXPECT_EQ(errors[0], 0);
+  EXPECT_EQ(errors[1], 0);
+  EXPECT_EQ(source.totalProduced(), nTokens);
+  EXPECT_EQ(sink.available(), 0);
+}
+
 TEST(Connectors, SourceProxyConnectBeforeAttach) {
   Source<string> src("Source1");
   SourceProxy<string> proxy("Proxy1");
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+
+#include "essentia_gtest.h"
+#include "framebatch.h"
+using namespace std;
+using namespace essentia;
+using namespace essentia::standard;
+
+
+// frames of a sine with a different frequency in each one
+static vector<vector<Real> > sineFrames(int nFrames, int frameSize) {
+  vector<vector<Real> > frames(nFrames, vector<Real>(frameSize));
+  for (int i=0; i<nFrames; ++i) {
+    for (int j=0; j<frameSize; ++j) frames[i][j] = sin(0.01 * (i+1) * j);
+  }
+  return frames;
+}
+
+
+TEST(FrameBatch, SameAsCompute) {
+  vector<vector<Real> > frames = sineFrames(20, 256);
+
+  Algorithm* spectrum = AlgorithmFactory::create("Spectrum");
+  Algorithm* centroid = AlgorithmFactory::create("Centroid", "range", 128);
+
+  vector<vector<vector<Real> > > spectrums;
+  computeFrameBatch(spectrum, vector<const vector<vector<Real> >*>(1, &frames), spectrums);
+  ASSERT_EQ(spectrums.size(), (size_t)1);
+  ASSERT_EQ(spectrums[0].size(), frames.size());
+
+  // Real outputs are returned in rows of size one
+  vector<vector<vector<Real> > > centroids;
+  computeFrameBatch(centroid, vector<const vector<vector<Real> >*>(1, &spectrums[0]), centroids);
+  ASSERT_EQ(centroids[0].size(), frames.size());
+
+  for (int i=0; i<(int)frames.size(); ++i) {
+    vector<Real> expectedSpectrum;
+    Real expectedCentroid;
+    spectrum->input("frame").set(frames[i]);
+    spectrum->output("spectrum").set(expectedSpectrum);
+    spectrum->compute();
+    centroid->input("array").set(expectedSpectrum);
+    centroid->output("centroid").set(expectedCentroid);
+    centroid->compute();
+
+    EXPECT_VEC_EQ(spectrums[0][i], expectedSpectrum);
+    ASSERT_EQ(centroids[0][i].size(), (size_t)1);
+    EXPECT_EQ(centroids[0][i][0], expectedCentroid);
+  }
+
+  delete spectrum;
+  delete centroid;
+}
+
+TEST(FrameBatch, Parallel) {
+  vector<vector<Real> > frames = sineFrames(37, 512);
+  vector<const vector<vector<Real> >*> inputs(1, &frames);
+
+  Algorithm* spectrum = AlgorithmFactory::create("Spectrum", "size", 512);
+
+  vector<vector<vector<Real> > > expected, found;
+  computeFrameBatch(spectrum, inputs, expected, 1);
+  computeFrameBatch(spectrum, inputs, found, 4);
+
+  ASSERT_EQ(found[0].size(), expected[0].size());
+  for (int i=0; i<(int)frames.size(); ++i) {
+    EXPECT_VEC_EQ(found[0][i], expected[0][i]);
+  }
+
+  delete spectrum;
+}
+
+TEST(FrameBatch, InvalidInputs) {
+  vector<vector<Real> > frames = sineFrames(4, 64);
+  vector<vector<Real> > fewerFrames = sineFrames(3, 64);
+  vector<vector<vector<Real> > > outputs;
+
+  // inputs of a type other than vector<Real>
+  Algorithm* magnitude = AlgorithmFactory::create("Magnitude");
+  vector<const vector<vector<Real> >*> inputs(1, &frames);
+  ASSERT_THROW(computeFrameBatch(magnitude, inputs, outputs), EssentiaException);
+  delete magnitude;
+
+  // inputs with a different number of frames
+  Algorithm* multiply = AlgorithmFactory::create("BinaryOperator", "type", "multiply");
+  inputs.push_back(&fewerFrames);
+  ASSERT_THROW(computeFrameBatch(multiply, inputs, outputs), EssentiaException);
+
+  // wrong number of inputs
+  inputs.pop_back();
+  ASSERT_THROW(computeFrameBatch(multiply, inputs, outputs), EssentiaException);
+  delete multiply;
+}
+
+TEST(FrameBatch, UnbindsAfterBatch) {
+  vector<vector<Real> > frames = sineFrames(8, 128);
+  vector<const vector<vector<Real> >*> inputs(1, &frames);
+
+  Algorithm* spectrum = AlgorithmFactory::create("Spectrum", "size", 128);
+
+  // the algorithm should not keep pointing to the matrices of the batch,
+  // whether it was computed in a single thread or not
+  for (int nThreads=1; nThreads<=2; ++nThreads) {
+    vector<vector<vector<Real> > > outputs;
+    computeFrameBatch(spectrum, inputs, outputs, nThreads);
+    ASSERT_THROW(spectrum->compute(), EssentiaException);
+  }
+
+  delete spectrum;
+}
@@ -18,6 +18,7 @@
  */
 
 #include <algorithm>
+#include <thread>
 #include "essentia_gtest.h"
 using namespace std;
 using essentia::Real;
@@ -105,6 +106,25 @@ TEST(Pool, RealVectorPoolMultiple) {
   EXPECT_MATRIX_EQ(p.value<vector<vector<Real> > >("foo.bar"), expected);
 }
 
+TEST(Pool, RealVectorSharedData) {
+  vector<Real> frame1(3, 1.0);
+  vector<Real> frame2(3, 2.0);
+
+  essentia::Pool p;
+  p.add("foo.bar", frame1);
+  shared_ptr<const vector<Real> > data = p.value<essentia::VectorRealFrames>("foo.bar").sharedData();
+  const vector<Real>& shared = *data;
+  EXPECT_VEC_EQ(shared, frame1);
+
+  // the shared data is not modified by the pool afterwards
+  p.add("foo.bar", frame2);
+  EXPECT_VEC_EQ(shared, frame1);
+  EXPECT_EQ(p.value<essentia::VectorRealFrames>("foo.bar").size(), (size_t)2);
+
+  p.clear();
+  EXPECT_VEC_EQ(shared, frame1);
+}
+
 TEST(Pool, RealVectorPoolMultipleLabels) {
   vector<Real> expectedVec1;
   expectedVec1.push_back(1.6);
@@ -264,3 +284,206 @@ TEST(Pool, IntegrityCheck) {
   p.add("foo.bar", (Real)1.23456789);
   ASSERT_THROW(p.add("foo.bar", "mixed up the types!"), EssentiaException);
 }
+
+TEST(Pool, IntegrityCheckParentChild) {
+  essentia::Pool p;
+  p.add("foo.bar", (Real)1.0);
+  ASSERT_THROW(p.add("foo", (Real)2.0), EssentiaException);
+  ASSERT_THROW(p.add("foo.bar.baz", (Real)2.0), EssentiaException);
+  p.add("foo.baz", (Real)3.0);
+
+  // names become available again once removed
+  p.removeNamespace("foo");
+  p.add("foo", (Real)4.0);
+  p.remove("foo");
+  p.add("foo.bar.baz", (Real)5.0);
+  EXPECT_EQ(p.descriptorNames(), vector<string>(1, "foo.bar.baz"));
+}
+
+TEST(Pool, DescriptorHandle) {
+  essentia::Pool p;
+  essentia::DescriptorHandle h = p.descriptorHandle<Real>("foo.bar");
+  EXPECT_EQ(h.name(), "foo.bar");
+  // registering a name does not create the descriptor
+  EXPECT_TRUE(p.descriptorNames().empty());
+
+  p.add(h, (Real)1.0);
+  p.add("foo.bar", (Real)2.0);
+  p.add(h, (Real)3.0);
+
+  vector<Real> expected;
+  expected.push_back(1.0);
+  expected.push_back(2.0);
+  expected.push_back(3.0);
+  EXPECT_VEC_EQ(p.value<vector<Real> >("foo.bar"), expected);
+
+  // the handle creates the descriptor again after it was removed
+  p.remove("foo.bar");
+  p.add(h, (Real)4.0);
+  EXPECT_VEC_EQ(p.value<vector<Real> >("foo.bar"), vector<Real>(1, 4.0));
+
+  p.clear();
+  p.add(h, (Real)5.0);
+  EXPECT_VEC_EQ(p.value<vector<Real> >("foo.bar"), vector<Real>(1, 5.0));
+}
+
+TEST(Pool, DescriptorHandleVectorReal) {
+  essentia::Pool p;
+  essentia::DescriptorHandle h = p.descriptorHandle<vector<Real> >("foo.bar");
+
+  vector<vector<Real> > expected(3, vector<Real>(2));
+  for (int i=0; i<3; i++) {
+    expected[i][0] = i;
+    expected[i][1] = 2*i;
+    p.add(h, expected[i]);
+  }
+  EXPECT_MATRIX_EQ(p.value<vector<vector<Real> > >("foo.bar"), expected);
+}
+
+TEST(Pool, DescriptorHandleInvalid) {
+  essentia::Pool p;
+  p.add("foo.bar", (Real)1.0);
+  ASSERT_THROW(p.descriptorHandle<string>("foo.bar"), EssentiaException);
+  ASSERT_THROW(p.descriptorHandle<Real>("foo"), EssentiaException);
+  ASSERT_THROW(p.descriptorHandle<Real>("foo.bar.baz"), EssentiaException);
+
+  essentia::DescriptorHandle h = p.descriptorHandle<Real>("foo.bar");
+  ASSERT_THROW(p.add(h, string("mixed up the types!")), EssentiaException);
+  ASSERT_THROW(p.descriptorHandle<vector<Real> >("foo.bar"), EssentiaException);
+
+  // a handle can only be used with the pool that created it
+  essentia::Pool copy = p;
+  ASSERT_THROW(copy.add(h, (Real)2.0), EssentiaException);
+  ASSERT_THROW(p.add(essentia::DescriptorHandle(), (Real)2.0), EssentiaException);
+
+  // a name registered but not added yet can still be taken by another type
+  essentia::DescriptorHandle h2 = p.descriptorHandle<Real>("bar");
+  p.add("bar", string("a string"));
+  ASSERT_THROW(p.add(h2, (Real)2.0), EssentiaException);
+}
+
+TEST(Pool, RealVectorContiguous) {
+  essentia::Pool p;
+  vector<vector<Real> > expected(4, vector<Real>(3));
+  for (int i=0; i<4; i++) {
+    for (int j=0; j<3; j++) expected[i][j] = 3*i + j;
+    p.add("foo.bar", expected[i]);
+  }
+
+  const essentia::VectorRealFrames& frames = p.value<essentia::VectorRealFrames>("foo.bar");
+  ASSERT_TRUE(frames.isContiguous());
+  EXPECT_EQ(frames.size(), (size_t)4);
+  EXPECT_EQ(frames.frameSize(), (size_t)3);
+  // the frames are stored as a row-major matrix
+  for (int i=0; i<12; i++) EXPECT_EQ(frames.data()[i], Real(i));
+
+  EXPECT_MATRIX_EQ(p.value<vector<vector<Real> > >("foo.bar"), expected);
+
+  // frames added after the conversion to a vector of frames are also returned
+  expected.push_back(vector<Real>(3, 12.0));
+  p.add("foo.bar", expected.back());
+  EXPECT_MATRIX_EQ(p.value<vector<vector<Real> > >("foo.bar"), expected);
+}
+
+TEST(Pool, RealVectorJagged) {
+  essentia::Pool p;
+  vector<vector<Real> > expected;
+  expected.push_back(vector<Real>(2, 1.0));
+  expected.push_back(vector<Real>(2, 2.0));
+  expected.push_back(vector<Real>(3, 3.0));
+  expected.push_back(vector<Real>(1, 4.0));
+  for (int i=0; i<(int)expected.size(); i++) p.add("foo.bar", expected[i]);
+
+  const essentia::VectorRealFrames& frames = p.value<essentia::VectorRealFrames>("foo.bar");
+  ASSERT_FALSE(frames.isContiguous());
+  ASSERT_THROW(frames.data(), EssentiaException);
+  EXPECT_MATRIX_EQ(p.value<vector<vector<Real> > >("foo.bar"), expected);
+
+  for (int i=0; i<(int)expected.size(); i++) {
+    ASSERT_EQ(frames.rowSize(i), expected[i].size());
+    EXPECT_VEC_EQ(vector<Real>(frames.row(i), frames.row(i) + frames.rowSize(i)), expected[i]);
+  }
+}
+
+TEST(Pool, RealVectorPool) {
+  essentia::Pool p;
+  vector<vector<Real> > expected(2, vector<Real>(3, 1.0));
+  p.add("foo.bar", expected[0]);
+  p.add("foo.bar", expected[1]);
+
+  const map<string, vector<vector<Real> > >& pool = p.getVectorRealPool();
+  ASSERT_EQ(pool.size(), (size_t)1);
+  EXPECT_MATRIX_EQ(pool.find("foo.bar")->second, expected);
+
+  // the vectors of frames follow the frames added, removed and added again
+  expected.push_back(vector<Real>(3, 2.0));
+  p.add("foo.bar", expected.back());
+  EXPECT_MATRIX_EQ(p.getVectorRealPool().find("foo.bar")->second, expected);
+
+  p.remove("foo.bar");
+  EXPECT_TRUE(p.getVectorRealPool().empty());
+
+  p.add("foo.bar", expected[2]);
+  EXPECT_MATRIX_EQ(p.value<vector<vector<Real> > >("foo.bar"), vector<vector<Real> >(1, expected[2]));
+}
+
+TEST(Pool, RealVectorMerge) {
+  essentia::Pool p;
+  vector<vector<Real> > v1(2, vector<Real>(2, 1.0));
+  vector<vector<Real> > v2(2, vector<Real>(2, 2.0));
+  p.merge("foo.bar", v1);
+  p.merge("foo.bar", v2, "interleave");
+
+  vector<vector<Real> > expected;
+  expected.push_back(v1[0]);
+  expected.push_back(v2[0]);
+  expected.push_back(v1[1]);
+  expected.push_back(v2[1]);
+  EXPECT_MATRIX_EQ(p.value<vector<vector<Real> > >("foo.bar"), expected);
+  EXPECT_TRUE(p.value<essentia::VectorRealFrames>("foo.bar").isContiguous());
+
+  p.merge("foo.bar", v2, "replace");
+  EXPECT_MATRIX_EQ(p.value<vector<vector<Real> > >("foo.bar"), v2);
+  EXPECT_TRUE(p.contains<vector<vector<Real> > >("foo.bar"));
+}
+
+TEST(Pool, ConcurrentAdd) {
+  // threads adding to the same new descriptors and to their own ones
+  essentia::Pool p;
+  const int nThreads = 8, nValues = 1000;
+  vector<thread> threads;
+  for (int t=0; t<nThreads; ++t) {
+    threads.push_back(thread([&p, t]() {
+      for (int i=0; i<nValues; ++i) {
+        p.add("shared.real", Real(i));
+        p.add("shared.frames", vector<Real>(4, Real(t)));
+        p.add("own.real" + to_string(t), Real(i));
+      }
+    }));
+  }
+  for (int t=0; t<nThreads; ++t) threads[t].join();
+
+  EXPECT_EQ(int(p.value<vector<Real> >("shared.real").size()), nThreads*nValues);
+  EXPECT_EQ(int(p.value<vector<vector<Real> > >("shared.frames").size()), nThreads*nValues);
+  for (int t=0; t<nThreads; ++t) {
+    EXPECT_EQ(int(p.value<vector<Real> >("own.real" + to_string(t)).size()), nValues);
+  }
+}
+
+TEST(Pool, Copy) {
+  essentia::Pool p;
+  p.add("foo.bar", Real(1));
+  p.set("foo.baz", "value");
+
+  essentia::Pool copy(p);
+  p.add("foo.bar", Real(2));
+  EXPECT_EQ(int(copy.value<vector<Real> >("foo.bar").size()), 1);
+  EXPECT_EQ(copy.value<string>("foo.baz"), "value");
+
+  copy = p;
+  EXPECT_EQ(int(copy.value<vector<Real> >("foo.bar").size()), 2);
+  ASSERT_THROW(copy.add("foo.baz", Real(1)), EssentiaException);
+
+  essentia::Pool moved(std::move(copy));
+  EXPECT_EQ(int(moved.value<vector<Real> >("foo.bar").size()), 2);
+}
@@ -21,6 +21,8 @@
 #include "network.h"
 #include "networkparser.h"
 #include "graphutils.h"
+#include "vectorinput.h"
+#include "vectoroutput.h"
 using namespace std;
 using namespace essentia;
 using namespace essentia::streaming;
@@ -61,3 +63,69 @@ TEST(Scheduler, SourceProxyFork) {
 
   network.run();
 }
+
+
+/**
+ * Runs a network with several independent branches hanging off a FrameCutter,
+ * and returns the results computed in each of them.
+ */
+void runBranchesNetwork(int nThreads, vector<vector<Real> >& spectrum,
+                        vector<Real>& rms, vector<Real>& zcr,
+                        bool threadsAfterPrepare=false) {
+  AlgorithmFactory& factory = AlgorithmFactory::instance();
+
+  vector<Real> signal(44100);
+  for (int i=0; i<(int)signal.size(); i++) signal[i] = sin(0.01*i) + 0.1*cos(0.3*i);
+
+  VectorInput<Real>* gen = new VectorInput<Real>(&signal);
+  Algorithm* fc = factory.create("FrameCutter", "frameSize", 1024, "hopSize", 256);
+  Algorithm* w = factory.create("Windowing");
+  Algorithm* spec = factory.create("Spectrum");
+  Algorithm* r = factory.create("RMS");
+  Algorithm* z = factory.create("ZeroCrossingRate");
+
+  gen->output("data")    >>  fc->input("signal");
+  fc->output("frame")    >>  w->input("frame");
+  w->output("frame")     >>  spec->input("frame");
+  spec->output("spectrum")  >>  spectrum;
+  fc->output("frame")    >>  r->input("array");
+  r->output("rms")       >>  rms;
+  fc->output("frame")    >>  z->input("signal");
+  z->output("zeroCrossingRate")  >>  zcr;
+
+  Network network(gen);
+  if (threadsAfterPrepare) {
+    network.runPrepare();
+    network.setNumberThreads(nThreads);
+    while (network.runStep());
+  }
+  else {
+    network.setNumberThreads(nThreads);
+    network.run();
+  }
+}
+
+TEST(Scheduler, ParallelBranches) {
+  vector<vector<Real> > spectrum, spectrumParallel;
+  vector<Real> rms, rmsParallel, zcr, zcrParallel;
+
+  runBranchesNetwork(1, spectrum, rms, zcr);
+  runBranchesNetwork(4, spectrumParallel, rmsParallel, zcrParallel);
+
+  EXPECT_TRUE(spectrum.size() > 0);
+  EXPECT_MATRIX_EQ(spectrum, spectrumParallel);
+  EXPECT_VEC_EQ(rms, rmsParallel);
+  EXPECT_VEC_EQ(zcr, zcrParallel);
+}
+
+TEST(Scheduler, ParallelBranchesThreadsAfterPrepare) {
+  vector<vector<Real> > spectrum, spectrumParallel;
+  vector<Real> rms, rmsParallel, zcr, zcrParallel;
+
+  runBranchesNetwork(1, spectrum, rms, zcr);
+  runBranchesNetwork(4, spectrumParallel, rmsParallel, zcrParallel, true);
+
+  EXPECT_MATRIX_EQ(spectrum, spectrumParallel);
+  EXPECT_VEC_EQ(rms, rmsParallel);
+  EXPECT_VEC_EQ(zcr, zcrParallel);
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "essentia_gtest.h"
+#include "sharedinstances.h"
+using namespace std;
+using namespace essentia;
+
+
+TEST(SharedInstances, SameKey) {
+  SharedInstances<int> instances;
+  int created = 0;
+  SharedInstances<int>::Creator create = [&]() { created++; return make_shared<int>(created); };
+
+  shared_ptr<int> a = instances.get("a", create);
+  shared_ptr<int> b = instances.get("a", create);
+  EXPECT_EQ(a.get(), b.get());
+  EXPECT_EQ(created, 1);
+
+  shared_ptr<int> c = instances.get("c", create);
+  EXPECT_NE(a.get(), c.get());
+  EXPECT_EQ(created, 2);
+}
+
+TEST(SharedInstances, Released) {
+  SharedInstances<int> instances;
+  int created = 0;
+  SharedInstances<int>::Creator create = [&]() { created++; return make_shared<int>(created); };
+
+  weak_ptr<int> first = instances.get("a", create);
+  EXPECT_TRUE(first.expired());
+
+  shared_ptr<int> second = instances.get("a", create);
+  EXPECT_EQ(*second, 2);
+}
+
+TEST(SharedInstances, CreateThrows) {
+  SharedInstances<int> instances;
+  SharedInstances<int>::Creator fail = []() -> shared_ptr<int> { throw EssentiaException("failed"); };
+  SharedInstances<int>::Creator create = []() { return make_shared<int>(1); };
+
+  ASSERT_THROW(instances.get("a", fail), EssentiaException);
+  EXPECT_EQ(*instances.get("a", create), 1);
+}
+
+TEST(SharedInstances, ConcurrentKeys) {
+  SharedInstances<int> instances;
+  atomic<bool> creatingA(false);
+  atomic<bool> bCreated(false);
+  bool bCreatedWhileCreatingA = false;
+
+  // "b" must be created while "a" is still being created, which would time
+  // out if creating an instance blocked the other keys.
+  thread threadA([&]() {
+    instances.get("a", [&]() {
+      creatingA = true;
+      for (int i=0; i<1000 && !bCreated; ++i) this_thread::sleep_for(chrono::milliseconds(1));
+      bCreatedWhileCreatingA = bCreated;
+      return make_shared<int>(1);
+    });
+  });
+
+  while (!creatingA) this_thread::sleep_for(chrono::milliseconds(1));
+  instances.get("b", [&]() { bCreated = true; return make_shared<int>(2); });
+  threadA.join();
+
+  EXPECT_TRUE(bCreatedWhileCreatingA);
+}
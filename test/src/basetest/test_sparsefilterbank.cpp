@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+
+#include "essentia_gtest.h"
+#include "sparsefilterbank.h"
+using namespace std;
+using namespace essentia;
+
+
+TEST(SparseFilterbank, FromDense) {
+  vector<vector<Real> > dense(3, vector<Real>(6, 0.0));
+  dense[0][0] = 1.0; dense[0][1] = 0.5;
+  dense[1][2] = 0.25; dense[1][4] = 2.0;
+
+  shared_ptr<SparseFilterbank> filterbank = SparseFilterbank::fromDense(dense);
+
+  EXPECT_EQ(filterbank->numberBands(), 3);
+  EXPECT_EQ(filterbank->spectrumSize(), 6);
+  EXPECT_EQ(filterbank->bandStart(0), 0);
+  EXPECT_EQ(filterbank->bandSize(0), 2);
+  EXPECT_EQ(filterbank->bandStart(1), 2);
+  EXPECT_EQ(filterbank->bandSize(1), 3);
+  EXPECT_EQ(filterbank->bandSize(2), 0);
+}
+
+TEST(SparseFilterbank, Apply) {
+  vector<vector<Real> > dense(3, vector<Real>(6, 0.0));
+  dense[0][0] = 1.0; dense[0][1] = 0.5;
+  dense[1][2] = 0.25; dense[1][4] = 2.0;
+  shared_ptr<SparseFilterbank> filterbank = SparseFilterbank::fromDense(dense);
+
+  Real spectrumArray[] = { 1, 2, 3, 4, 5, 6 };
+  vector<Real> spectrum = arrayToVector<Real>(spectrumArray);
+
+  // same results as multiplying by the dense matrix
+  vector<Real> bands;
+  filterbank->apply(spectrum, bands, false);
+  for (int i=0; i<3; ++i) {
+    Real expected = 0;
+    for (int j=0; j<6; ++j) expected += spectrum[j] * dense[i][j];
+    EXPECT_FLOAT_EQ(bands[i], expected);
+  }
+
+  filterbank->apply(spectrum, bands, true);
+  for (int i=0; i<3; ++i) {
+    Real expected = 0;
+    for (int j=0; j<6; ++j) expected += spectrum[j] * spectrum[j] * dense[i][j];
+    EXPECT_FLOAT_EQ(bands[i], expected);
+  }
+
+  vector<Real> wrongSize(5, 1.0);
+  ASSERT_THROW(filterbank->apply(wrongSize, bands, false), EssentiaException);
+}
+
+TEST(SparseFilterbank, AddBand) {
+  SparseFilterbank filterbank(4);
+  filterbank.addBand(1, vector<Real>(3, 1.0));
+  EXPECT_EQ(filterbank.numberBands(), 1);
+
+  ASSERT_THROW(filterbank.addBand(2, vector<Real>(3, 1.0)), EssentiaException);
+  ASSERT_THROW(filterbank.addBand(-1, vector<Real>(1, 1.0)), EssentiaException);
+}
+
+TEST(SparseFilterbank, Cached) {
+  int created = 0;
+  function<shared_ptr<SparseFilterbank>()> create = [&created]() {
+    ++created;
+    return make_shared<SparseFilterbank>(4);
+  };
+
+  shared_ptr<const SparseFilterbank> first = SparseFilterbank::cached("test 4", create);
+  shared_ptr<const SparseFilterbank> second = SparseFilterbank::cached("test 4", create);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(created, 1);
+
+  // filterbanks are only cached while they are used
+  first.reset();
+  second.reset();
+  SparseFilterbank::cached("test 4", create);
+  EXPECT_EQ(created, 2);
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+
+#include "essentia_gtest.h"
+#include "algorithms/standard/stft.h"
+using namespace std;
+using namespace essentia;
+using namespace essentia::standard;
+
+
+// the magnitude and phase are computed in single precision, while Magnitude
+// and CartesianToPolar use double precision
+static void expectClose(const vector<Real>& x, const vector<Real>& y) {
+  ASSERT_EQ(x.size(), y.size());
+  for (int i=0; i<(int)x.size(); ++i) {
+    EXPECT_NEAR(x[i], y[i], 1e-5 * max(Real(1), abs(y[i]))) << "Vectors differ at index " << i;
+  }
+}
+
+static vector<Real> noise(int size) {
+  vector<Real> signal(size);
+  for (int i=0; i<size; ++i) signal[i] = sin(0.1*i) + 0.3*sin(1.7*i*i);
+  return signal;
+}
+
+// Windowing -> FFT -> CartesianToPolar, squaring the magnitude for the power
+// spectrum
+static void reference(const vector<Real>& frame, int zeroPadding, bool zeroPhase,
+                      bool splitPadding, const string& spectrumType,
+                      vector<Real>& spectrum, vector<Real>& phase) {
+  Algorithm* windowing = AlgorithmFactory::create("Windowing", "size", (int)frame.size(),
+                                                  "zeroPadding", zeroPadding,
+                                                  "zeroPhase", zeroPhase,
+                                                  "splitPadding", splitPadding,
+                                                  "type", "blackmanharris62");
+  Algorithm* fft = AlgorithmFactory::create("FFT");
+  Algorithm* polar = AlgorithmFactory::create("CartesianToPolar");
+
+  vector<Real> windowed;
+  vector<complex<Real> > fftBuffer;
+  vector<Real> magnitude;
+  windowing->input("frame").set(frame);
+  windowing->output("frame").set(windowed);
+  fft->input("frame").set(windowed);
+  fft->output("fft").set(fftBuffer);
+  polar->input("complex").set(fftBuffer);
+  polar->output("magnitude").set(magnitude);
+  polar->output("phase").set(phase);
+
+  windowing->compute();
+  fft->compute();
+  polar->compute();
+
+  spectrum = magnitude;
+  if (spectrumType == "power") {
+    for (int i=0; i<(int)spectrum.size(); ++i) spectrum[i] *= spectrum[i];
+  }
+
+  delete windowing;
+  delete fft;
+  delete polar;
+}
+
+
+TEST(STFT, SameAsWindowingSpectrum) {
+  vector<Real> frame = noise(256);
+
+  const int paddings[] = { 0, 256, 766 };
+  for (int p=0; p<3; ++p) {
+    for (int zeroPhase=0; zeroPhase<2; ++zeroPhase) {
+      for (int splitPadding=0; splitPadding<2; ++splitPadding) {
+        for (int power=0; power<2; ++power) {
+          string type = power ? "power" : "magnitude";
+          vector<Real> expectedSpectrum, expectedPhase;
+          reference(frame, paddings[p], zeroPhase, splitPadding, type,
+                    expectedSpectrum, expectedPhase);
+
+          Algorithm* stft = AlgorithmFactory::create("STFT", "frameSize", 256,
+                                                     "zeroPadding", paddings[p],
+                                                     "zeroPhase", (bool)zeroPhase,
+                                                     "splitPadding", (bool)splitPadding,
+                                                     "windowType", "blackmanharris62",
+                                                     "spectrumType", type,
+                                                     "computePhase", true);
+          vector<Real> spectrum, phase;
+          stft->input("frame").set(frame);
+          stft->output("spectrum").set(spectrum);
+          stft->output("phase").set(phase);
+          stft->compute();
+
+          expectClose(spectrum, expectedSpectrum);
+          expectClose(phase, expectedPhase);
+          delete stft;
+        }
+      }
+    }
+  }
+}
+
+
+TEST(STFT, FrameSizeChange) {
+  Algorithm* stft = AlgorithmFactory::create("STFT", "frameSize", 128, "windowType", "blackmanharris62");
+  vector<Real> spectrum, phase;
+  stft->output("spectrum").set(spectrum);
+  stft->output("phase").set(phase);
+
+  vector<Real> frame = noise(512);
+  stft->input("frame").set(frame);
+  stft->compute();
+
+  vector<Real> expectedSpectrum, expectedPhase;
+  reference(frame, 0, true, false, "magnitude", expectedSpectrum, expectedPhase);
+  expectClose(spectrum, expectedSpectrum);
+  EXPECT_TRUE(phase.empty());
+
+  delete stft;
+}
+
+
+TEST(STFT, ComputeFrames) {
+  const int frameSize = 128, hopSize = 32, nFrames = 10;
+  vector<Real> signal = noise(frameSize + (nFrames-1)*hopSize);
+
+  STFT* stft = (STFT*)AlgorithmFactory::create("STFT", "frameSize", frameSize,
+                                               "zeroPadding", frameSize,
+                                               "computePhase", true);
+  const int nBins = stft->spectrumSize();
+  ASSERT_EQ(nBins, frameSize + 1);
+
+  // frames straight from the signal, using the hop size as stride
+  vector<Real> spectra(nFrames*nBins), phases(nFrames*nBins);
+  stft->computeFrames(&signal[0], nFrames, hopSize, &spectra[0], &phases[0]);
+
+  vector<Real> spectrum, phase;
+  stft->output("spectrum").set(spectrum);
+  stft->output("phase").set(phase);
+
+  for (int i=0; i<nFrames; ++i) {
+    vector<Real> frame(signal.begin() + i*hopSize, signal.begin() + i*hopSize + frameSize);
+    stft->input("frame").set(frame);
+    stft->compute();
+
+    vector<Real> row(spectra.begin() + i*nBins, spectra.begin() + (i+1)*nBins);
+    vector<Real> phaseRow(phases.begin() + i*nBins, phases.begin() + (i+1)*nBins);
+    EXPECT_VEC_EQ(row, spectrum);
+    EXPECT_VEC_EQ(phaseRow, phase);
+  }
+
+  ASSERT_THROW(stft->computeFrames(&signal[0], nFrames, hopSize, &spectra[0]), EssentiaException);
+
+  delete stft;
+}
+
+
+TEST(STFT, InvalidFrame) {
+  Algorithm* stft = AlgorithmFactory::create("STFT");
+  vector<Real> frame(1), spectrum, phase;
+  stft->input("frame").set(frame);
+  stft->output("spectrum").set(spectrum);
+  stft->output("phase").set(phase);
+  ASSERT_THROW(stft->compute(), EssentiaException);
+
+  // the windowed frame must have an even size
+  ASSERT_THROW(stft->configure("frameSize", 255), EssentiaException);
+
+  delete stft;
+}
@@ -0,0 +1,88 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+#
+# This file is part of Essentia
+#
+# Essentia is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the Free
+# Software Foundation (FSF), either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the Affero GNU General Public License
+# version 3 along with this program. If not, see http://www.gnu.org/licenses/
+
+
+from essentia_test import *
+
+
+class TestComputeBatch(TestCase):
+
+    def frames(self):
+        audio = MonoLoader(filename=join(testdata.audio_dir, 'recorded/vignesh.wav'))()
+        return array([frame for frame in FrameGenerator(audio, frameSize=2048, hopSize=1024)])
+
+    def testSameAsCompute(self):
+        frames = self.frames()
+        w = Windowing()
+        spectrum = Spectrum()
+        mfcc = MFCC()
+
+        spectrums = spectrum.computeBatch(w.computeBatch(frames))
+        bands, mfccs = mfcc.computeBatch(spectrums)
+
+        self.assertEqual(spectrums.shape, (len(frames), 1025))
+        for i, frame in enumerate(frames):
+            expectedBands, expectedMfcc = mfcc(spectrum(w(frame)))
+            self.assertEqualVector(bands[i], expectedBands)
+            self.assertEqualVector(mfccs[i], expectedMfcc)
+
+    def testRealOutputs(self):
+        frames = self.frames()
+        spectrums = Spectrum().computeBatch(frames)
+        centroid = Centroid(range=22050)
+
+        centroids = centroid.computeBatch(spectrums)
+        self.assertEqual(centroids.shape, (len(frames),))
+        self.assertEqualVector(centroids, [centroid(s) for s in spectrums])
+
+    def testVariableSizeFrames(self):
+        # SpectralPeaks outputs a different number of peaks for each frame,
+        # which are returned as lists and can be given to HPCP as such
+        spectrums = Spectrum().computeBatch(self.frames())
+        peaks = SpectralPeaks()
+        hpcp = HPCP()
+
+        frequencies, magnitudes = peaks.computeBatch(spectrums)
+        hpcps = hpcp.computeBatch(frequencies, magnitudes)
+
+        for i, s in enumerate(spectrums):
+            self.assertEqualVector(hpcps[i], hpcp(*peaks(s)))
+
+    def testParallel(self):
+        frames = self.frames()
+        w = Windowing()
+        spectrum = Spectrum()
+
+        expected = spectrum.computeBatch(w.computeBatch(frames))
+        found = spectrum.computeBatch(w.computeBatch(frames, threads=4), threads=4)
+        self.assertEqualMatrix(found, expected)
+
+    def testInvalidInput(self):
+        frames = self.frames()
+        self.assertRaises(ValueError, Spectrum().computeBatch)
+        self.assertRaises(ValueError, Spectrum().computeBatch, frames, frames)
+        self.assertRaises(TypeError, Spectrum().computeBatch, frames[0])
+        # Magnitude takes complex vectors
+        self.assertRaises(RuntimeError, Magnitude().computeBatch, frames)
+
+
+suite = allTests(TestComputeBatch)
+
+if __name__ == '__main__':
+    TextTestRunner(verbosity=2).run(suite)
@@ -93,6 +93,44 @@ class TestPool(TestCase):
 
         self.assertAlmostEqualMatrix(p['foo.bar'], [expectedVec1, expectedVec2])
 
+    def testRealVectorPoolCopy(self):
+        # Frames of the same size are returned as a writable copy
+        expectedVec1 = [1.6, 0.9, 19.85]
+
+        p = Pool()
+        p.add('foo.bar', expectedVec1)
+        copy = p['foo.bar']
+        self.assertTrue(copy.flags['WRITEABLE'])
+
+        copy[0, 0] = 1.0
+        self.assertAlmostEqualMatrix(p['foo.bar'], [expectedVec1])
+
+    def testRealVectorPoolView(self):
+        # Pool.view returns frames of the same size as a read-only view of the
+        # Pool's storage, which is not affected by later changes of the Pool.
+        expectedVec1 = [1.6, 0.9, 19.85]
+        expectedVec2 = [-5.0, 0.0, 5.0]
+
+        p = Pool()
+        p.add('foo.bar', expectedVec1)
+        view = p.view('foo.bar')
+        self.assertFalse(view.flags['WRITEABLE'])
+        self.assertRaises(ValueError, view.__setitem__, (0, 0), 1.0)
+
+        p.add('foo.bar', expectedVec2)
+        self.assertAlmostEqualMatrix(view, [expectedVec1])
+        self.assertAlmostEqualMatrix(p['foo.bar'], [expectedVec1, expectedVec2])
+
+        p.clear()
+        self.assertAlmostEqualMatrix(view, [expectedVec1])
+
+        # the view outlives the Pool
+        p2 = Pool()
+        p2.add('foo.bar', expectedVec1)
+        view = p2.view('foo.bar')
+        del p2
+        self.assertAlmostEqualMatrix(view, [expectedVec1])
+
     def testRealTensorPoolMultiple(self):
         expectedTen1 = numpy.ones([1, 2, 3, 4]).astype('float32')
         expectedTen2 = numpy.ones([4, 3, 2, 1]).astype('float32')
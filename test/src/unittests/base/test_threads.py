@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+#
+# This file is part of Essentia
+#
+# Essentia is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the Free
+# Software Foundation (FSF), either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the Affero GNU General Public License
+# version 3 along with this program. If not, see http://www.gnu.org/licenses/
+
+
+from essentia_test import *
+from threading import Thread
+import essentia
+import essentia.streaming as es
+
+
+class TestThreads(TestCase):
+    # The bindings release the GIL while the C++ code runs, so algorithms
+    # can be used from several python threads at the same time.
+
+    def testStandardAlgorithms(self):
+        audio = MonoLoader(filename=join(testdata.audio_dir, 'recorded/vignesh.wav'))()
+        frames = [frame for frame in FrameGenerator(audio, frameSize=2048, hopSize=1024)]
+
+        def melbands():
+            w = Windowing()
+            spectrum = Spectrum()
+            mels = MelBands()
+            return [mels(spectrum(w(frame))) for frame in frames]
+
+        expected = melbands()
+
+        nThreads = 4
+        results = [None] * nThreads
+
+        def run(i):
+            results[i] = melbands()
+
+        threads = [Thread(target=run, args=(i,)) for i in range(nThreads)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        for result in results:
+            self.assertEqualMatrix(result, expected)
+
+    def testNetworks(self):
+        filename = join(testdata.audio_dir, 'recorded/vignesh.wav')
+        expected = MonoLoader(filename=filename)()
+
+        nThreads = 4
+        results = [None] * nThreads
+
+        def run(i):
+            loader = es.MonoLoader(filename=filename)
+            pool = essentia.Pool()
+            loader.audio >> (pool, 'audio')
+            essentia.run(loader)
+            results[i] = pool['audio']
+
+        threads = [Thread(target=run, args=(i,)) for i in range(nThreads)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        for result in results:
+            self.assertEqualVector(result, expected)
+
+
+suite = allTests(TestThreads)
+
+if __name__ == '__main__':
+    TextTestRunner(verbosity=2).run(suite)
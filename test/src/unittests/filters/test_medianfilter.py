@@ -108,6 +108,35 @@ class TestMedianFilter(TestCase):
         y_pads_removed = y[1:len(y)-2]
         self.assertEqualVector(calculated_median, y_pads_removed)
 
+    def naiveMedianFilter(self, x, kernelSize):
+        half = kernelSize // 2
+        padded = [x[0]] * half + list(x) + [x[-1]] * half
+        return [median(padded[i:i + kernelSize]) for i in range(len(x))]
+
+    def testRegressionLargeKernel(self):
+        # long curve with repeated values and a kernel size in the hundreds
+        random.seed(0)
+        x = random.randint(0, 50, 3000).astype(float32)
+        for kernelSize in [1, 3, 101, 301]:
+            self.assertEqualVector(std.MedianFilter(kernelSize=kernelSize)(x),
+                                   self.naiveMedianFilter(x, kernelSize))
+
+    def testStreaming(self):
+        import essentia.streaming as es
+
+        random.seed(0)
+        frames = random.rand(5, 1000).astype(float32)
+        gen = es.VectorInput(frames)
+        medianFilter = es.MedianFilter(kernelSize=101)
+        pool = Pool()
+        gen.data >> medianFilter.array
+        medianFilter.filteredArray >> (pool, 'filtered')
+        run(gen)
+
+        for frame, filtered in zip(frames, pool['filtered']):
+            self.assertEqualVector(filtered, self.naiveMedianFilter(frame, 101))
+
+
 suite = allTests(TestMedianFilter)
 
 if __name__ == '__main__':
@@ -52,6 +52,24 @@ class TestCrossSimilarityMatrix(TestCase):
         result = csm(self.query_feature, self.reference_feature)
         self.assertAlmostEqualMatrix(self.expected_sim_matrix_binary, result)
 
+    def testRegressionLarge(self):
+        # compare with a naive computation of the distances on inputs larger than
+        # the blocks of rows processed at once
+        numpy.random.seed(0)
+        query = numpy.random.rand(150, 12).astype(numpy.float32)
+        reference = numpy.random.rand(90, 12).astype(numpy.float32)
+        expected = numpy.sqrt(((query[:, None, :].astype(numpy.float64) - reference[None, :, :]) ** 2).sum(axis=2))
+
+        result = CrossSimilarityMatrix(binarize=False)(query, reference)
+        self.assertAlmostEqualMatrix(expected, result, 1e-5)
+
+        resultThreads = CrossSimilarityMatrix(binarize=False, numberThreads=4)(query, reference)
+        self.assertEqualMatrix(result, resultThreads)
+
+        binary = CrossSimilarityMatrix(binarize=True)(query, reference)
+        binaryThreads = CrossSimilarityMatrix(binarize=True, numberThreads=4)(query, reference)
+        self.assertEqualMatrix(binary, binaryThreads)
+
 
 suite = allTests(TestCrossSimilarityMatrix)
 
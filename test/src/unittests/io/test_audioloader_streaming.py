@@ -218,6 +218,84 @@ class TestAudioLoader_Streaming(TestCase):
         self.assertAlmostEqual(centroid16-centroid24, 0)
         self.assertAlmostEqual(centroid16-centroid32, 0)
 
+    def testSlice(self):
+        # Loading a slice should give the same samples as loading the whole
+        # file and trimming it, whether the decoder seeks to it or not.
+        from essentia.standard import AudioLoader as stdAudioLoader
+        dir = join(testdata.audio_dir, 'recorded')
+        for ext in ['wav', 'flac']:
+            filename = join(dir, 'dubstep.' + ext)
+            audio, sr, _, _, _, _ = stdAudioLoader(filename=filename)()
+            start, end = int(1.5 * sr), int(3.2 * sr)
+
+            slice, _, _, _, _, _ = stdAudioLoader(filename=filename, startTime=1.5, endTime=3.2)()
+            self.assertEqualMatrix(slice, audio[start:end])
+
+            # computing the checksum disables seeking
+            slice, _, _, md5, _, _ = stdAudioLoader(filename=filename, startTime=1.5, endTime=3.2,
+                                                   computeMD5=True)()
+            self.assertEqualMatrix(slice, audio[start:end])
+            self.assertEqual(md5, stdAudioLoader(filename=filename, computeMD5=True)()[3])
+
+        # the decoders of compressed formats need to warm up after seeking,
+        # which may also round the samples differently
+        for ext in ['mp3', 'ogg']:
+            filename = join(dir, 'dubstep.' + ext)
+            audio, sr, _, _, _, _ = stdAudioLoader(filename=filename)()
+            start, end = int(1.5 * sr), int(3.2 * sr)
+
+            slice, _, _, _, _, _ = stdAudioLoader(filename=filename, startTime=1.5, endTime=3.2)()
+            self.assertEqual(len(slice), end - start)
+            self.assertTrue(abs(slice - audio[start:end]).max() < 1e-4)
+
+        # slices going past the end of the file are truncated
+        slice, _, _, _, _, _ = stdAudioLoader(filename=filename, startTime=1000, endTime=1001)()
+        self.assertEqual(len(slice), 0)
+
+        self.assertConfigureFails(stdAudioLoader(), {'filename': filename, 'startTime': 2, 'endTime': 1})
+
+    def testInputBuffer(self):
+        # Decoding from memory or from a file object should give the same
+        # results as decoding the file, and can be repeated.
+        from essentia.standard import AudioLoader as stdAudioLoader
+        dir = join(testdata.audio_dir, 'recorded')
+        for ext in ['wav', 'flac', 'mp3', 'ogg']:
+            filename = join(dir, 'dubstep.' + ext)
+            expected = stdAudioLoader(filename=filename, computeMD5=True)()
+            with open(filename, 'rb') as f:
+                data = f.read()
+
+            loader = stdAudioLoader(computeMD5=True)
+            loader.setInputBuffer(data)
+            for i in range(2):
+                found = loader()
+                self.assertEqualMatrix(found[0], expected[0])
+                self.assertEqual(found[1:], expected[1:])
+
+            with open(filename, 'rb') as f:
+                loader = stdAudioLoader(computeMD5=True)
+                loader.setInputSource(f)
+                found = loader()
+                self.assertEqualMatrix(found[0], expected[0])
+                self.assertEqual(found[1:], expected[1:])
+
+        # streaming mode
+        loader = sAudioLoader()
+        loader.setInputBuffer(data)
+        pool = Pool()
+        loader.audio >> (pool, 'audio')
+        loader.numberChannels >> (pool, 'nChannels')
+        loader.sampleRate >> (pool, 'sampleRate')
+        loader.md5 >> (pool, 'md5')
+        loader.bit_rate >> (pool, 'bit_rate')
+        loader.codec >> (pool, 'codec')
+        run(loader)
+        self.assertEqualMatrix(pool['audio'], expected[0])
+
+        loader = stdAudioLoader()
+        self.assertRaises(RuntimeError, lambda: loader.setInputBuffer(b'not an audio file'))
+        self.assertRaises(TypeError, lambda: essentia.standard.Windowing().setInputBuffer(data))
+
     def testMD5(self):
 
         dir = join(testdata.audio_dir,'recorded')
@@ -0,0 +1,130 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+#
+# This file is part of Essentia
+#
+# Essentia is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the Free
+# Software Foundation (FSF), either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the Affero GNU General Public License
+# version 3 along with this program. If not, see http://www.gnu.org/licenses/
+
+
+from essentia_test import *
+import essentia.streaming as streaming
+
+
+class TestOnnxPredict(TestCase):
+    def testIdentityModel(self):
+        # Perform the identity operation in ONNX Runtime to test if the data is
+        # being copied correctly backwards and fordwards.
+        model = join(filedir(), "onnxpredict", "identity.onnx")
+        filename = join(testdata.audio_dir, "recorded", "cat_purrrr.wav")
+
+        audio = MonoLoader(filename=filename)()
+        frames = array([frame for frame in FrameGenerator(audio)])
+        batch = frames[numpy.newaxis, numpy.newaxis, :]
+
+        pool = Pool()
+        pool.set("input", batch)
+
+        poolOut = OnnxPredict(
+            graphFilename=model,
+            inputs=["input"],
+            outputs=["output"],
+            squeeze=False,
+        )(pool)
+
+        self.assertAlmostEqualMatrix(poolOut["output"], batch)
+
+    def testDefaultNames(self):
+        # Without `inputs` and `outputs` all the inputs and outputs of the model
+        # are used. The identity model takes 4D tensors, so they are not squeezed.
+        model = join(filedir(), "onnxpredict", "identity.onnx")
+        batch = numpy.random.rand(2, 1, 16, 32).astype("float32")
+
+        pool = Pool()
+        pool.set("input", batch)
+
+        poolOut = OnnxPredict(graphFilename=model, squeeze=False)(pool)
+
+        self.assertAlmostEqualMatrix(poolOut["output"], batch)
+
+    def testEmptyModelName(self):
+        # With empty model name the algorithm should skip the configuration without errors.
+        self.assertConfigureSuccess(OnnxPredict(), {})
+        self.assertConfigureSuccess(OnnxPredict(), {"graphFilename": ""})
+        self.assertConfigureSuccess(
+            OnnxPredict(), {"graphFilename": "", "inputs": ["wrong_input"]}
+        )
+
+    def testTensorEmptyModelName(self):
+        # OnnxPredictTensor can also be created without a model.
+        self.assertConfigureSuccess(streaming.OnnxPredictTensor(), {})
+        self.assertConfigureSuccess(
+            streaming.OnnxPredictTensor(), {"graphFilename": "", "inputs": ["a", "b"]}
+        )
+
+    def testInvalidParam(self):
+        model = join(filedir(), "onnxpredict", "identity.onnx")
+        self.assertConfigureFails(
+            OnnxPredict(),
+            {
+                "graphFilename": model,
+                "inputs": ["wrong_input_name"],
+            },
+        )  # input does not exist in the model
+        self.assertConfigureFails(
+            OnnxPredict(),
+            {
+                "graphFilename": model,
+                "outputs": ["wrong_output_name"],
+            },
+        )  # output does not exist in the model
+        self.assertConfigureFails(
+            OnnxPredict(), {"graphFilename": "wrong_model_name"}
+        )  # the model does not exist
+
+    def testSharedModel(self):
+        # Instances configured with the same model share it. Results should
+        # not depend on it, nor on the number of threads of the session.
+        model = join(filedir(), "onnxpredict", "identity.onnx")
+        batch = numpy.random.rand(2, 1, 16, 32).astype("float32")
+
+        pool = Pool()
+        pool.set("input", batch)
+
+        first = OnnxPredict(graphFilename=model, squeeze=False)
+        second = OnnxPredict(graphFilename=model, squeeze=False)
+        private = OnnxPredict(graphFilename=model, squeeze=False, shareModel=False)
+        threaded = OnnxPredict(
+            graphFilename=model, squeeze=False, intraOpThreads=1, interOpThreads=1
+        )
+
+        for algo in (first, second, private, threaded):
+            self.assertAlmostEqualMatrix(algo(pool)["output"], batch)
+
+        # Reconfiguring an instance does not affect the ones sharing its model.
+        first.configure(graphFilename=model, squeeze=False, shareModel=False)
+        self.assertAlmostEqualMatrix(first(pool)["output"], batch)
+        self.assertAlmostEqualMatrix(second(pool)["output"], batch)
+
+    def testComputeWithoutConfiguration(self):
+        pool = Pool()
+        pool.set("input", numpy.zeros((1, 1, 1, 1), dtype="float32"))
+
+        self.assertComputeFails(OnnxPredict(), pool)
+
+
+suite = allTests(TestOnnxPredict)
+
+if __name__ == "__main__":
+    TextTestRunner(verbosity=2).run(suite)
@@ -208,6 +208,63 @@ class TestTensorFlowPredict(TestCase):
 
         self.assertAlmostEqualMatrix(foundValues, batch)
 
+    def testSharedModel(self):
+        # Instances configured with the same model share it. Results should
+        # not depend on it, nor on the number of threads of the session.
+        model = join(filedir(), "tensorflowpredict", "identity.pb")
+        batch = numpy.random.rand(2, 1, 16, 32).astype("float32")
+
+        pool = Pool()
+        pool.set("model/Placeholder", batch)
+
+        params = {"graphFilename": model,
+                  "inputs": ["model/Placeholder"],
+                  "outputs": ["model/Identity"]}
+
+        first = TensorflowPredict(**params)
+        second = TensorflowPredict(**params)
+        private = TensorflowPredict(shareModel=False, **params)
+        threaded = TensorflowPredict(intraOpThreads=1, interOpThreads=1, **params)
+
+        for algo in (first, second, private, threaded):
+            self.assertAlmostEqualMatrix(algo(pool)["model/Identity"], batch)
+
+        # Reconfiguring an instance does not affect the ones sharing its model.
+        first.configure(shareModel=False, **params)
+        second.reset()
+        self.assertAlmostEqualMatrix(first(pool)["model/Identity"], batch)
+        self.assertAlmostEqualMatrix(second(pool)["model/Identity"], batch)
+
+    def testDynamicBatch(self):
+        # Instances running concurrently may share their batches, but each of
+        # them should only get the predictions for its own patches.
+        from threading import Thread
+
+        model = join(filedir(), "tensorflowpredict", "identity.pb")
+        params = {"graphFilename": model,
+                  "inputs": ["model/Placeholder"],
+                  "outputs": ["model/Identity"],
+                  "dynamicBatchSize": 8,
+                  "dynamicBatchTimeout": 0.001}
+
+        nThreads = 4
+        batches = [numpy.random.rand(i + 1, 1, 16, 32).astype("float32") for i in range(nThreads)]
+        results = [None] * nThreads
+
+        def predict(i):
+            pool = Pool()
+            pool.set("model/Placeholder", batches[i])
+            results[i] = TensorflowPredict(**params)(pool)["model/Identity"]
+
+        threads = [Thread(target=predict, args=(i,)) for i in range(nThreads)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        for i in range(nThreads):
+            self.assertAlmostEqualMatrix(results[i], batches[i])
+
     def testComputeWithoutConfiguration(self):
         pool = Pool()
         pool.set("model/Placeholder", numpy.zeros((1, 1, 1, 1), dtype="float32"))
@@ -27,7 +27,7 @@ from essentia.standard import PoolAggregator
 class TestTensorflowPredict_Streaming(TestCase):
 
     def identityModel(self, frameSize=1024, hopSize=512, patchSize=187,
-                      lastPatchMode='discard'):
+                      lastPatchMode='discard', usePool=True):
         # Identity test to check that the data flows properly.
         model = join(filedir(), 'tensorflowpredict', 'identity.pb')
         filename = join(testdata.audio_dir, 'recorded', 'cat_purrrr.wav')
@@ -38,11 +38,6 @@ class TestTensorflowPredict_Streaming(TestCase):
         fc = FrameCutter(frameSize=frameSize, hopSize=hopSize)
         vtt = VectorRealToTensor(shape=[1, 1, patchSize, frameSize],
                                  lastPatchMode=lastPatchMode)
-        ttp = TensorToPool(namespace=input_layer)
-        tfp = TensorflowPredict(graphFilename=model,
-                                inputs=[input_layer],
-                                outputs=[output_layer])
-        ptt = PoolToTensor(namespace=output_layer)
         ttv = TensorToVectorReal()
 
         pool = Pool()
@@ -50,10 +45,26 @@ class TestTensorflowPredict_Streaming(TestCase):
         ml.audio    >> fc.signal
         fc.frame    >> vtt.frame
         fc.frame    >> (pool, "framesIn")
-        vtt.tensor  >> ttp.tensor
-        ttp.pool    >> tfp.poolIn
-        tfp.poolOut >> ptt.pool
-        ptt.tensor  >> ttv.tensor
+
+        if usePool:
+            ttp = TensorToPool(namespace=input_layer)
+            tfp = TensorflowPredict(graphFilename=model,
+                                    inputs=[input_layer],
+                                    outputs=[output_layer])
+            ptt = PoolToTensor(namespace=output_layer)
+
+            vtt.tensor  >> ttp.tensor
+            ttp.pool    >> tfp.poolIn
+            tfp.poolOut >> ptt.pool
+            ptt.tensor  >> ttv.tensor
+        else:
+            tfp = TensorflowPredictTensor(graphFilename=model,
+                                          inputs=[input_layer],
+                                          outputs=[output_layer])
+
+            vtt.tensor  >> tfp.tensor
+            tfp.tensor  >> ttv.tensor
+
         ttv.frame   >> (pool, "framesOut")
 
         run(ml)
@@ -145,6 +156,15 @@ class TestTensorflowPredict_Streaming(TestCase):
                                              patchSize=300, lastPatchMode='discard')
         self.assertAlmostEqualMatrix(found, expected[:found.shape[0], :], 1e-8)
 
+    def testIdentityModelTensor(self):
+        # Same as above without the pool round trips.
+        found, expected = self.identityModel(patchSize=43, usePool=False)
+        self.assertAlmostEqualMatrix(found, expected, 1e-8)
+
+        found, expected = self.identityModel(frameSize=256, hopSize=128,
+                                             patchSize=300, usePool=False)
+        self.assertAlmostEqualMatrix(found, expected[:found.shape[0], :], 1e-8)
+
 
 suite = allTests(TestTensorflowPredict_Streaming)
 
@@ -173,6 +173,75 @@ class TestRhythmExtractor2013(TestCase):
         for i in range(len(estimates)):
             self.assertAlmostEqual(estimates[i], expectedBpm, 5.0)
 
+    def _runStreaming(self, audio, algorithm, computeFFT):
+        import essentia.streaming as es
+
+        gen = es.VectorInput(audio)
+        rhythm = getattr(es, algorithm)(computeFFT=computeFFT)
+        pool = Pool()
+
+        gen.data >> rhythm.signal
+        if not computeFFT:
+            # FFT shared with other descriptors, computed as the beat tracker does
+            fc = es.FrameCutter(frameSize=2048, hopSize=1024, silentFrames='keep', startFromZero=True)
+            w = es.Windowing(size=2048, type='hann')
+            fft = es.FFT(size=2048)
+            magnitude = es.Magnitude()
+            gen.data >> fc.signal
+            fc.frame >> w.frame >> fft.frame
+            fft.fft >> rhythm.fft
+            fft.fft >> magnitude.complex
+            magnitude.magnitude >> (pool, 'spectrum')
+
+        for output in rhythm.outputNames():
+            getattr(rhythm, output) >> (pool, output)
+        run(gen)
+        return pool
+
+    def testStreamingSharedFFT(self):
+        audio = MonoLoader(filename=join(testdata.audio_dir, 'recorded', 'techno_loop.wav'))()
+
+        for algorithm in ['BeatTrackerMultiFeature', 'RhythmExtractor2013']:
+            expected = self._runStreaming(audio, algorithm, True)
+            found = self._runStreaming(audio, algorithm, False)
+            self.assertTrue(len(found['spectrum']) > 0)
+            for output in expected.descriptorNames():
+                self.assertEqualVector(numpy.ravel(found[output]), numpy.ravel(expected[output]))
+
+    def testSharedFFTDegara(self):
+        import essentia.streaming as es
+        self.assertConfigureFails(es.RhythmExtractor2013(), {'method': 'degara', 'computeFFT': False})
+
+    def _connectFFT(self, rhythm):
+        import essentia.streaming as es
+
+        gen = es.VectorInput(numpy.zeros(44100, dtype=numpy.float32))
+        fc = es.FrameCutter(frameSize=2048, hopSize=1024, silentFrames='keep', startFromZero=True)
+        w = es.Windowing(size=2048, type='hann')
+        fft = es.FFT(size=2048)
+        pool = Pool()
+
+        gen.data >> rhythm.signal
+        gen.data >> fc.signal
+        fc.frame >> w.frame >> fft.frame
+        fft.fft >> rhythm.fft
+        for output in rhythm.outputNames():
+            getattr(rhythm, output) >> (pool, output)
+        return gen
+
+    def testFFTInputWithComputeFFT(self):
+        # the 'fft' input is not read when the FFT is computed internally
+        import essentia.streaming as es
+
+        for algorithm in ['BeatTrackerMultiFeature', 'RhythmExtractor2013']:
+            rhythm = getattr(es, algorithm)()
+            gen = self._connectFFT(rhythm)
+            self.assertRaises(EssentiaException, lambda: run(gen))
+
+            rhythm = getattr(es, algorithm)(computeFFT=False)
+            self._connectFFT(rhythm)
+            self.assertConfigureFails(rhythm, {'computeFFT': True})
+
 
 suite = allTests(TestRhythmExtractor2013)
 
@@ -124,6 +124,20 @@ class TestTriangularBarkBands(TestCase):
                 [0.0460643246769905]*24,
                 1e-6)
 
+    def testLog(self):
+        # With log=True, log2(1 + energy) is applied after adding each bin of
+        # the spectrum. Expected values were computed with that implementation.
+        spec = [.1,.4,.5,.2,.1,.01,.04]*100
+        expected = [0.999999821, 0.999999821, 0.999999821, 0.999999821, 0.999999821, 0.999999821,
+                    0.999999821, 0.999999821, 0.999999821, 0.999999821, 0.999999821, 1.00000036,
+                    1.00000036, 1.00000036, 1.00000036, 1.00000036, 1.00000036, 1.00000036,
+                    1.00000036, 1.00000036, 1.00000036, 1.00000036, 1.00002325, 1.0009793]
+
+        self.assertAlmostEqualVector(
+                TriangularBarkBands(inputSize=700, log=True)(spec),
+                expected,
+                1e-6)
+
     """
     def testNotEnoughSpectrumBins(self):
         self.assertConfigureFails(TriangularBarkBands(), {'numberBands': 256, 
@@ -89,6 +89,39 @@ class TestFFT(TestCase):
 
         self.assertAlmostEqualVector(FFT()(inputSignal), expected, 1e-2)
 
+    def testWisdom(self):
+        try:
+            rigor = fftwPlannerRigor()
+        except RuntimeError:
+            self.skipTest('Essentia was not compiled with FFTW')
+
+        import tempfile, os
+        inputSignal = numpy.sin(numpy.arange(1024, dtype='f4')/1024. * 441 * 2*math.pi)
+        expected = FFT(size=1024)(inputSignal)
+
+        wisdomFile = join(tempfile.mkdtemp(), 'wisdom')
+        try:
+            fftwSetPlannerRigor('measure')
+            self.assertEqual(fftwPlannerRigor(), 'measure')
+
+            # measured plans for sizes which have not been planned before
+            for size in [ 96, 192 ]:
+                FFT(size=size)(numpy.ones(size, dtype='f4'))
+            fftwExportWisdom(wisdomFile)
+            self.assertTrue(os.path.getsize(wisdomFile) > 0)
+
+            fftwForgetWisdom()
+            fftwImportWisdom(wisdomFile)
+            self.assertAlmostEqualVector(FFT(size=1024)(inputSignal), expected, 1e-5)
+
+            self.assertRaises(RuntimeError, fftwImportWisdom, join(split(wisdomFile)[0], 'missing'))
+            self.assertRaises(RuntimeError, fftwSetPlannerRigor, 'sloppy')
+        finally:
+            fftwSetPlannerRigor(rigor)
+            if os.path.exists(wisdomFile):
+                os.remove(wisdomFile)
+            os.rmdir(split(wisdomFile)[0])
+
 
 
 
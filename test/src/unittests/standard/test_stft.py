@@ -0,0 +1,84 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+#
+# This file is part of Essentia
+#
+# Essentia is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the Free
+# Software Foundation (FSF), either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the Affero GNU General Public License
+# version 3 along with this program. If not, see http://www.gnu.org/licenses/
+
+
+from essentia_test import *
+
+
+class TestSTFT(TestCase):
+
+    def reference(self, frame, **params):
+        windowed = Windowing(size=len(frame), **params)(frame)
+        return CartesianToPolar()(FFT()(windowed))
+
+    def testSameAsWindowingSpectrum(self):
+        frame = numpy.random.RandomState(0).randn(512).astype(numpy.float32)
+
+        for params in ({},
+                       {'type': 'hamming', 'zeroPadding': 512},
+                       {'type': 'blackmanharris92', 'zeroPadding': 1536, 'zeroPhase': False},
+                       {'zeroPadding': 512, 'zeroPhase': False, 'splitPadding': True},
+                       {'normalized': False, 'symmetric': False}):
+            magnitude, phase = self.reference(frame, **params)
+
+            stftParams = dict(params)
+            stftParams['windowType'] = stftParams.pop('type', 'hann')
+            spectrum, stftPhase = STFT(frameSize=len(frame), computePhase=True, **stftParams)(frame)
+            self.assertAlmostEqualVector(spectrum, magnitude, 1e-5)
+            self.assertAlmostEqualVector(stftPhase, phase, 1e-4)
+
+            power, emptyPhase = STFT(frameSize=len(frame), spectrumType='power', **stftParams)(frame)
+            self.assertAlmostEqualVector(power, magnitude**2, 1e-5)
+            self.assertEqual(len(emptyPhase), 0)
+
+    def testSameAsSpectrum(self):
+        frame = numpy.sin(numpy.arange(1024) * 0.05).astype(numpy.float32)
+        expected = Spectrum()(Windowing()(frame))
+        self.assertAlmostEqualVector(STFT()(frame)[0], expected, 1e-5)
+
+    def testFrameSizeChange(self):
+        stft = STFT(frameSize=256)
+        for size in (256, 1024, 128):
+            frame = numpy.ones(size, dtype=numpy.float32)
+            self.assertAlmostEqualVector(stft(frame)[0], Spectrum()(Windowing()(frame)), 1e-5)
+
+    def testBatch(self):
+        frames = numpy.random.RandomState(1).randn(16, 256).astype(numpy.float32)
+        stft = STFT(frameSize=256, computePhase=True)
+        spectra, phases = stft.computeBatch(frames)
+        for i, frame in enumerate(frames):
+            spectrum, phase = stft(frame)
+            self.assertEqualVector(spectra[i], spectrum)
+            self.assertEqualVector(phases[i], phase)
+
+    def testInvalidParam(self):
+        self.assertConfigureFails(STFT(), {'frameSize': 1})
+        self.assertConfigureFails(STFT(), {'spectrumType': 'complex'})
+        # the windowed frame must have an even size
+        self.assertConfigureFails(STFT(), {'frameSize': 255})
+
+    def testInvalidInput(self):
+        self.assertComputeFails(STFT(), [])
+        self.assertComputeFails(STFT(), [1])
+
+
+suite = allTests(TestSTFT)
+
+if __name__ == '__main__':
+    TextTestRunner(verbosity=2).run(suite)
@@ -265,6 +265,28 @@ class TestPoolAggregator(TestCase):
         self.assertEqualVector(results['foo.kurt'], [-3, -3, -3, -3, -3])
 
 
+    def testNumberThreads(self):
+        numpy.random.seed(0)
+        p = Pool()
+        for i in range(10):
+            for frame in numpy.random.rand(50, 4).astype(numpy.float32):
+                p.add('foo.bar%d' % i, frame)
+                p.add('foo.baz%d' % i, float(frame[0]))
+
+        defaultStats = ['mean', 'min', 'max', 'median', 'var', 'stdev', 'dmean', 'dvar', 'dmean2', 'dvar2', 'skew', 'kurt']
+        expected = PoolAggregator(defaultStats=defaultStats)(p)
+        found = PoolAggregator(defaultStats=defaultStats, numberThreads=4)(p)
+
+        self.assertEqualVector(sorted(found.descriptorNames()), sorted(expected.descriptorNames()))
+        for name in expected.descriptorNames():
+            self.assertEqualVector(numpy.atleast_1d(found[name]), numpy.atleast_1d(expected[name]))
+
+        data = numpy.array(p['foo.bar0'])
+        self.assertAlmostEqualVector(expected['foo.bar0.mean'], numpy.mean(data, axis=0), 1e-6)
+        self.assertAlmostEqualVector(expected['foo.bar0.median'], numpy.median(data, axis=0), 1e-6)
+        self.assertAlmostEqualVector(expected['foo.bar0.var'], numpy.var(data, axis=0), 1e-5)
+
+
 suite = allTests(TestPoolAggregator)
 
 if __name__ == '__main__':
@@ -0,0 +1,165 @@
+#!/usr/bin/env python
+
+# Copyright (C) 2006-2021  Music Technology Group - Universitat Pompeu Fabra
+#
+# This file is part of Essentia
+#
+# Essentia is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the Free
+# Software Foundation (FSF), either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the Affero GNU General Public License
+# version 3 along with this program. If not, see http://www.gnu.org/licenses/
+
+
+from essentia_test import *
+
+
+def viterbiReference(obs, init, fromIndex, toIndex, transProb):
+    # plain loop over the transitions, in double precision as in Essentia
+    nState = len(init)
+    # the first frame is computed in single precision
+    delta = [float(numpy.float32(init[i]) * numpy.float32(obs[0][i])) for i in range(nState)]
+    deltaSum = sum(delta)
+    oldDelta = [d / deltaSum for d in delta]
+    psi = [[0] * nState]
+
+    for iFrame in range(1, len(obs)):
+        delta = [0.] * nState
+        psi.append([0] * nState)
+        for f, t, p in zip(fromIndex, toIndex, transProb):
+            value = oldDelta[f] * p
+            if value > delta[t]:
+                delta[t] = value
+                psi[iFrame][t] = f
+        delta = [delta[j] * obs[iFrame][j] for j in range(nState)]
+        deltaSum = sum(delta)
+        if deltaSum > 0:
+            oldDelta = [d / deltaSum for d in delta]
+        else:
+            oldDelta = [1. / nState] * nState
+
+    path = [0] * len(obs)
+    best = 0
+    for i in range(nState):
+        if oldDelta[i] > best:
+            best = oldDelta[i]
+            path[-1] = i
+    for iFrame in range(len(obs) - 2, -1, -1):
+        path[iFrame] = psi[iFrame + 1][path[iFrame + 1]]
+    return path
+
+
+class TestViterbi(TestCase):
+
+    def bandedModel(self, nState, width):
+        fromIndex, toIndex, transProb = [], [], []
+        for i in range(nState):
+            for j in range(max(0, i - width), min(nState, i + width + 1)):
+                fromIndex.append(i)
+                toIndex.append(j)
+                transProb.append(float(numpy.float32(1. / (1 + abs(i - j)))))
+        return fromIndex, toIndex, transProb
+
+    def testEmpty(self):
+        self.assertComputeFails(Viterbi(), [], [], [], [], [])
+
+    def testInvalidTransitions(self):
+        obs = [[.5, .5]] * 3
+        self.assertComputeFails(Viterbi(), obs, [.5, .5], [0, 2], [0, 1], [.5, .5])
+        self.assertComputeFails(Viterbi(), obs, [.5, .5], [0, 1], [0], [.5, .5])
+
+    def testSimple(self):
+        # two states which prefer to stay where they are
+        obs = [[.9, .1], [.9, .1], [.2, .8], [.1, .9], [.1, .9]]
+        path = Viterbi()(obs, [.5, .5], [0, 0, 1, 1], [0, 1, 0, 1], [.9, .1, .1, .9])
+        self.assertEqualVector(path, [0, 0, 1, 1, 1])
+
+    def testRegressionBanded(self):
+        # sparse observations and ties, as in PitchYinProbabilitiesHMM
+        numpy.random.seed(0)
+        nState = 60
+        fromIndex, toIndex, transProb = self.bandedModel(nState, 3)
+        init = [float(numpy.float32(1. / nState))] * nState
+
+        obs = numpy.zeros((200, nState), dtype='f4')
+        for frame in obs:
+            frame[numpy.random.randint(0, nState, 3)] = numpy.random.rand(3)
+            frame[nState // 2:] += .01
+
+        self.assertEqualVector(Viterbi()(obs, init, fromIndex, toIndex, transProb),
+                               viterbiReference(obs.tolist(), init, fromIndex, toIndex, transProb))
+
+    def testZeroFrames(self):
+        # frames where all the states become impossible
+        numpy.random.seed(1)
+        nState = 20
+        fromIndex, toIndex, transProb = self.bandedModel(nState, 1)
+        init = [float(numpy.float32(1. / nState))] * nState
+
+        obs = numpy.zeros((50, nState), dtype='f4')
+        for i, frame in enumerate(obs):
+            if i % 7:
+                frame[numpy.random.randint(0, nState, 2)] = numpy.random.rand(2)
+
+        self.assertEqualVector(Viterbi()(obs, init, fromIndex, toIndex, transProb),
+                               viterbiReference(obs.tolist(), init, fromIndex, toIndex, transProb))
+
+    def decodeOnline(self, obs, init, fromIndex, toIndex, transProb, maxLag=0):
+        import essentia.streaming as es
+        gen = es.VectorInput(obs)
+        viterbi = es.ViterbiOnline(initialization=init, fromIndex=fromIndex, toIndex=toIndex,
+                                   transitionProbabilities=transProb, maxLag=maxLag)
+        pool = Pool()
+        gen.data >> viterbi.observationProbabilities
+        viterbi.path >> (pool, 'path')
+        run(gen)
+        return pool['path']
+
+    def testOnline(self):
+        numpy.random.seed(2)
+        nState = 40
+        fromIndex, toIndex, transProb = self.bandedModel(nState, 2)
+        init = [float(numpy.float32(1. / nState))] * nState
+
+        obs = numpy.zeros((300, nState), dtype='f4')
+        for frame in obs:
+            frame[numpy.random.randint(0, nState, 2)] = numpy.random.rand(2)
+            frame += .001
+
+        expected = Viterbi()(obs, init, fromIndex, toIndex, transProb)
+        self.assertEqualVector(self.decodeOnline(obs, init, fromIndex, toIndex, transProb), expected)
+
+        # with a bounded latency, the path can only differ close to the places
+        # where the decoding hesitated
+        path = self.decodeOnline(obs, init, fromIndex, toIndex, transProb, maxLag=5)
+        self.assertEqual(len(path), len(expected))
+
+    def testOnlineEmpty(self):
+        import essentia.streaming as es
+        gen = es.VectorInput([[.5, .5]] * 3)
+        viterbi = es.ViterbiOnline()
+        pool = Pool()
+        gen.data >> viterbi.observationProbabilities
+        viterbi.path >> (pool, 'path')
+        self.assertRaises(EssentiaException, lambda: run(gen))
+
+    def testStreamingInterface(self):
+        # the streaming Viterbi still takes the whole sequence and the model as
+        # single tokens, the frame by frame decoding is in ViterbiOnline
+        import essentia.streaming as es
+        self.assertEqual(sorted(es.Viterbi().inputNames()),
+                         sorted(['observationProbabilities', 'initialization', 'fromIndex',
+                                 'toIndex', 'transitionProbabilities']))
+
+
+suite = allTests(TestViterbi)
+
+if __name__ == '__main__':
+    TextTestRunner(verbosity=2).run(suite)
@@ -60,9 +60,12 @@ def get_all_algorithms(algo_dir, root_dir=None):
                         has_streaming = True
                         continue
 
+                    # algorithms extending another algorithm (e.g., the ONNX Runtime
+                    # wrappers of the TensorFlow models) derive from it instead
                     if (line.find('public Algorithm') >= 0 or
                         line.find('public AccumulatorAlgorithm') >= 0 or
-                        line.find('public StreamingAlgorithmWrapper') >= 0):
+                        line.find('public StreamingAlgorithmWrapper') >= 0 or
+                        (line.startswith('class ') and line.find(' : public ') >= 0)):
                         name = line.split(' ')[1]
 
                         if has_standard and not has_streaming: algo = name